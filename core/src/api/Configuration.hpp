@@ -55,6 +55,13 @@ public:
 
     /** Operation trust. */
     static std::string const TRUST_LIMIT;
+
+    /**
+     * Boolean, store the raw data of Bitcoin-like transactions once per currency and hash, shared by all the accounts
+     * of the pool using it, instead of once per account (default: false). The value given when creating the wallet is
+     * kept: later configuration updates do not change it.
+     */
+    static std::string const SHARED_TRANSACTION_STORAGE;
 };
 
 } } }  // namespace ledger::core::api
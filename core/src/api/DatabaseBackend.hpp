@@ -47,6 +47,14 @@ public:
      */
     static std::shared_ptr<DatabaseBackend> getSqlite3Backend();
 
+    /**
+     * Create an instance of PostgreSQL database. The database name given to the pool is used as libpq connection string.
+     * Only available when the library is built with PG_SUPPORT.
+     * @param connectionPoolSize, number of connections opened on the database
+     * @return DatabaseBackend object
+     */
+    static std::shared_ptr<DatabaseBackend> getPostgreSQLBackend(int32_t connectionPoolSize);
+
     /** Create a database backend instance from the given DatabaseEngine implementation. */
     static std::shared_ptr<DatabaseBackend> createBackendFromEngine(const std::shared_ptr<DatabaseEngine> & engine);
 };
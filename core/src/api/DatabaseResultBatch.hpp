@@ -0,0 +1,75 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from database.djinni
+
+#ifndef DJINNI_GENERATED_DATABASERESULTBATCH_HPP
+#define DJINNI_GENERATED_DATABASERESULTBATCH_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ledger { namespace core { namespace api {
+
+/**
+ * A bunch of consecutive rows of a query result packed in flat buffers, so that a whole batch crosses the binding
+ * boundary at once instead of one call per row and per cell. Cells are stored row after row (row-major order).
+ */
+struct DatabaseResultBatch final {
+    /** Number of rows packed in the batch. */
+    int32_t rowCount;
+    /** Number of columns of each row. */
+    int32_t columnCount;
+    /** One byte per cell, 1 if the cell is NULL, 0 otherwise. */
+    std::vector<uint8_t> nulls;
+    /** rowCount * columnCount + 1 little-endian unsigned 32bit offsets in values. Cell i is values[offsets[i], offsets[i + 1]). */
+    std::vector<uint8_t> offsets;
+    /** Concatenated cell values. Numbers are written in their decimal text form, strings in UTF-8 and blobs as raw bytes. */
+    std::vector<uint8_t> values;
+
+    DatabaseResultBatch(int32_t rowCount_,
+                        int32_t columnCount_,
+                        std::vector<uint8_t> nulls_,
+                        std::vector<uint8_t> offsets_,
+                        std::vector<uint8_t> values_)
+    : rowCount(std::move(rowCount_))
+    , columnCount(std::move(columnCount_))
+    , nulls(std::move(nulls_))
+    , offsets(std::move(offsets_))
+    , values(std::move(values_))
+    {}
+
+    DatabaseResultBatch(const DatabaseResultBatch& cpy) {
+       this->rowCount = cpy.rowCount;
+       this->columnCount = cpy.columnCount;
+       this->nulls = cpy.nulls;
+       this->offsets = cpy.offsets;
+       this->values = cpy.values;
+    }
+
+    DatabaseResultBatch() = default;
+
+
+    DatabaseResultBatch& operator=(const DatabaseResultBatch& cpy) {
+       this->rowCount = cpy.rowCount;
+       this->columnCount = cpy.columnCount;
+       this->nulls = cpy.nulls;
+       this->offsets = cpy.offsets;
+       this->values = cpy.values;
+       return *this;
+    }
+
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(rowCount, columnCount, nulls, offsets, values);
+    }
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(rowCount, columnCount, nulls, offsets, values);
+    }
+};
+
+} } }  // namespace ledger::core::api
+#endif //DJINNI_GENERATED_DATABASERESULTBATCH_HPP
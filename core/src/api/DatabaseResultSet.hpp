@@ -4,6 +4,8 @@
 #ifndef DJINNI_GENERATED_DATABASERESULTSET_HPP
 #define DJINNI_GENERATED_DATABASERESULTSET_HPP
 
+#include "../utils/optional.hpp"
+#include "DatabaseResultBatch.hpp"
 #include <cstdint>
 #include <memory>
 #ifndef LIBCORE_EXPORT
@@ -54,6 +56,14 @@ public:
      */
     virtual void next() = 0;
 
+    /**
+     * Move the result set forward by at most maxRows rows and pack them in a single batch. The result set is left on the
+     * last packed row. Hosts unable to pack rows should return null, rows are then read one by one with next and getRow.
+     * @param maxRows The maximum number of rows to pack
+     * @return The packed rows (with no row when there is no further row to fetch) or null if batches are not supported
+     */
+    virtual std::experimental::optional<DatabaseResultBatch> nextBatch(int32_t maxRows) = 0;
+
     /** Close the result set. */
     virtual void close() = 0;
 
@@ -15,6 +15,7 @@ std::string to_string(const EventCode& eventCode) {
         case EventCode::SYNCHRONIZATION_FAILED: return "SYNCHRONIZATION_FAILED";
         case EventCode::SYNCHRONIZATION_SUCCEED: return "SYNCHRONIZATION_SUCCEED";
         case EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT: return "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT";
+        case EventCode::PASSWORD_CHANGE_PROGRESS: return "PASSWORD_CHANGE_PROGRESS";
     };
 };
 template <>
@@ -25,7 +26,8 @@ EventCode from_string(const std::string& eventCode) {
     else if (eventCode == "SYNCHRONIZATION_STARTED") return EventCode::SYNCHRONIZATION_STARTED;
     else if (eventCode == "SYNCHRONIZATION_FAILED") return EventCode::SYNCHRONIZATION_FAILED;
     else if (eventCode == "SYNCHRONIZATION_SUCCEED") return EventCode::SYNCHRONIZATION_SUCCEED;
-    else return EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT;
+    else if (eventCode == "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT") return EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT;
+    else return EventCode::PASSWORD_CHANGE_PROGRESS;
 };
 
 std::ostream &operator<<(std::ostream &os, const EventCode &o)
@@ -38,6 +40,7 @@ std::ostream &operator<<(std::ostream &os, const EventCode &o)
         case EventCode::SYNCHRONIZATION_FAILED:  return os << "SYNCHRONIZATION_FAILED";
         case EventCode::SYNCHRONIZATION_SUCCEED:  return os << "SYNCHRONIZATION_SUCCEED";
         case EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT:  return os << "SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT";
+        case EventCode::PASSWORD_CHANGE_PROGRESS:  return os << "PASSWORD_CHANGE_PROGRESS";
     }
 }
 
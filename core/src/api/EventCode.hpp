@@ -32,6 +32,8 @@ enum class EventCode : int {
     SYNCHRONIZATION_SUCCEED,
     /** Event emitted when a wallet synchronization succeeded on the previously empty account. */
     SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT,
+    /** Event emitted while the pool storages are re-encrypted after a password change. */
+    PASSWORD_CHANGE_PROGRESS,
 };
 LIBCORE_EXPORT  std::string to_string(const EventCode& eventCode);
 LIBCORE_EXPORT  std::ostream &operator<<(std::ostream &os, const EventCode &o);
@@ -4,8 +4,10 @@
 #ifndef DJINNI_GENERATED_OPERATIONQUERY_HPP
 #define DJINNI_GENERATED_OPERATIONQUERY_HPP
 
+#include "../utils/optional.hpp"
 #include <cstdint>
 #include <memory>
+#include <string>
 #ifndef LIBCORE_EXPORT
     #if defined(_MSC_VER)
        #include <libcore_export.h>
@@ -17,6 +19,7 @@
 namespace ledger { namespace core { namespace api {
 
 class OperationListCallback;
+class OperationRecordListCallback;
 class QueryFilter;
 enum class OperationOrderKey;
 
@@ -51,6 +54,21 @@ public:
      */
     virtual std::shared_ptr<OperationQuery> limit(int64_t count) = 0;
 
+    /**
+     * Resume the query right after the last operation of a previous page. Unlike offset, skipped operations
+     * are not scanned again. Only available on queries ordered by date.
+     * @param cursor, string continuation token, as returned by getNextCursor
+     * @return OperationQuery object, resuming after the cursor
+     */
+    virtual std::shared_ptr<OperationQuery> after(const std::string & cursor) = 0;
+
+    /**
+     * Get the continuation token of the last executed page, to be given to after on a new query.
+     * @return Optional string, empty if the query was not executed, is not ordered by date or has no more
+     * operations to fetch
+     */
+    virtual std::experimental::optional<std::string> getNextCursor() = 0;
+
     /**
      *TODO
      * Complete the operation query.
@@ -65,6 +83,13 @@ public:
      * @param callback, if execute method succeed, ListCallback object returning a List of Operation objects
      */
     virtual void execute(const std::shared_ptr<OperationListCallback> & callback) = 0;
+
+    /**
+     * Execute query to retrieve operations as flat records, all of them crossing the binding in a single call.
+     * Records are always partial, complete() has no effect on them.
+     * @param callback, if execute method succeed, ListCallback object returning a List of OperationRecord objects
+     */
+    virtual void executeRecords(const std::shared_ptr<OperationRecordListCallback> & callback) = 0;
 };
 
 } } }  // namespace ledger::core::api
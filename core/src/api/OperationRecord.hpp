@@ -0,0 +1,122 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#ifndef DJINNI_GENERATED_OPERATIONRECORD_HPP
+#define DJINNI_GENERATED_OPERATIONRECORD_HPP
+
+#include "../utils/optional.hpp"
+#include "OperationType.hpp"
+#include "TrustLevel.hpp"
+#include "WalletType.hpp"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ledger { namespace core { namespace api {
+
+/**
+ * Flat copy of an operation, made of plain values only. Records are returned in bulk by
+ * OperationQuery::executeRecords and don't need any further call to read their fields.
+ */
+struct OperationRecord final {
+    /** String, id of the operation. */
+    std::string uid;
+    /** 32-bit integer, index of the account in user's wallet. */
+    int32_t accountIndex;
+    /** Type of the operation. */
+    OperationType operationType;
+    /** Date on which the operation was issued. */
+    std::chrono::system_clock::time_point date;
+    /** List of string, senders of the operation. */
+    std::vector<std::string> senders;
+    /** List of string, recipients of the operation. */
+    std::vector<std::string> recipients;
+    /** String, amount of the operation in the smallest unit of the currency, in base 10. */
+    std::string amount;
+    /** Optional string, fees of the operation in the smallest unit of the currency, in base 10. */
+    std::experimental::optional<std::string> fees;
+    /** String, name of the currency of the operation. */
+    std::string currencyName;
+    /** Trust level of the operation. */
+    TrustLevel trustLevel;
+    /** Optional 64-bit integer, height of the block which includes the operation. */
+    std::experimental::optional<int64_t> blockHeight;
+    /** Type of wallet from which the operation was issued. */
+    WalletType walletType;
+
+    OperationRecord(std::string uid_,
+                    int32_t accountIndex_,
+                    OperationType operationType_,
+                    std::chrono::system_clock::time_point date_,
+                    std::vector<std::string> senders_,
+                    std::vector<std::string> recipients_,
+                    std::string amount_,
+                    std::experimental::optional<std::string> fees_,
+                    std::string currencyName_,
+                    TrustLevel trustLevel_,
+                    std::experimental::optional<int64_t> blockHeight_,
+                    WalletType walletType_)
+    : uid(std::move(uid_))
+    , accountIndex(std::move(accountIndex_))
+    , operationType(std::move(operationType_))
+    , date(std::move(date_))
+    , senders(std::move(senders_))
+    , recipients(std::move(recipients_))
+    , amount(std::move(amount_))
+    , fees(std::move(fees_))
+    , currencyName(std::move(currencyName_))
+    , trustLevel(std::move(trustLevel_))
+    , blockHeight(std::move(blockHeight_))
+    , walletType(std::move(walletType_))
+    {}
+
+    OperationRecord(const OperationRecord& cpy) {
+       this->uid = cpy.uid;
+       this->accountIndex = cpy.accountIndex;
+       this->operationType = cpy.operationType;
+       this->date = cpy.date;
+       this->senders = cpy.senders;
+       this->recipients = cpy.recipients;
+       this->amount = cpy.amount;
+       this->fees = cpy.fees;
+       this->currencyName = cpy.currencyName;
+       this->trustLevel = cpy.trustLevel;
+       this->blockHeight = cpy.blockHeight;
+       this->walletType = cpy.walletType;
+    }
+
+    OperationRecord() = default;
+
+
+    OperationRecord& operator=(const OperationRecord& cpy) {
+       this->uid = cpy.uid;
+       this->accountIndex = cpy.accountIndex;
+       this->operationType = cpy.operationType;
+       this->date = cpy.date;
+       this->senders = cpy.senders;
+       this->recipients = cpy.recipients;
+       this->amount = cpy.amount;
+       this->fees = cpy.fees;
+       this->currencyName = cpy.currencyName;
+       this->trustLevel = cpy.trustLevel;
+       this->blockHeight = cpy.blockHeight;
+       this->walletType = cpy.walletType;
+       return *this;
+    }
+
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(uid, accountIndex, operationType, date, senders, recipients, amount, fees, currencyName, trustLevel, blockHeight, walletType);
+    }
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(uid, accountIndex, operationType, date, senders, recipients, amount, fees, currencyName, trustLevel, blockHeight, walletType);
+    }
+};
+
+} } }  // namespace ledger::core::api
+#endif //DJINNI_GENERATED_OPERATIONRECORD_HPP
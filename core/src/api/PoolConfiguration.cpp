@@ -9,4 +9,10 @@ std::string const PoolConfiguration::DATABASE_NAME = {"DATABASE_NAME"};
 
 std::string const PoolConfiguration::ENABLE_INTERNAL_LOGGING = {"ENABLE_INTERNAL_LOGGING"};
 
+std::string const PoolConfiguration::MAX_CONCURRENT_WALLET_OPERATIONS = {"MAX_CONCURRENT_WALLET_OPERATIONS"};
+
+std::string const PoolConfiguration::ACCOUNT_EXECUTION_CONTEXTS = {"ACCOUNT_EXECUTION_CONTEXTS"};
+
+std::string const PoolConfiguration::DATABASE_READ_CONNECTIONS = {"DATABASE_READ_CONNECTIONS"};
+
 } } }  // namespace ledger::core::api
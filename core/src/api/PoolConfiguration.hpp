@@ -20,7 +20,7 @@ class LIBCORE_EXPORT PoolConfiguration {
 public:
     virtual ~PoolConfiguration() {}
 
-    /** Name to use for the database. */
+    /** Name to use for the database (libpq connection string with the PostgreSQL backend). */
     static std::string const DATABASE_NAME;
 
     /**
@@ -29,6 +29,31 @@ public:
      * Set to true by default.
      */
     static std::string const ENABLE_INTERNAL_LOGGING;
+
+    /**
+     * Maximum number of wallets (or accounts of a wallet) processed concurrently by pool-wide
+     * operations (e.g. erasing data).
+     *
+     * Set to 4 by default.
+     */
+    static std::string const MAX_CONCURRENT_WALLET_OPERATIONS;
+
+    /**
+     * Number of serial execution contexts shared by the accounts of the pool. Each account is
+     * bound to one of them, so that accounts run concurrently.
+     *
+     * Set to 8 by default.
+     */
+    static std::string const ACCOUNT_EXECUTION_CONTEXTS;
+
+    /**
+     * Number of read-only database connections, used by queries which never write (operations,
+     * UTXOs, balance history...) so that they don't wait behind the synchronization. Only
+     * supported by the SQLite backend, ignored otherwise.
+     *
+     * Set to 2 by default.
+     */
+    static std::string const DATABASE_READ_CONNECTIONS;
 };
 
 } } }  // namespace ledger::core::api
@@ -0,0 +1,12 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet_pool.djinni
+
+#include "WalletPool.hpp"  // my header
+
+namespace ledger { namespace core { namespace api {
+
+std::string const WalletPool::EV_PASSWORD_CHANGE_STORAGE = {"EV_PASSWORD_CHANGE_STORAGE"};
+
+std::string const WalletPool::EV_PASSWORD_CHANGE_PROCESSED_ENTRIES = {"EV_PASSWORD_CHANGE_PROCESSED_ENTRIES"};
+
+} } }  // namespace ledger::core::api
@@ -43,6 +43,15 @@ class LIBCORE_EXPORT WalletPool {
 public:
     virtual ~WalletPool() {}
 
+    /** Key of the storage being re-encrypted ("database" or "preferences") in the password change progress event payload. */
+    static std::string const EV_PASSWORD_CHANGE_STORAGE;
+
+    /**
+     * Key of the number of preferences entries re-encrypted so far in the password change progress event payload.
+     * The value is stored in a int 64.
+     */
+    static std::string const EV_PASSWORD_CHANGE_PROCESSED_ENTRIES;
+
     /**
      * Create a new instance of WalletPool object.
      * @param name, string, name of the wallet pool
@@ -0,0 +1,133 @@
+/*
+ *
+ * ExpiringCache
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_EXPIRINGCACHE_HPP
+#define LEDGER_CORE_EXPIRINGCACHE_HPP
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "Future.hpp"
+#include "Promise.hpp"
+#include "../utils/ImmediateExecutionContext.hpp"
+#include "../utils/Option.hpp"
+
+namespace ledger {
+    namespace core {
+        /**
+         * Keeps the last value produced by an asynchronous fetch for a fixed duration. Callers arriving while a fetch
+         * is running share its future instead of issuing the same request again. Failures are never cached.
+         */
+        template <typename T>
+        class ExpiringCache {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            explicit ExpiringCache(Clock::duration ttl) : _state(std::make_shared<State>()) {
+                _state->ttl = ttl;
+            };
+
+            Future<T> get(const std::function<Future<T> ()>& fetch) {
+                auto state = _state;
+                Promise<T> promise;
+                uint64_t generation;
+                {
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    if (state->value.nonEmpty() && Clock::now() < state->expiresAt) {
+                        return Future<T>::successful(state->value.getValue());
+                    }
+                    if (state->pending.nonEmpty()) {
+                        return state->pending.getValue();
+                    }
+                    generation = state->generation;
+                    state->pending = promise.getFuture();
+                }
+                auto future = Try<Future<T>>::from(fetch);
+                if (future.isFailure()) {
+                    Try<T> result;
+                    result.fail(future.getFailure());
+                    settle(state, generation, result);
+                    promise.complete(result);
+                } else {
+                    Future<T> fetched = future.getValue();
+                    fetched.onComplete(ImmediateExecutionContext::INSTANCE, [state, generation, promise] (const Try<T>& result) mutable {
+                        settle(state, generation, result);
+                        promise.complete(result);
+                    });
+                }
+                return promise.getFuture();
+            };
+
+            // Replaces the cached value, e.g. with a value pushed by a notification. Running fetches are discarded.
+            void put(const T& value) {
+                std::lock_guard<std::mutex> lock(_state->lock);
+                _state->generation += 1;
+                _state->pending = Option<Future<T>>();
+                _state->value = value;
+                _state->expiresAt = Clock::now() + _state->ttl;
+            };
+
+            void invalidate() {
+                std::lock_guard<std::mutex> lock(_state->lock);
+                _state->generation += 1;
+                _state->pending = Option<Future<T>>();
+                _state->value = Option<T>();
+            };
+
+        private:
+            struct State {
+                std::mutex lock;
+                Clock::duration ttl;
+                Option<T> value;
+                Clock::time_point expiresAt;
+                Option<Future<T>> pending;
+                // Bumped by put and invalidate so that fetches started before them don't overwrite the cache
+                uint64_t generation = 0;
+            };
+
+            static void settle(const std::shared_ptr<State>& state, uint64_t generation, const Try<T>& result) {
+                std::lock_guard<std::mutex> lock(state->lock);
+                if (state->generation != generation) {
+                    return;
+                }
+                state->pending = Option<Future<T>>();
+                if (result.isSuccess()) {
+                    state->value = result.getValue();
+                    state->expiresAt = Clock::now() + state->ttl;
+                }
+            };
+
+            std::shared_ptr<State> _state;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_EXPIRINGCACHE_HPP
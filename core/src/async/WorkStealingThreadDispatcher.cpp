@@ -0,0 +1,509 @@
+/*
+ *
+ * WorkStealingThreadDispatcher
+ * ledger-core
+ *
+ * Created by Ledger on 23/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "WorkStealingThreadDispatcher.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+#include "../api/Runnable.hpp"
+
+namespace ledger {
+    namespace core {
+        namespace internals {
+            using Task = std::shared_ptr<api::Runnable>;
+
+            static void runTask(const Task& task) {
+                try {
+                    task->run();
+                } catch (...) {
+                    // A failing task must not take its worker down
+                }
+            }
+
+            class WorkerPool : public std::enable_shared_from_this<WorkerPool> {
+            public:
+                explicit WorkerPool(size_t size) : _queued(0), _sleeping(0), _stopped(false), _next(0) {
+                    size = std::max<size_t>(size, 1);
+                    for (size_t index = 0; index < size; index++) {
+                        _workers.emplace_back(new Worker());
+                    }
+                }
+
+                // Workers keep the pool alive until they exit, so the pool may be stopped from
+                // one of its own tasks.
+                void start() {
+                    auto self = shared_from_this();
+                    for (size_t index = 0; index < _workers.size(); index++) {
+                        _workers[index]->thread = std::thread([self, index] () { self->work(index); });
+                    }
+                }
+
+                void submit(const Task& task) {
+                    if (_stopped.load()) {
+                        return;
+                    }
+                    // Tasks submitted from a worker go to its own deque, others are spread
+                    auto index = CURRENT_POOL == this ? CURRENT_WORKER : _next.fetch_add(1) % _workers.size();
+                    {
+                        std::lock_guard<std::mutex> lock(_workers[index]->lock);
+                        _workers[index]->tasks.push_back(task);
+                    }
+                    _queued.fetch_add(1);
+                    if (_sleeping.load() > 0) {
+                        { std::lock_guard<std::mutex> lock(_sleepLock); }
+                        _wakeUp.notify_one();
+                    }
+                }
+
+                void stop() {
+                    if (_stopped.exchange(true)) {
+                        return;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(_sleepLock);
+                    }
+                    _wakeUp.notify_all();
+                    for (auto& worker : _workers) {
+                        if (worker->thread.get_id() == std::this_thread::get_id()) {
+                            worker->thread.detach();
+                        } else if (worker->thread.joinable()) {
+                            worker->thread.join();
+                        }
+                    }
+                    // Pending tasks may hold contexts that hold the pool
+                    for (auto& worker : _workers) {
+                        std::lock_guard<std::mutex> lock(worker->lock);
+                        worker->tasks.clear();
+                    }
+                }
+
+                bool isStopped() const {
+                    return _stopped.load();
+                }
+
+            private:
+                struct Worker {
+                    std::mutex lock;
+                    std::deque<Task> tasks;
+                    std::thread thread;
+                };
+
+                // Newest task of the worker first (cache friendly), otherwise steal the oldest
+                // task of another worker.
+                bool take(size_t index, Task& task) {
+                    {
+                        auto& worker = *_workers[index];
+                        std::lock_guard<std::mutex> lock(worker.lock);
+                        if (!worker.tasks.empty()) {
+                            task = std::move(worker.tasks.back());
+                            worker.tasks.pop_back();
+                            return true;
+                        }
+                    }
+                    for (size_t offset = 1; offset < _workers.size(); offset++) {
+                        auto& victim = *_workers[(index + offset) % _workers.size()];
+                        std::lock_guard<std::mutex> lock(victim.lock);
+                        if (!victim.tasks.empty()) {
+                            task = std::move(victim.tasks.front());
+                            victim.tasks.pop_front();
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                void work(size_t index) {
+                    CURRENT_POOL = this;
+                    CURRENT_WORKER = index;
+                    Task task;
+                    while (!_stopped.load()) {
+                        if (take(index, task)) {
+                            _queued.fetch_sub(1);
+                            runTask(task);
+                            task.reset();
+                            continue;
+                        }
+                        std::unique_lock<std::mutex> lock(_sleepLock);
+                        _sleeping.fetch_add(1);
+                        _wakeUp.wait(lock, [this] () { return _queued.load() > 0 || _stopped.load(); });
+                        _sleeping.fetch_sub(1);
+                    }
+                }
+
+                std::vector<std::unique_ptr<Worker>> _workers;
+                std::atomic<size_t> _queued;
+                std::atomic<size_t> _sleeping;
+                std::atomic<bool> _stopped;
+                std::atomic<size_t> _next;
+                std::mutex _sleepLock;
+                std::condition_variable _wakeUp;
+
+                static thread_local WorkerPool *CURRENT_POOL;
+                static thread_local size_t CURRENT_WORKER;
+            };
+
+            thread_local WorkerPool *WorkerPool::CURRENT_POOL = nullptr;
+            thread_local size_t WorkerPool::CURRENT_WORKER = 0;
+
+            // Hashed timer wheel: timers are stored in the slot of their due tick and carry the
+            // number of wheel revolutions left before they fire.
+            class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+            public:
+                static const int64_t TICK_MS = 5;
+                static const size_t SLOTS = 512;
+
+                TimerWheel() : _slots(SLOTS), _tick(0), _count(0), _stopped(false),
+                               _origin(std::chrono::steady_clock::now()) {
+                }
+
+                void start() {
+                    auto self = shared_from_this();
+                    _thread = std::thread([self] () { self->run(); });
+                }
+
+                void schedule(const std::shared_ptr<api::ExecutionContext>& context, const Task& task, int64_t millis) {
+                    std::unique_lock<std::mutex> lock(_lock);
+                    if (_stopped) {
+                        return;
+                    }
+                    auto now = currentTick();
+                    if (_count == 0) {
+                        // The wheel was idle, skip the ticks elapsed since then
+                        _tick = now;
+                    }
+                    auto due = std::max(_tick, now + static_cast<uint64_t>((millis + TICK_MS - 1) / TICK_MS));
+                    _slots[due % SLOTS].push_back(Timer {context, task, (due - _tick) / SLOTS});
+                    _count += 1;
+                    lock.unlock();
+                    _wakeUp.notify_one();
+                }
+
+                void stop() {
+                    {
+                        std::lock_guard<std::mutex> lock(_lock);
+                        if (_stopped) {
+                            return;
+                        }
+                        _stopped = true;
+                        for (auto& slot : _slots) {
+                            slot.clear();
+                        }
+                        _count = 0;
+                    }
+                    _wakeUp.notify_all();
+                    if (_thread.get_id() == std::this_thread::get_id()) {
+                        _thread.detach();
+                    } else if (_thread.joinable()) {
+                        _thread.join();
+                    }
+                }
+
+            private:
+                struct Timer {
+                    std::shared_ptr<api::ExecutionContext> context;
+                    Task task;
+                    uint64_t rounds;
+                };
+
+                uint64_t currentTick() const {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _origin);
+                    return static_cast<uint64_t>(elapsed.count() / TICK_MS);
+                }
+
+                void run() {
+                    std::unique_lock<std::mutex> lock(_lock);
+                    std::vector<Timer> expired;
+                    while (!_stopped) {
+                        if (_count == 0) {
+                            _wakeUp.wait(lock, [this] () { return _count > 0 || _stopped; });
+                            continue;
+                        }
+                        if (currentTick() < _tick) {
+                            _wakeUp.wait_until(lock, _origin + std::chrono::milliseconds(_tick * TICK_MS));
+                            continue;
+                        }
+                        auto& slot = _slots[_tick % SLOTS];
+                        for (auto it = slot.begin(); it != slot.end();) {
+                            if (it->rounds == 0) {
+                                expired.push_back(std::move(*it));
+                                it = slot.erase(it);
+                            } else {
+                                it->rounds -= 1;
+                                ++it;
+                            }
+                        }
+                        _count -= expired.size();
+                        _tick += 1;
+                        if (!expired.empty()) {
+                            lock.unlock();
+                            for (auto& timer : expired) {
+                                timer.context->execute(timer.task);
+                            }
+                            expired.clear();
+                            lock.lock();
+                        }
+                    }
+                }
+
+                std::vector<std::vector<Timer>> _slots;
+                uint64_t _tick;
+                size_t _count;
+                bool _stopped;
+                std::chrono::steady_clock::time_point _origin;
+                std::mutex _lock;
+                std::condition_variable _wakeUp;
+                std::thread _thread;
+            };
+
+            const int64_t TimerWheel::TICK_MS;
+            const size_t TimerWheel::SLOTS;
+
+            class PoolExecutionContext : public api::ExecutionContext,
+                                         public std::enable_shared_from_this<PoolExecutionContext> {
+            public:
+                PoolExecutionContext(const std::shared_ptr<WorkerPool>& pool, const std::shared_ptr<TimerWheel>& timers)
+                    : _pool(pool), _timers(timers) {}
+
+                void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+                    _pool->submit(runnable);
+                }
+
+                void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+                    _timers->schedule(shared_from_this(), runnable, millis);
+                }
+
+            private:
+                std::shared_ptr<WorkerPool> _pool;
+                std::shared_ptr<TimerWheel> _timers;
+            };
+
+            // Serial context drained by the worker pool. Producers push on a lock-free
+            // multiple-producers single-consumer queue (Vyukov); the producer moving the task
+            // counter from 0 to 1 schedules a drain, so at most one worker runs the queue at a time.
+            class SerialExecutionContext : public api::ExecutionContext,
+                                           public std::enable_shared_from_this<SerialExecutionContext> {
+            public:
+                // Number of tasks run before yielding the worker to other contexts
+                static const size_t DRAIN_BATCH_SIZE = 64;
+
+                SerialExecutionContext(const std::shared_ptr<WorkerPool>& pool, const std::shared_ptr<TimerWheel>& timers)
+                    : _pool(pool), _timers(timers), _head(&_stub), _tail(&_stub), _pending(0) {
+                    _stub.next.store(nullptr);
+                }
+
+                ~SerialExecutionContext() {
+                    while (auto node = pop()) {
+                        delete node;
+                    }
+                }
+
+                void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+                    if (_pool->isStopped()) {
+                        return;
+                    }
+                    auto node = new Node();
+                    node->task = runnable;
+                    push(node);
+                    if (_pending.fetch_add(1) == 0) {
+                        scheduleDrain();
+                    }
+                }
+
+                void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+                    _timers->schedule(shared_from_this(), runnable, millis);
+                }
+
+            private:
+                struct Node {
+                    std::atomic<Node *> next;
+                    Task task;
+                    Node() : next(nullptr) {}
+                };
+
+                class DrainRunnable : public api::Runnable {
+                public:
+                    explicit DrainRunnable(const std::shared_ptr<SerialExecutionContext>& context) : _context(context) {}
+                    void run() override {
+                        _context->drain();
+                    }
+                private:
+                    std::shared_ptr<SerialExecutionContext> _context;
+                };
+
+                void scheduleDrain() {
+                    _pool->submit(std::make_shared<DrainRunnable>(shared_from_this()));
+                }
+
+                void drain() {
+                    for (size_t run = 0; run < DRAIN_BATCH_SIZE; run++) {
+                        Node *node;
+                        // A producer may be between its exchange and its link, wait for it
+                        while ((node = pop()) == nullptr) {
+                            std::this_thread::yield();
+                        }
+                        auto task = std::move(node->task);
+                        delete node;
+                        runTask(task);
+                        if (_pending.fetch_sub(1) == 1) {
+                            return;
+                        }
+                    }
+                    // Tasks are left, let other contexts run before continuing
+                    scheduleDrain();
+                }
+
+                void push(Node *node) {
+                    node->next.store(nullptr, std::memory_order_relaxed);
+                    auto previous = _head.exchange(node, std::memory_order_acq_rel);
+                    previous->next.store(node, std::memory_order_release);
+                }
+
+                // Only called by the single consumer.
+                Node *pop() {
+                    auto tail = _tail;
+                    auto next = tail->next.load(std::memory_order_acquire);
+                    if (tail == &_stub) {
+                        if (next == nullptr) {
+                            return nullptr;
+                        }
+                        _tail = next;
+                        tail = next;
+                        next = next->next.load(std::memory_order_acquire);
+                    }
+                    if (next != nullptr) {
+                        _tail = next;
+                        return tail;
+                    }
+                    if (tail != _head.load(std::memory_order_acquire)) {
+                        return nullptr;
+                    }
+                    push(&_stub);
+                    next = tail->next.load(std::memory_order_acquire);
+                    if (next != nullptr) {
+                        _tail = next;
+                        return tail;
+                    }
+                    return nullptr;
+                }
+
+                std::shared_ptr<WorkerPool> _pool;
+                std::shared_ptr<TimerWheel> _timers;
+                Node _stub;
+                std::atomic<Node *> _head;
+                Node *_tail;
+                std::atomic<size_t> _pending;
+            };
+
+            const size_t SerialExecutionContext::DRAIN_BATCH_SIZE;
+
+            class MutexLock : public api::Lock {
+            public:
+                void lock() override {
+                    _mutex.lock();
+                }
+
+                bool tryLock() override {
+                    return _mutex.try_lock();
+                }
+
+                void unlock() override {
+                    _mutex.unlock();
+                }
+
+            private:
+                std::recursive_mutex _mutex;
+            };
+        }
+
+        WorkStealingThreadDispatcher::WorkStealingThreadDispatcher()
+            : WorkStealingThreadDispatcher(std::thread::hardware_concurrency()) {
+        }
+
+        WorkStealingThreadDispatcher::WorkStealingThreadDispatcher(size_t workers) : _stopped(false) {
+            _pool = std::make_shared<internals::WorkerPool>(workers);
+            _pool->start();
+            _timers = std::make_shared<internals::TimerWheel>();
+            _timers->start();
+            _poolContext = std::make_shared<internals::PoolExecutionContext>(_pool, _timers);
+        }
+
+        WorkStealingThreadDispatcher::~WorkStealingThreadDispatcher() {
+            stop();
+        }
+
+        std::shared_ptr<api::ExecutionContext>
+        WorkStealingThreadDispatcher::getSerialExecutionContext(const std::string &name) {
+            std::lock_guard<std::mutex> lock(_lock);
+            auto it = _serialContexts.find(name);
+            if (it != _serialContexts.end()) {
+                return it->second;
+            }
+            auto context = std::make_shared<internals::SerialExecutionContext>(_pool, _timers);
+            _serialContexts[name] = context;
+            return context;
+        }
+
+        std::shared_ptr<api::ExecutionContext>
+        WorkStealingThreadDispatcher::getThreadPoolExecutionContext(const std::string &name) {
+            // All the thread pool contexts share the same workers
+            return _poolContext;
+        }
+
+        std::shared_ptr<api::ExecutionContext> WorkStealingThreadDispatcher::getMainExecutionContext() {
+            return getSerialExecutionContext("__main__");
+        }
+
+        std::shared_ptr<api::Lock> WorkStealingThreadDispatcher::newLock() {
+            return std::make_shared<internals::MutexLock>();
+        }
+
+        void WorkStealingThreadDispatcher::stop() {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (_stopped) {
+                    return;
+                }
+                _stopped = true;
+            }
+            _timers->stop();
+            _pool->stop();
+            _stoppedCondition.notify_all();
+        }
+
+        void WorkStealingThreadDispatcher::waitUntilStopped() {
+            std::unique_lock<std::mutex> lock(_lock);
+            _stoppedCondition.wait(lock, [this] () { return _stopped; });
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ *
+ * WorkStealingThreadDispatcher
+ * ledger-core
+ *
+ * Created by Ledger on 23/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_WORKSTEALINGTHREADDISPATCHER_HPP
+#define LEDGER_CORE_WORKSTEALINGTHREADDISPATCHER_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "../api/ThreadDispatcher.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../api/Lock.hpp"
+
+namespace ledger {
+    namespace core {
+        namespace internals {
+            class WorkerPool;
+            class TimerWheel;
+        }
+
+        /// Native thread dispatcher for hosts without an event loop of their own (servers, CLI).
+        ///
+        /// - Thread pool contexts share a pool of workers; each worker owns a task deque and idle
+        ///   workers steal from the others.
+        /// - Serial contexts are lock-free queues drained by the pool, one task at a time, so
+        ///   that creating many of them does not create threads.
+        /// - Delayed tasks are kept in a timer wheel serviced by a single thread.
+        ///
+        /// The main execution context is a serial context like the others. Call stop to release
+        /// the threads; pending tasks are dropped.
+        class WorkStealingThreadDispatcher : public api::ThreadDispatcher {
+        public:
+            WorkStealingThreadDispatcher();
+            explicit WorkStealingThreadDispatcher(size_t workers);
+            ~WorkStealingThreadDispatcher();
+
+            std::shared_ptr<api::ExecutionContext> getSerialExecutionContext(const std::string &name) override;
+            std::shared_ptr<api::ExecutionContext> getThreadPoolExecutionContext(const std::string &name) override;
+            std::shared_ptr<api::ExecutionContext> getMainExecutionContext() override;
+            std::shared_ptr<api::Lock> newLock() override;
+
+            void stop();
+            void waitUntilStopped();
+
+        private:
+            std::shared_ptr<internals::WorkerPool> _pool;
+            std::shared_ptr<internals::TimerWheel> _timers;
+            std::mutex _lock;
+            std::condition_variable _stoppedCondition;
+            bool _stopped;
+            std::unordered_map<std::string, std::shared_ptr<api::ExecutionContext>> _serialContexts;
+            std::shared_ptr<api::ExecutionContext> _poolContext;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_WORKSTEALINGTHREADDISPATCHER_HPP
@@ -32,7 +32,15 @@
 #define LEDGER_CORE_ALGORITHM_H
 
 #include "Future.hpp"
+#include "Promise.hpp"
 #include <utils/ImmediateExecutionContext.hpp>
+#include <utils/Unit.hpp>
+#include <utils/LambdaRunnable.hpp>
+#include <utils/Option.hpp>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
 
 namespace ledger {
     namespace core {
@@ -65,12 +73,165 @@ namespace ledger {
             });
             }
 
+            namespace internals {
+
+                /**
+                 * State of an asynchronous loop. A single frame is allocated per loop and reused by
+                 * every iteration: each step only keeps a reference on the frame, so the memory used
+                 * by a loop no longer grows with the number of iterations like a recursive flatMap
+                 * chain does.
+                 */
+                struct LoopFrame {
+                    std::shared_ptr<api::ExecutionContext> context;
+                    std::function<Future<bool> ()> body;
+                    Promise<Unit> promise;
+
+                    static void resume(const std::shared_ptr<LoopFrame>& frame) {
+                        auto step = Try<Future<bool>>::from([&frame] () -> Future<bool> {
+                            return frame->body();
+                        });
+                        if (step.isFailure()) {
+                            frame->promise.failure(step.getFailure());
+                            return;
+                        }
+                        Future<bool> future = step.getValue();
+                        future.onComplete(frame->context, [frame] (const Try<bool>& result) {
+                            if (result.isFailure()) {
+                                frame->promise.failure(result.getFailure());
+                            } else if (result.getValue()) {
+                                resume(frame);
+                            } else {
+                                frame->promise.success(unit);
+                            }
+                        });
+                    }
+                };
+
+            }
+
+            /**
+             * Run body until the future it returns is resolved with false. Every iteration is resumed
+             * on the given context (which should be a serial or thread pool context: with the
+             * ImmediateExecutionContext the loop would run on the stack of the completing future).
+             * The loop fails with the first error raised by the body.
+             * @param context The context on which iterations are scheduled.
+             * @param body The iteration, returning whether the loop must continue or not.
+             * @return A future resolved once the loop is over.
+             */
+            inline Future<Unit> doWhile(const std::shared_ptr<api::ExecutionContext>& context,
+                                        std::function<Future<bool> ()> body) {
+                auto frame = std::make_shared<internals::LoopFrame>();
+                frame->context = context;
+                frame->body = std::move(body);
+                auto future = frame->promise.getFuture();
+                context->execute(make_runnable([frame] () {
+                    internals::LoopFrame::resume(frame);
+                }));
+                return future;
+            }
+
+            /**
+             * Sequentially apply f on every element of items, waiting for the future returned by f
+             * before moving to the next element.
+             */
+            template <class T>
+            Future<Unit> forEach(const std::shared_ptr<api::ExecutionContext>& context,
+                                 std::vector<T> items,
+                                 std::function<Future<Unit> (const T&)> f) {
+                auto elements = std::make_shared<std::vector<T>>(std::move(items));
+                auto index = std::make_shared<size_t>(0);
+                return doWhile(context, [elements, index, f] () -> Future<bool> {
+                    if (*index >= elements->size()) {
+                        return Future<bool>::successful(false);
+                    }
+                    return f((*elements)[(*index)++]).template map<bool>(ImmediateExecutionContext::INSTANCE, [] (const Unit&) {
+                        return true;
+                    });
+                });
+            }
+
+            /**
+             * Sequentially fold items into an accumulator, starting from initial. Each call of f
+             * receives the accumulator produced by the previous one.
+             */
+            template <class T, class Acc>
+            Future<Acc> foldLeft(const std::shared_ptr<api::ExecutionContext>& context,
+                                 std::vector<T> items,
+                                 const Acc& initial,
+                                 std::function<Future<Acc> (const Acc&, const T&)> f) {
+                auto accumulator = std::make_shared<Acc>(initial);
+                return forEach<T>(context, std::move(items), [accumulator, f] (const T& item) -> Future<Unit> {
+                    return f(*accumulator, item).template map<Unit>(ImmediateExecutionContext::INSTANCE, [accumulator] (const Acc& result) {
+                        *accumulator = result;
+                        return unit;
+                    });
+                }).template map<Acc>(ImmediateExecutionContext::INSTANCE, [accumulator] (const Unit&) {
+                    return *accumulator;
+                });
+            }
+
+            /**
+             * Apply f on every element of items with at most maxConcurrency futures in flight at the
+             * same time. Elements are dispatched in order to maxConcurrency workers, each of them being
+             * a sequential loop pulling the next pending element. Once an element failed no new element
+             * is dispatched, but the result only completes (with the first failure) once every worker is
+             * done, so that no element is still being processed when the caller is notified.
+             * @param context The context on which workers are scheduled (a thread pool context allows
+             * the workers to progress in parallel).
+             * @param maxConcurrency The maximum number of elements processed at the same time (at least 1).
+             */
+            template <class T>
+            Future<Unit> parallelForEach(const std::shared_ptr<api::ExecutionContext>& context,
+                                         std::vector<T> items,
+                                         size_t maxConcurrency,
+                                         std::function<Future<Unit> (const T&)> f) {
+                struct State {
+                    std::vector<T> elements;
+                    std::atomic<size_t> next {0};
+                    std::mutex lock;
+                    Option<Exception> failure;
+                };
+                auto state = std::make_shared<State>();
+                state->elements = std::move(items);
+                auto workersCount = std::min(std::max<size_t>(maxConcurrency, 1), state->elements.size());
+                std::vector<Future<Unit>> workers;
+                workers.reserve(workersCount);
+                for (size_t worker = 0; worker < workersCount; worker++) {
+                    // Workers never fail: the first failure is kept aside and stops the dispatch
+                    workers.push_back(doWhile(context, [state, f] () -> Future<bool> {
+                        auto index = state->next++;
+                        {
+                            std::lock_guard<std::mutex> lock(state->lock);
+                            if (state->failure.nonEmpty() || index >= state->elements.size()) {
+                                return Future<bool>::successful(false);
+                            }
+                        }
+                        auto result = Try<Future<Unit>>::from([&] () {
+                            return f(state->elements[index]);
+                        });
+                        auto future = result.isSuccess() ? result.getValue() : Future<Unit>::failure(result.getFailure());
+                        return future.template map<bool>(ImmediateExecutionContext::INSTANCE, [] (const Unit&) {
+                            return true;
+                        }).recover(ImmediateExecutionContext::INSTANCE, [state] (const Exception& ex) -> bool {
+                            std::lock_guard<std::mutex> lock(state->lock);
+                            if (state->failure.isEmpty()) {
+                                state->failure = ex;
+                            }
+                            return false;
+                        });
+                    }));
+                }
+                return sequence(context, workers).template map<Unit>(ImmediateExecutionContext::INSTANCE, [state] (const std::vector<Unit>&) {
+                    std::lock_guard<std::mutex> lock(state->lock);
+                    if (state->failure.nonEmpty()) {
+                        throw state->failure.getValue();
+                    }
+                    return unit;
+                });
+            }
+
         }
     }
 }
 
-#define BEGIN_ASYNC_WHILE()
-
-#define ASYNC_FOREACH()
-
 #endif //LEDGER_CORE_ALGORITHM_H
@@ -88,9 +88,7 @@ namespace ledger {
         }
 
         std::string BitcoinLikeAddress::toBase58() {
-            auto config = std::make_shared<DynamicObject>();
-            config->putString("networkIdentifier", _params.Identifier);
-            return Base58::encodeWithChecksum(vector::concat(getVersionFromKeychainEngine(_keychainEngine, _params), _hash160), config);
+            return Base58::encodeWithChecksum(vector::concat(getVersionFromKeychainEngine(_keychainEngine, _params), _hash160), Base58::Parameters(_params.Identifier));
         }
 
         std::string toBech32Helper(const std::string &keychainEngine,
@@ -130,9 +128,7 @@ namespace ledger {
             if (_keychainEngine != api::KeychainEngines::BIP32_P2PKH && _keychainEngine != api::KeychainEngines::BIP49_P2SH) {
                 throw Exception(api::ErrorCode::INVALID_BASE58_FORMAT, "Base58 format only available for api::KeychainEngines::BIP32_P2PKH and api::KeychainEngines::BIP49_P2SH");
             }
-            auto config = std::make_shared<DynamicObject>();
-            config->putString("networkIdentifier", _params.Identifier);
-            return Base58::encodeWithChecksum(vector::concat(getVersionFromKeychainEngine(_keychainEngine, _params), _hash160), config);
+            return Base58::encodeWithChecksum(vector::concat(getVersionFromKeychainEngine(_keychainEngine, _params), _hash160), Base58::Parameters(_params.Identifier));
         }
 
         std::string BitcoinLikeAddress::toBech32() const {
@@ -156,19 +152,24 @@ namespace ledger {
         }
 
         std::string BitcoinLikeAddress::getStringAddress() const {
+            auto address = std::atomic_load(&_stringAddress);
+            if (address) {
+                return *address;
+            }
             if (_keychainEngine == api::KeychainEngines::BIP173_P2WPKH || _keychainEngine == api::KeychainEngines::BIP173_P2WSH) {
-                return toBech32();
+                address = std::make_shared<const std::string>(toBech32());
+            } else {
+                address = std::make_shared<const std::string>(toBase58());
             }
-            return toBase58();
+            std::atomic_store(&_stringAddress, address);
+            return *address;
         }
 
         std::shared_ptr<BitcoinLikeAddress> BitcoinLikeAddress::fromBase58(const std::string &address,
                                                                            const api::Currency &currency,
                                                                            const Option<std::string>& derivationPath) {
             auto& params = currency.bitcoinLikeNetworkParameters.value();
-            auto config = std::make_shared<DynamicObject>();
-            config->putString("networkIdentifier", params.Identifier);
-            auto decoded = Base58::checkAndDecode(address, config);
+            auto decoded = Base58::checkAndDecode(address, Base58::Parameters(params.Identifier));
             if (decoded.isFailure()) {
                 throw decoded.getFailure();
             }
@@ -205,14 +206,19 @@ namespace ledger {
                                                       const api::Currency &currency,
                                                       const std::string &derivationPath,
                                                       const std::string &keychainEngine) {
-            if (keychainEngine == api::KeychainEngines::BIP32_P2PKH || keychainEngine == api::KeychainEngines::BIP173_P2WPKH) {
-                return std::dynamic_pointer_cast<BitcoinLikeAddress>(pubKey->derive(derivationPath))->toString();
-            } else if (keychainEngine == api::KeychainEngines::BIP49_P2SH || keychainEngine == api::KeychainEngines::BIP173_P2WSH) {
-                auto hash160 = fromPublicKeyToHash160(pubKey->derivePublicKey(derivationPath), pubKey->deriveHash160(derivationPath), currency, keychainEngine);
-                return BitcoinLikeAddress(currency, hash160, keychainEngine).toString();
+            // Derive the child once, hashes are computed from its public key
+            auto hash160 = fromPublicKeyToHash160(pubKey->derivePublicKey(derivationPath), currency, keychainEngine);
+            return BitcoinLikeAddress(currency, hash160, keychainEngine).toString();
+        }
 
-            }
-            throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Invalid Keychain Engine: ", keychainEngine);
+        std::shared_ptr<BitcoinLikeAddress> BitcoinLikeAddress::fromPublicKey(const DeterministicPublicKey &key,
+                                                                              const api::Currency &currency,
+                                                                              const std::string &keychainEngine,
+                                                                              const Option<std::string>& derivationPath) {
+            return std::make_shared<BitcoinLikeAddress>(currency,
+                                                        fromPublicKeyToHash160(key.getPublicKey(), currency, keychainEngine),
+                                                        keychainEngine,
+                                                        derivationPath);
         }
 
         std::vector<uint8_t> BitcoinLikeAddress::fromPublicKeyToHash160(const std::vector<uint8_t> &pubKey,
@@ -243,11 +249,15 @@ namespace ledger {
         std::vector<uint8_t> BitcoinLikeAddress::fromPublicKeyToHash160(const std::vector<uint8_t> &pubKey,
                                                                         const api::Currency &currency,
                                                                         const std::string &keychainEngine) {
+            if (keychainEngine == api::KeychainEngines::BIP173_P2WSH) {
+                // The witness script hash doesn't need the public key hash
+                return fromPublicKeyToHash160(pubKey, {}, currency, keychainEngine);
+            }
             HashAlgorithm hashAlgorithm(currency.bitcoinLikeNetworkParameters.value().Identifier);
             auto publicKeyHash160 = HASH160::hash(pubKey, hashAlgorithm);
             if (keychainEngine == api::KeychainEngines::BIP32_P2PKH || keychainEngine == api::KeychainEngines::BIP173_P2WPKH) {
                 return publicKeyHash160;
-            } else if (keychainEngine == api::KeychainEngines::BIP49_P2SH || keychainEngine == api::KeychainEngines::BIP173_P2WSH) {
+            } else if (keychainEngine == api::KeychainEngines::BIP49_P2SH) {
                 return fromPublicKeyToHash160(pubKey, publicKeyHash160, currency, keychainEngine);
             }
             throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Invalid Keychain Engine: ", keychainEngine);
@@ -37,6 +37,7 @@
 #include <wallet/common/AbstractAddress.h>
 #include <api/BitcoinLikeExtendedPublicKey.hpp>
 #include <collections/DynamicObject.hpp>
+#include <crypto/DeterministicPublicKey.hpp>
 namespace ledger {
     namespace core {
         class BitcoinLikeAddress : public api::BitcoinLikeAddress, public AbstractAddress {
@@ -78,6 +79,13 @@ namespace ledger {
                                              const std::string &derivationPath,
                                              const std::string &keychainEngine);
 
+            // Build the address of an already derived key. Hashes are computed once and the
+            // string form is only encoded when it is first requested.
+            static std::shared_ptr<BitcoinLikeAddress> fromPublicKey(const DeterministicPublicKey &key,
+                                                                     const api::Currency &currency,
+                                                                     const std::string &keychainEngine,
+                                                                     const Option<std::string>& derivationPath = Option<std::string>());
+
             static std::vector<uint8_t> fromPublicKeyToHash160(const std::vector<uint8_t> &pubKey,
                                                                const std::vector<uint8_t> &pubKeyHash160,
                                                                const api::Currency &currency,
@@ -93,6 +101,8 @@ namespace ledger {
             const api::BitcoinLikeNetworkParameters _params;
             const Option<std::string> _derivationPath;
             const std::string _keychainEngine;
+            // Encoded form of the address, computed on first use
+            mutable std::shared_ptr<const std::string> _stringAddress;
         };
     }
 }
@@ -48,16 +48,16 @@ namespace ledger {
                                                                    const DeterministicPublicKey& key,
                                                                    const std::shared_ptr<DynamicObject> &configuration,
                                                                    const DerivationPath& path) :
-            _currency(currency), _key(key), _configuration(configuration), _path(path)
+            _currency(currency), _key(key), _configuration(configuration), _path(path),
+            _keychainEngine(configuration->getString(api::Configuration::KEYCHAIN_ENGINE).value_or(api::KeychainEngines::BIP32_P2PKH))
         {}
 
         std::shared_ptr<api::BitcoinLikeAddress> BitcoinLikeExtendedPublicKey::derive(const std::string &path) {
             DerivationPath p(path);
             auto key = _derive(0, p.toVector(), _key);
-            auto keychainEngine = _configuration->getString(api::Configuration::KEYCHAIN_ENGINE).value_or(api::KeychainEngines::BIP32_P2PKH);
             return std::make_shared<BitcoinLikeAddress>(_currency,
                                                         key.getPublicKeyHash160(),
-                                                        keychainEngine,
+                                                        _keychainEngine,
                                                         optional<std::string>((_path + p).toString()));
         }
 
@@ -105,5 +105,9 @@ namespace ledger {
             return BitcoinExtendedPublicKey::deriveHash160(path);
         }
 
+        DeterministicPublicKey BitcoinLikeExtendedPublicKey::deriveKey(const DerivationPath &path) const {
+            return _derive(0, path.toVector(), _key);
+        }
+
     }
 }
@@ -56,6 +56,9 @@ namespace ledger {
 
             std::vector<uint8_t> deriveHash160(const std::string &path) override;
 
+            // Derive the public key at the given relative path, without building any address.
+            DeterministicPublicKey deriveKey(const DerivationPath& path) const;
+
             std::string toBase58() override;
 
             std::string getRootPath() override;
@@ -96,6 +99,8 @@ namespace ledger {
             const DerivationPath _path;
             const DeterministicPublicKey _key;
             const std::shared_ptr<DynamicObject> _configuration;
+            // Read once from the configuration, derive() is called for every address
+            const std::string _keychainEngine;
         };
     }
 }
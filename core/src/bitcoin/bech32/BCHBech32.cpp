@@ -30,11 +30,11 @@
 
 #include "BCHBech32.h"
 #include <utils/Exception.hpp>
+#include <algorithm>
 namespace ledger {
     namespace core {
-        uint64_t BCHBech32::polymod(const std::vector<uint8_t>& values) {
-            uint64_t chk = 1;
-            for (size_t i = 0; i < values.size(); ++i) {
+        uint64_t BCHBech32::polymod(uint64_t chk, const uint8_t* values, size_t size) const {
+            for (size_t i = 0; i < size; ++i) {
                 uint64_t top = chk >> 35;
                 chk = (chk & 0x07ffffffff) << 5 ^ values[i];
                 size_t index = 0;
@@ -59,13 +59,22 @@ namespace ledger {
 
         std::string BCHBech32::encode(const std::vector<uint8_t>& hash,
                                       const std::vector<uint8_t>& version) {
-            std::vector<uint8_t> data(version);
-            data.insert(data.end(), hash.begin(), hash.end());
+            // Version and hash are converted together
+            uint8_t data[MAX_LENGTH];
+            if (version.size() + hash.size() > MAX_LENGTH) {
+                throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid hash : too long for bech 32 format");
+            }
+            std::copy(version.begin(), version.end(), data);
+            std::copy(hash.begin(), hash.end(), data + version.size());
             int fromBits = 8, toBits = 5;
             bool pad = true;
-            std::vector<uint8_t> converted;
-            Bech32::convertBits(data, fromBits, toBits, pad, converted);
-            return encodeBech32(converted);
+            uint8_t converted[MAX_LENGTH];
+            size_t convertedSize = 0;
+            if (!Bech32::convertBits(data, version.size() + hash.size(), fromBits, toBits, pad,
+                                     converted, MAX_LENGTH, convertedSize)) {
+                throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid hash : too long for bech 32 format");
+            }
+            return encodeBech32(converted, convertedSize);
         }
 
         std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
@@ -74,21 +83,25 @@ namespace ledger {
             if (decoded.first != _bech32Params.hrp || decoded.second.size() < 1) {
                 throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid address : Invalid bech 32 format");
             }
-            std::vector<uint8_t> converted;
+            uint8_t converted[MAX_LENGTH];
+            size_t convertedSize = 0;
             int fromBits = 5, toBits = 8;
             bool pad = false;
-            auto result = Bech32::convertBits(decoded.second,
+            auto result = Bech32::convertBits(decoded.second.data(),
+                                              decoded.second.size(),
                                               fromBits,
                                               toBits,
                                               pad,
-                                              converted);
-            if (!result || converted.size() < 2 ||
-                converted.size() > 42 || decoded.second[0] > 16 ||
-                (decoded.second[0] == 0 && converted.size() != 21 && converted.size() != 33)) {
+                                              converted,
+                                              MAX_LENGTH,
+                                              convertedSize);
+            if (!result || convertedSize < 2 ||
+                convertedSize > 42 || decoded.second[0] > 16 ||
+                (decoded.second[0] == 0 && convertedSize != 21 && convertedSize != 33)) {
                 throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid address : Invalid bech 32 format");
             }
             std::vector<uint8_t> version{converted[0]};
-            return std::make_pair(version, std::vector<uint8_t>(converted.begin() + 1, converted.end()));
+            return std::make_pair(version, std::vector<uint8_t>(converted + 1, converted + convertedSize));
         }
     }
 }
\ No newline at end of file
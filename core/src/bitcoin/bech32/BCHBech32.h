@@ -41,9 +41,12 @@ namespace ledger {
         public:
             BCHBech32() {
                 _bech32Params = Bech32Parameters::getBech32Params("abc");
+                initialize();
             };
 
-            uint64_t polymod(const std::vector<uint8_t>& values) override;
+            using Bech32::polymod;
+
+            uint64_t polymod(uint64_t chk, const uint8_t* values, size_t size) const override;
 
             std::vector<uint8_t> expandHrp(const std::string& hrp) override;
 
@@ -31,12 +31,13 @@
 
 #include "BTCBech32.h"
 #include <utils/Exception.hpp>
+#include <algorithm>
 
 namespace ledger {
     namespace core {
-        uint64_t BTCBech32::polymod(const std::vector<uint8_t>& values) {
-            uint32_t chk = 1;
-            for (size_t i = 0; i < values.size(); ++i) {
+        uint64_t BTCBech32::polymod(uint64_t initialChk, const uint8_t* values, size_t size) const {
+            uint32_t chk = static_cast<uint32_t>(initialChk);
+            for (size_t i = 0; i < size; ++i) {
                 uint8_t top = chk >> 25;
                 chk = (chk & 0x1ffffff) << 5 ^ values[i];
                 auto index = 0;
@@ -62,13 +63,17 @@ namespace ledger {
 
         std::string BTCBech32::encode(const std::vector<uint8_t>& hash,
                                       const std::vector<uint8_t>& version) {
-            std::vector<uint8_t> data(hash);
             int fromBits = 8, toBits = 5;
             bool pad = true;
-            std::vector<uint8_t> converted;
-            converted.insert(converted.end(), version.begin(), version.end());
-            Bech32::convertBits(data, fromBits, toBits, pad, converted);
-            return encodeBech32(converted);
+            uint8_t converted[MAX_LENGTH];
+            size_t convertedSize = 0;
+            if (version.size() > MAX_LENGTH ||
+                !Bech32::convertBits(hash.data(), hash.size(), fromBits, toBits, pad,
+                                     converted + version.size(), MAX_LENGTH - version.size(), convertedSize)) {
+                throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid hash : too long for bech 32 format");
+            }
+            std::copy(version.begin(), version.end(), converted);
+            return encodeBech32(converted, version.size() + convertedSize);
         }
 
         std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
@@ -77,21 +82,25 @@ namespace ledger {
             if (decoded.first != _bech32Params.hrp || decoded.second.size() < 1) {
                 throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid address : Invalid bech 32 format");
             }
-            std::vector<uint8_t> converted;
+            uint8_t converted[MAX_LENGTH];
+            size_t convertedSize = 0;
             int fromBits = 5, toBits = 8;
             bool pad = false;
-            auto result = Bech32::convertBits(std::vector<uint8_t>(decoded.second.begin() + 1, decoded.second.end()),
+            auto result = Bech32::convertBits(decoded.second.data() + 1,
+                                              decoded.second.size() - 1,
                                               fromBits,
                                               toBits,
                                               pad,
-                                              converted);
-            if (!result || converted.size() < 2 ||
-                converted.size() > 40 || decoded.second[0] > 16 ||
-                (decoded.second[0] == 0 && converted.size() != 20 && converted.size() != 32)) {
+                                              converted,
+                                              MAX_LENGTH,
+                                              convertedSize);
+            if (!result || convertedSize < 2 ||
+                convertedSize > 40 || decoded.second[0] > 16 ||
+                (decoded.second[0] == 0 && convertedSize != 20 && convertedSize != 32)) {
                 throw Exception(api::ErrorCode::INVALID_BECH32_FORMAT, "Invalid address : Invalid bech 32 format");
             }
             std::vector<uint8_t> version{decoded.second[0]};
-            return std::make_pair(version, converted);
+            return std::make_pair(version, std::vector<uint8_t>(converted, converted + convertedSize));
         }
     }
 }
\ No newline at end of file
@@ -30,7 +30,6 @@
 
 
 #include "Bech32.h"
-#include <collections/vector.hpp>
 namespace ledger {
     namespace core {
 
@@ -49,16 +48,27 @@ namespace ledger {
                 1,  0,  3, 16, 11, 28, 12, 14,  6,  4,  2, -1, -1, -1, -1, -1
         };
 
+        const size_t Bech32::MAX_LENGTH;
+
+        void Bech32::initialize() {
+            auto expandedHrp = expandHrp(_bech32Params.hrp);
+            _hrpPolymod = polymod(1, expandedHrp.data(), expandedHrp.size());
+        }
+
+        // Polymod of expanded HRP + values + checksumSize zeros
+        uint64_t Bech32::checksumPolymod(const uint8_t* values, size_t size) const {
+            static const uint8_t zeros[16] = {0};
+            return polymod(polymod(_hrpPolymod, values, size), zeros, _bech32Params.checksumSize);
+        }
+
         // Verify a checksum.
-        bool Bech32::verifyChecksum(const std::vector<uint8_t>& values) {
-            return polymod(vector::concat(expandHrp(_bech32Params.hrp), values)) == 1;
+        bool Bech32::verifyChecksum(const std::vector<uint8_t>& values) const {
+            return polymod(_hrpPolymod, values.data(), values.size()) == 1;
         }
 
         // Create a checksum.
-        std::vector<uint8_t> Bech32::createChecksum(const std::vector<uint8_t>& values) {
-            std::vector<uint8_t> enc = vector::concat(expandHrp(_bech32Params.hrp), values);
-            enc.resize(enc.size() + _bech32Params.checksumSize);
-            uint64_t mod = polymod(enc) ^ 1;
+        std::vector<uint8_t> Bech32::createChecksum(const std::vector<uint8_t>& values) const {
+            uint64_t mod = checksumPolymod(values.data(), values.size()) ^ 1;
             std::vector<uint8_t> ret;
             ret.resize(_bech32Params.checksumSize);
             // Can't use ssize_t because it's posix specific (problem with MSVC build) so let's
@@ -69,24 +79,42 @@ namespace ledger {
             }
             return ret;
         }
-        
-        std::string Bech32::encodeBech32(const std::vector<uint8_t>& values) {
+
+        std::string Bech32::encodeBech32(const std::vector<uint8_t>& values) const {
+            return encodeBech32(values.data(), values.size());
+        }
+
+        std::string Bech32::encodeBech32(const uint8_t* values, size_t size) const {
             // Values here should be concatenation of version + hash
-            std::vector<uint8_t> checksum = createChecksum(values);
-            std::vector<uint8_t> combined = vector::concat(values, checksum);
-            std::string ret = _bech32Params.hrp + _bech32Params.separator;
-            ret.reserve(ret.size() + combined.size());
-            for (size_t i = 0; i < combined.size(); ++i) {
+            uint64_t mod = checksumPolymod(values, size) ^ 1;
+            std::string ret;
+            ret.reserve(_bech32Params.hrp.size() + _bech32Params.separator.size() + size + _bech32Params.checksumSize);
+            ret += _bech32Params.hrp;
+            ret += _bech32Params.separator;
+            for (size_t i = 0; i < size; ++i) {
                 // There is not check on size here because this method is called
                 // after calling Bech32::convertBits which basically guarantees
-                // combined[i] being in range
-                ret += charset[combined[i]];
+                // values[i] being in range
+                ret += charset[values[i]];
+            }
+            for (int i = _bech32Params.checksumSize - 1; i >= 0; --i) {
+                ret += charset[(mod >> (5 * i)) & 31];
             }
             return ret;
         }
 
+        std::vector<std::string> Bech32::encodeBatch(const std::vector<std::vector<uint8_t>>& hashes,
+                                                     const std::vector<uint8_t>& version) {
+            std::vector<std::string> result;
+            result.reserve(hashes.size());
+            for (auto& hash : hashes) {
+                result.push_back(encode(hash, version));
+            }
+            return result;
+        }
+
         std::pair<std::string, std::vector<uint8_t>>
-        Bech32::decodeBech32(const std::string& str) {
+        Bech32::decodeBech32(const std::string& str) const {
             bool lower = false, upper = false;
             bool ok = true;
             for (size_t i = 0; ok && i < str.size(); ++i) {
@@ -97,22 +125,21 @@ namespace ledger {
             }
             if (lower && upper) ok = false;
             size_t pos = str.rfind(_bech32Params.separator);
-            if (ok && str.size() <= 90 && pos != str.npos && pos >= 1 && pos + _bech32Params.checksumSize + 1 <= str.size()) {
-                std::vector<uint8_t> values;
-                values.resize(str.size() - 1 - pos);
-                for (size_t i = 0; i < str.size() - 1 - pos; ++i) {
+            if (ok && str.size() <= MAX_LENGTH && pos != str.npos && pos >= 1 && pos + _bech32Params.checksumSize + 1 <= str.size()) {
+                uint8_t values[MAX_LENGTH];
+                const size_t size = str.size() - 1 - pos;
+                for (size_t i = 0; i < size; ++i) {
                     unsigned char c = str[i + pos + 1];
                     if (charsetRev[c] == -1) ok = false;
                     values[i] = charsetRev[c];
                 }
-                if (ok) {
+                if (ok && polymod(_hrpPolymod, values, size) == 1) {
                     std::string hrp;
+                    hrp.reserve(pos);
                     for (size_t i = 0; i < pos; ++i) {
                         hrp += toLowerCase(str[i]);
                     }
-                    if (verifyChecksum(values)) {
-                        return std::make_pair(hrp, std::vector<uint8_t>(values.begin(), values.end() - _bech32Params.checksumSize));
-                    }
+                    return std::make_pair(hrp, std::vector<uint8_t>(values, values + size - _bech32Params.checksumSize));
                 }
             }
             return std::make_pair(std::string(), std::vector<uint8_t>());
@@ -129,21 +156,43 @@ namespace ledger {
                                  int toBits,
                                  bool pad,
                                  std::vector<uint8_t>& out) {
+            const auto offset = out.size();
+            const auto capacity = (in.size() * fromBits + toBits - 1) / toBits;
+            size_t size = 0;
+            out.resize(offset + capacity);
+            auto result = convertBits(in.data(), in.size(), fromBits, toBits, pad, out.data() + offset, capacity, size);
+            out.resize(offset + size);
+            return result;
+        }
+
+        bool Bech32::convertBits(const uint8_t* in,
+                                 size_t inSize,
+                                 int fromBits,
+                                 int toBits,
+                                 bool pad,
+                                 uint8_t* out,
+                                 size_t outCapacity,
+                                 size_t& outSize) {
             int acc = 0;
             int bits = 0;
             const int maxv = (1 << toBits) - 1;
             const int max_acc = (1 << (fromBits + toBits - 1)) - 1;
-            for (size_t i = 0; i < in.size(); ++i) {
+            outSize = 0;
+            for (size_t i = 0; i < inSize; ++i) {
                 int value = in[i];
                 acc = ((acc << fromBits) | value) & max_acc;
                 bits += fromBits;
                 while (bits >= toBits) {
                     bits -= toBits;
-                    out.push_back((acc >> bits) & maxv);
+                    if (outSize == outCapacity) return false;
+                    out[outSize++] = (acc >> bits) & maxv;
                 }
             }
             if (pad) {
-                if (bits) out.push_back((acc << (toBits - bits)) & maxv);
+                if (bits) {
+                    if (outSize == outCapacity) return false;
+                    out[outSize++] = (acc << (toBits - bits)) & maxv;
+                }
             } else if (bits >= fromBits || ((acc << (toBits - bits)) & maxv)) {
                 return false;
             }
@@ -36,6 +36,7 @@
 // BIP173: https://github.com/bitcoin/bips/blob/master/bip-0173.mediawiki
 // Implementation: https://github.com/sipa/bech32/tree/master/ref/c%2B%2B
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "Bech32Parameters.h"
@@ -45,23 +46,37 @@ namespace ledger {
     namespace core {
         class Bech32 {
         public:
+            // Maximum length of a Bech32 string (hrp, separator, data and checksum)
+            static const size_t MAX_LENGTH = 90;
+
+            virtual ~Bech32() = default;
+
+            // Find the polynomial with value coefficients mod the generator as 64-bit, starting from chk.
+            virtual uint64_t polymod(uint64_t chk, const uint8_t* values, size_t size) const = 0;
+
             // Find the polynomial with value coefficients mod the generator as 64-bit.
-            virtual uint64_t polymod(const std::vector<uint8_t>& values) = 0;
+            uint64_t polymod(const std::vector<uint8_t>& values) const {
+                return polymod(1, values.data(), values.size());
+            }
 
             // Expand a HRP for use in checksum computation.
             virtual std::vector<uint8_t> expandHrp(const std::string& hrp) = 0;
 
-            bool verifyChecksum(const std::vector<uint8_t>& values);
+            bool verifyChecksum(const std::vector<uint8_t>& values) const;
 
-            std::vector<uint8_t> createChecksum(const std::vector<uint8_t>& values);
+            std::vector<uint8_t> createChecksum(const std::vector<uint8_t>& values) const;
 
             virtual std::string encode(const std::vector<uint8_t>& hash,
                                        const std::vector<uint8_t>& version) = 0;
 
+            // Encode many hashes sharing the same witness version in one call
+            std::vector<std::string> encodeBatch(const std::vector<std::vector<uint8_t>>& hashes,
+                                                 const std::vector<uint8_t>& version);
+
             // Decode from bech32 address
             // @return pair<hrp, hash>
             std::pair<std::string, std::vector<uint8_t>>
-            decodeBech32(const std::string& str);
+            decodeBech32(const std::string& str) const;
             // @return tuple<witnessVersion, hash>
             virtual std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
             decode(const std::string& str) = 0;
@@ -74,13 +89,35 @@ namespace ledger {
                                     bool pad,
                                     std::vector<uint8_t>& out);
 
-            Bech32Parameters::Bech32Struct getBech32Params() {
+            // Same as above, writing at most outCapacity values to out and their count to outSize.
+            // Fails if out is too small.
+            static bool convertBits(const uint8_t* in,
+                                    size_t inSize,
+                                    int fromBits,
+                                    int toBits,
+                                    bool pad,
+                                    uint8_t* out,
+                                    size_t outCapacity,
+                                    size_t& outSize);
+
+            const Bech32Parameters::Bech32Struct& getBech32Params() const {
                 return _bech32Params;
             }
 
         protected:
-            std::string encodeBech32(const std::vector<uint8_t>& values);
+            // Must be called by implementations once _bech32Params is set, to precompute the HRP part of checksums
+            void initialize();
+
+            std::string encodeBech32(const std::vector<uint8_t>& values) const;
+            std::string encodeBech32(const uint8_t* values, size_t size) const;
+
             Bech32Parameters::Bech32Struct _bech32Params;
+
+        private:
+            uint64_t checksumPolymod(const uint8_t* values, size_t size) const;
+
+            // Checksum state after the expanded HRP
+            uint64_t _hrpPolymod;
         };
     }
 }
@@ -35,10 +35,16 @@
 namespace ledger {
     namespace core {
         Option<std::shared_ptr<Bech32>> Bech32Factory::newBech32Instance(const std::string &networkIdentifier) {
-            if (networkIdentifier == "btc" || networkIdentifier == "btc_testnet") {
-                return Option<std::shared_ptr<Bech32>>(std::make_shared<BTCBech32>(networkIdentifier));
+            // Instances hold no mutable state once built, they are shared to keep their precomputed HRP checksum
+            if (networkIdentifier == "btc") {
+                static const std::shared_ptr<Bech32> BITCOIN = std::make_shared<BTCBech32>(networkIdentifier);
+                return Option<std::shared_ptr<Bech32>>(BITCOIN);
+            } else if (networkIdentifier == "btc_testnet") {
+                static const std::shared_ptr<Bech32> BITCOIN_TESTNET = std::make_shared<BTCBech32>(networkIdentifier);
+                return Option<std::shared_ptr<Bech32>>(BITCOIN_TESTNET);
             } else if (networkIdentifier == "abc") {
-                return Option<std::shared_ptr<Bech32>>(std::make_shared<BCHBech32>());
+                static const std::shared_ptr<Bech32> BITCOIN_CASH = std::make_shared<BCHBech32>();
+                return Option<std::shared_ptr<Bech32>>(BITCOIN_CASH);
             }
             return Option<std::shared_ptr<Bech32>>();
         }
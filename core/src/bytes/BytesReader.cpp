@@ -40,11 +40,27 @@ namespace ledger {
 
     namespace core {
 
-        BytesReader::BytesReader(const std::vector<uint8_t> &data, unsigned long offset, unsigned long length) {
-            _bytes = data;
-            _offset = offset;
-            _length = length;
-            _cursor = offset;
+        BytesReader::BytesReader(const std::vector<uint8_t> &data, unsigned long offset, unsigned long length)
+            : _bytes(data.data()), _cursor(offset), _offset(offset), _length(length) {
+        }
+
+        BytesReader::BytesReader(std::vector<uint8_t> &&data, unsigned long offset, unsigned long length)
+            : _owned(std::make_shared<const std::vector<uint8_t>>(std::move(data))), _cursor(offset), _offset(offset),
+              _length(length) {
+            _bytes = _owned->data();
+        }
+
+        BytesReader::BytesReader(std::vector<uint8_t> &&data) : BytesReader(std::move(data), 0, data.size()) {
+        }
+
+        BytesReader::BytesReader(const uint8_t *data, unsigned long length)
+            : _bytes(data), _cursor(0), _offset(0), _length(length) {
+        }
+
+        void BytesReader::checkReadable(unsigned long length) const {
+            if (length > available()) {
+                throw std::out_of_range(fmt::format("Cannot read {} bytes, only {} remaining", length, available()));
+            }
         }
 
         void BytesReader::seek(long offset, BytesReader::Seek origin) {
@@ -69,9 +85,7 @@ namespace ledger {
         }
 
         std::vector<uint8_t> BytesReader::read(unsigned long length) {
-           std::vector<uint8_t> out(length);
-            read(length, out);
-            return out;
+            return readView(length).toVector();
         }
         void BytesReader::reset() {
             _cursor = 0;
@@ -90,19 +104,12 @@ namespace ledger {
         }
 
         std::string BytesReader::readString(unsigned long length) {
-            std::string result(length, '0');
-            auto index = 0UL;
-            for (auto byte : read(length)) {
-                result[index] = byte;
-                index += 1;
-            }
-            return result;
+            return readView(length).toString();
         }
 
         uint8_t BytesReader::readNextByte() {
-            uint8_t result = _bytes[_cursor];
-            seek(1, Seek::CUR);
-            return result;
+            checkReadable(1);
+            return _bytes[_cursor++];
         }
 
         std::string BytesReader::readNextString() {
@@ -165,8 +172,7 @@ namespace ledger {
         }
 
         ledger::core::BigInt BytesReader::readNextBeBigInt(size_t bytes) {
-            std::vector<uint8_t> data(bytes);
-            read(bytes, data);
+            auto data = readView(bytes);
             return BigInt(data.data(), data.size(), false);
         }
 
@@ -192,7 +198,13 @@ namespace ledger {
                 default:
                     return size;
             }
-            return readNextLeBigInt(size).toUint64();
+            checkReadable(size);
+            uint64_t result = 0;
+            for (auto i = 0; i < size; i++) {
+                result |= static_cast<uint64_t>(_bytes[_cursor + i]) << (8 * i);
+            }
+            _cursor += size;
+            return result;
         }
 
         std::string BytesReader::readNextVarString() {
@@ -200,7 +212,13 @@ namespace ledger {
             return readString(length);
         }
 
+        BytesView BytesReader::readNextVarView() {
+            uint64_t length = readNextVarInt();
+            return readView(length);
+        }
+
         uint8_t BytesReader::peek() const {
+            checkReadable(1);
             return _bytes[_cursor];
         }
 
@@ -209,10 +227,15 @@ namespace ledger {
         }
 
         void BytesReader::read(unsigned long length, std::vector<uint8_t> &data) {
-            for (auto i = 0; i < length; i++) {
-                data[i] = _bytes[_cursor];
-                seek(1, Seek::CUR);
-            }
+            auto view = readView(length);
+            std::copy(view.begin(), view.end(), data.begin());
+        }
+
+        BytesView BytesReader::readView(unsigned long length) {
+            checkReadable(length);
+            BytesView view(_bytes + _cursor, length);
+            _cursor += length;
+            return view;
         }
 
 
@@ -34,7 +34,9 @@
 #include <cstdint>
 #include <array>
 #include <vector>
+#include <memory>
 #include "../math/BigInt.h"
+#include "BytesView.h"
 #include "../ledger-core.h"
 
 namespace ledger {
@@ -55,18 +57,29 @@ namespace ledger {
 
         public:
             /**
-             * Creates a new bytes reader starting at the given offset and able to read up to length bytes.
+             * Creates a new bytes reader starting at the given offset and able to read up to length bytes. The reader
+             * does not copy data, which must outlive the reader (and every view returned by it).
              * @param data The data to read.
              * @param offset The reader will start reading at this index in the vector.
              * @param length The maximum size on which the reader can read data.
              */
             BytesReader(const std::vector<uint8_t>& data, unsigned long offset, unsigned long length);
             /**
-             * Creates a new bytes reader starting at byte 0 and able to read bytes until the end of data.
+             * Creates a new bytes reader starting at byte 0 and able to read bytes until the end of data. The reader
+             * does not copy data, which must outlive the reader (and every view returned by it).
              * @param data The data to read.
              * @return
              */
             BytesReader(const std::vector<uint8_t>& data) : BytesReader(data, 0, data.size()) {};
+            /**
+             * Same as above but takes ownership of data, so temporaries can be handed to the reader.
+             */
+            BytesReader(std::vector<uint8_t>&& data, unsigned long offset, unsigned long length);
+            BytesReader(std::vector<uint8_t>&& data);
+            /**
+             * Creates a new bytes reader on a raw buffer of length bytes. The buffer must outlive the reader.
+             */
+            BytesReader(const uint8_t* data, unsigned long length);
 
             /**
              * Sets the position indicator associated with the BytesReader to a new position.
@@ -82,6 +95,12 @@ namespace ledger {
              */
             std::vector<uint8_t> read(unsigned long length);
             void read(unsigned long length, std::vector<uint8_t>& out);
+            /**
+             * Reads *length* bytes and advance the cursor in the reader, without copying them.
+             * @param length Number of bytes to read.
+             * @return A view on the read bytes, valid as long as the underlying data is.
+             */
+            BytesView readView(unsigned long length);
 
             /**
              * Reads a single byte.
@@ -130,6 +149,11 @@ namespace ledger {
 
             uint64_t readNextVarInt();
             std::string readNextVarString();
+            /**
+             * Reads a var int prefixed byte array without copying it.
+             * @return A view on the read bytes, valid as long as the underlying data is.
+             */
+            BytesView readNextVarView();
 
             std::vector<uint8_t> readUntilEnd();
 
@@ -156,7 +180,11 @@ namespace ledger {
 
 
         private:
-            std::vector<uint8_t> _bytes;
+            void checkReadable(unsigned long length) const;
+
+        private:
+            std::shared_ptr<const std::vector<uint8_t>> _owned;
+            const uint8_t* _bytes;
             unsigned long _cursor;
             unsigned long _offset;
             unsigned long _length;
@@ -0,0 +1,98 @@
+/*
+ *
+ * BytesView
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Non-owning, read-only view over a contiguous range of bytes. A view never outlives the buffer it was
+         * created from: it is meant to be consumed right away (hashed, hexified, copied into a writer...) without
+         * paying for an intermediate std::vector.
+         */
+        class BytesView {
+        public:
+            using const_iterator = const uint8_t *;
+
+            BytesView() : _data(nullptr), _size(0) {};
+            BytesView(const uint8_t *data, size_t size) : _data(data), _size(size) {};
+            BytesView(const std::vector<uint8_t> &data) : _data(data.data()), _size(data.size()) {};
+
+            inline const uint8_t *data() const { return _data; }
+            inline size_t size() const { return _size; }
+            inline bool empty() const { return _size == 0; }
+
+            inline const_iterator begin() const { return _data; }
+            inline const_iterator end() const { return _data + _size; }
+
+            inline uint8_t operator[](size_t index) const { return _data[index]; }
+
+            /**
+             * Returns a view on [offset, offset + length) of this view.
+             * @throw std::out_of_range if the requested range does not fit in this view.
+             */
+            BytesView subview(size_t offset, size_t length) const {
+                if (offset > _size || length > _size - offset) {
+                    throw std::out_of_range("Sub view is out of the bounds of the viewed bytes");
+                }
+                return BytesView(_data + offset, length);
+            }
+
+            /**
+             * Copies the viewed bytes into a new vector.
+             */
+            inline std::vector<uint8_t> toVector() const { return std::vector<uint8_t>(begin(), end()); }
+
+            /**
+             * Copies the viewed bytes into a new string.
+             */
+            inline std::string toString() const { return std::string(reinterpret_cast<const char *>(_data), _size); }
+
+            bool operator==(const BytesView &other) const {
+                return _size == other._size && (_size == 0 || std::memcmp(_data, other._data, _size) == 0);
+            }
+
+            bool operator!=(const BytesView &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            const uint8_t *_data;
+            size_t _size;
+        };
+    }
+}
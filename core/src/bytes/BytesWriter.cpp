@@ -39,21 +39,31 @@ namespace ledger {
             _bytes = std::vector<uint8_t>(size);
         }
 
-        std::vector<uint8_t> BytesWriter::toByteArray() const {
+        BytesWriter &BytesWriter::reserve(size_t size) {
+            _bytes.reserve(size);
+            return *this;
+        }
+
+        std::vector<uint8_t> BytesWriter::toByteArray() const & {
             return _bytes;
         }
 
+        std::vector<uint8_t> BytesWriter::toByteArray() && {
+            return std::move(_bytes);
+        }
+
         BytesWriter &BytesWriter::writeByteArray(const std::vector<uint8_t> &data) {
-            for (auto byte : data) {
-                writeByte(byte);
-            }
+            _bytes.insert(_bytes.end(), data.begin(), data.end());
+            return *this;
+        }
+
+        BytesWriter &BytesWriter::writeByteArray(const uint8_t *data, size_t size) {
+            _bytes.insert(_bytes.end(), data, data + size);
             return *this;
         }
 
         BytesWriter &BytesWriter::writeLeByteArray(const std::vector<uint8_t> &data) {
-            for (auto it = data.rbegin(); it != data.rend(); it++) {
-                writeByte(*it);
-            }
+            _bytes.insert(_bytes.end(), data.rbegin(), data.rend());
             return *this;
         }
 
@@ -69,9 +79,7 @@ namespace ledger {
         }
 
         BytesWriter &BytesWriter::writeString(const std::string &str) {
-            for (auto c : str) {
-                writeByte(c);
-            }
+            _bytes.insert(_bytes.end(), str.begin(), str.end());
             return *this;
         }
 
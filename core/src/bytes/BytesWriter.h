@@ -47,6 +47,22 @@ namespace ledger {
             BytesWriter(size_t size);
             BytesWriter() {};
 
+            /**
+             * Reserves capacity for at least size bytes, so that a writer whose final size is known (or can be
+             * computed) up front allocates only once.
+             * @param size
+             * @return
+             */
+            BytesWriter& reserve(size_t size);
+
+            /**
+             * Returns the number of bytes written so far.
+             * @return
+             */
+            inline size_t size() const {
+                return _bytes.size();
+            }
+
             /**
              * Write a single byte into the writer.
              * @param byte
@@ -106,6 +122,14 @@ namespace ledger {
              */
             BytesWriter& writeByteArray(const std::vector<uint8_t>& data);
 
+            /**
+             * Writes size bytes starting at data into the writer.
+             * @param data
+             * @param size
+             * @return
+             */
+            BytesWriter& writeByteArray(const uint8_t* data, size_t size);
+
             /**
              * Write a byte array in reverse order.
              * @param data
@@ -145,10 +169,17 @@ namespace ledger {
             BytesWriter& writeVarString(const std::string& str);
 
             /**
-             * Returns the serialized data.
+             * Returns a copy of the serialized data.
+             * @return
+             */
+            std::vector<uint8_t> toByteArray() const &;
+
+            /**
+             * Moves the serialized data out of an expiring writer (e.g. `return std::move(writer).toByteArray();`
+             * on a local writer), avoiding a copy. Chained writes return an lvalue and still copy.
              * @return
              */
-            std::vector<uint8_t> toByteArray() const;
+            std::vector<uint8_t> toByteArray() &&;
 
         private:
             std::vector<uint8_t> _bytes;
@@ -0,0 +1,104 @@
+/*
+ *
+ * LRUCache
+ * ledger-core
+ *
+ * Created by Ledger on 22/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_LRUCACHE_HPP
+#define LEDGER_CORE_LRUCACHE_HPP
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include "../utils/Option.hpp"
+
+namespace ledger {
+    namespace core {
+        /// Bounded map evicting the least recently used entry when it is full.
+        ///
+        /// This class is not thread safe, callers must synchronize the accesses.
+        template <typename K, typename V, typename Hash = std::hash<K>>
+        class LRUCache {
+        public:
+            explicit LRUCache(size_t capacity) : _capacity(capacity) {}
+
+            Option<V> get(const K& key) {
+                auto it = _index.find(key);
+                if (it == _index.end()) {
+                    return Option<V>::NONE;
+                }
+                // Move the entry to the front of the list
+                _entries.splice(_entries.begin(), _entries, it->second);
+                return Option<V>(it->second->second);
+            }
+
+            void put(const K& key, const V& value) {
+                if (_capacity == 0) {
+                    return;
+                }
+                auto it = _index.find(key);
+                if (it != _index.end()) {
+                    it->second->second = value;
+                    _entries.splice(_entries.begin(), _entries, it->second);
+                    return;
+                }
+                if (_entries.size() >= _capacity) {
+                    _index.erase(_entries.back().first);
+                    _entries.pop_back();
+                }
+                _entries.emplace_front(key, value);
+                _index[key] = _entries.begin();
+            }
+
+            void remove(const K& key) {
+                auto it = _index.find(key);
+                if (it != _index.end()) {
+                    _entries.erase(it->second);
+                    _index.erase(it);
+                }
+            }
+
+            void clear() {
+                _index.clear();
+                _entries.clear();
+            }
+
+            size_t size() const {
+                return _entries.size();
+            }
+
+        private:
+            using Entries = std::list<std::pair<K, V>>;
+            size_t _capacity;
+            Entries _entries;
+            std::unordered_map<K, typename Entries::iterator, Hash> _index;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_LRUCACHE_HPP
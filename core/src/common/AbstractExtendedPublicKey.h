@@ -62,9 +62,7 @@ namespace ledger {
             }
 
             std::string toBase58() {
-                auto config = std::make_shared<DynamicObject>();
-                config->putString("networkIdentifier", params().Identifier);
-                return Base58::encodeWithChecksum(getKey().toByteArray(params().XPUBVersion), config);
+                return Base58::encodeWithChecksum(getKey().toByteArray(params().XPUBVersion), Base58::Parameters(params().Identifier));
             }
 
             static DeterministicPublicKey
@@ -97,12 +95,7 @@ namespace ledger {
                        const Option<std::string> &path,
                        const std::string &networkBase58Dictionary = "") {
                 //xpubBase58 should be composed of version(4) || depth(1) || fingerprint(4) || index(4) || chain(32) || key(33)
-                auto config = std::make_shared<DynamicObject>();
-                config->putString("networkIdentifier", params.Identifier);
-                if (!networkBase58Dictionary.empty()) {
-                    config->putString("base58Dictionary", networkBase58Dictionary);
-                }
-                auto decodeResult = Base58::checkAndDecode(xpubBase58, config);
+                auto decodeResult = Base58::checkAndDecode(xpubBase58, Base58::Parameters(params.Identifier, networkBase58Dictionary));
                 if (decodeResult.isFailure())
                     throw decodeResult.getFailure();
                 BytesReader reader(decodeResult.getValue());
@@ -32,10 +32,101 @@
 #include "AESCipher.hpp"
 #include "PBKDF2.hpp"
 #include "AES256.hpp"
+#include "../utils/Exception.hpp"
+#include <openssl/aes.h>
+#include <openssl/evp.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <mutex>
 
 namespace ledger {
     namespace core {
+        namespace {
+            // Size of the nonce and of the tag used by the authenticated mode
+            const size_t GCM_NONCE_SIZE = 12;
+            const size_t GCM_TAG_SIZE = 16;
+
+            // Number of bytes produced by the IV generator before it is seeded again
+            const uint64_t GENERATOR_RESEED_INTERVAL = 1 << 20;
+
+            void check(int result, const char *operation) {
+                if (result != 1) {
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to {}", operation);
+                }
+            }
+        }
+
+        // The key schedules are computed once per cipher and the EVP interface is used so that
+        // OpenSSL picks the AES-NI implementation when the CPU supports it. IVs are produced by
+        // an AES-256-CTR generator seeded with the RNG given to the cipher, instead of asking
+        // the RNG for every encrypted chunk.
+        struct AESCipher::Context {
+            Context(const std::shared_ptr<api::RandomNumberGenerator>& rng, const std::vector<uint8_t>& key)
+                : rng(rng), generated(0) {
+                encryption = EVP_CIPHER_CTX_new();
+                decryption = EVP_CIPHER_CTX_new();
+                authenticated = EVP_CIPHER_CTX_new();
+                generator = EVP_CIPHER_CTX_new();
+                if (!encryption || !decryption || !authenticated || !generator) {
+                    release();
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to allocate cipher contexts");
+                }
+                try {
+                    check(EVP_EncryptInit_ex(encryption, EVP_aes_256_cbc(), nullptr, key.data(), nullptr), "initialize encryption");
+                    check(EVP_CIPHER_CTX_set_padding(encryption, 0), "initialize encryption");
+                    check(EVP_DecryptInit_ex(decryption, EVP_aes_256_cbc(), nullptr, key.data(), nullptr), "initialize decryption");
+                    check(EVP_CIPHER_CTX_set_padding(decryption, 0), "initialize decryption");
+                    check(EVP_EncryptInit_ex(authenticated, EVP_aes_256_gcm(), nullptr, key.data(), nullptr), "initialize authenticated encryption");
+                    seed();
+                } catch (...) {
+                    release();
+                    throw;
+                }
+            }
+
+            ~Context() {
+                release();
+            }
+
+            void release() {
+                if (encryption) EVP_CIPHER_CTX_free(encryption);
+                if (decryption) EVP_CIPHER_CTX_free(decryption);
+                if (authenticated) EVP_CIPHER_CTX_free(authenticated);
+                if (generator) EVP_CIPHER_CTX_free(generator);
+                encryption = decryption = authenticated = generator = nullptr;
+            }
+
+            void seed() {
+                auto seed = rng->getRandomBytes(32 + AES256::BLOCK_SIZE);
+                if (seed.size() != 32 + AES256::BLOCK_SIZE) {
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to seed the IV generator");
+                }
+                check(EVP_EncryptInit_ex(generator, EVP_aes_256_ctr(), nullptr, seed.data(), seed.data() + 32), "seed the IV generator");
+                std::fill(seed.begin(), seed.end(), 0);
+                generated = 0;
+            }
+
+            // Fill the buffer with random bytes; the caller must hold the lock.
+            void random(uint8_t *output, size_t size) {
+                if (generated >= GENERATOR_RESEED_INTERVAL) {
+                    seed();
+                }
+                std::memset(output, 0, size);
+                int written = 0;
+                check(EVP_EncryptUpdate(generator, output, &written, output, static_cast<int>(size)), "generate an IV");
+                generated += size;
+            }
+
+            std::mutex lock;
+            std::shared_ptr<api::RandomNumberGenerator> rng;
+            uint64_t generated;
+            EVP_CIPHER_CTX *encryption = nullptr;
+            EVP_CIPHER_CTX *decryption = nullptr;
+            EVP_CIPHER_CTX *authenticated = nullptr;
+            EVP_CIPHER_CTX *generator = nullptr;
+        };
+
         AESCipher::AESCipher(const std::shared_ptr<api::RandomNumberGenerator> &rng, const std::string &password,
                              const std::string &salt, uint32_t iter) {
             _rng = rng;
@@ -43,6 +134,37 @@ namespace ledger {
                     std::vector<uint8_t>(password.data(), password.data() + password.size()),
                     std::vector<uint8_t>(salt.data(), salt.data() + salt.size())
                     , iter, 32);
+            _context = std::make_shared<Context>(rng, _key);
+        }
+
+        std::vector<uint8_t> AESCipher::encryptChunk(const uint8_t *data, size_t size, std::vector<uint8_t>& IV) {
+            // Same layout as AES256::encrypt: the last block is zero padded and an extra block
+            // is always reserved, so that data encrypted by either function can be read by both
+            const auto blockSize = AES256::BLOCK_SIZE;
+            const auto head = size - size % blockSize;
+            std::vector<uint8_t> encrypted((size / blockSize + 1) * blockSize, 0);
+            IV.resize(blockSize);
+
+            std::lock_guard<std::mutex> lock(_context->lock);
+            _context->random(IV.data(), IV.size());
+            check(EVP_EncryptInit_ex(_context->encryption, nullptr, nullptr, nullptr, IV.data()), "encrypt data");
+            int written = 0;
+            check(EVP_EncryptUpdate(_context->encryption, encrypted.data(), &written, data, static_cast<int>(head)), "encrypt data");
+            if (head != size) {
+                uint8_t last[AES_BLOCK_SIZE] = {0};
+                std::memcpy(last, data + head, size - head);
+                check(EVP_EncryptUpdate(_context->encryption, encrypted.data() + head, &written, last, blockSize), "encrypt data");
+            }
+            return encrypted;
+        }
+
+        std::vector<uint8_t> AESCipher::decryptChunk(const uint8_t *data, size_t size, const std::vector<uint8_t>& IV) {
+            std::vector<uint8_t> decrypted(size, 0);
+            std::lock_guard<std::mutex> lock(_context->lock);
+            check(EVP_DecryptInit_ex(_context->decryption, nullptr, nullptr, nullptr, IV.data()), "decrypt data");
+            int written = 0;
+            check(EVP_DecryptUpdate(_context->decryption, decrypted.data(), &written, data, static_cast<int>(size)), "decrypt data");
+            return decrypted;
         }
 
         void AESCipher::encrypt(std::istream *input, std::ostream *output) {
@@ -51,17 +173,15 @@ namespace ledger {
             input->seekg(0, input->beg);
             uint32_t maxRead = 254 * AES256::BLOCK_SIZE;
             uint8_t buffer[maxRead];
+            std::vector<uint8_t> IV;
             do {
                 // Read 254 * AES_BLOCK_SIZE bytes (we want at most 0xFF blocks to encrypt we the same IV)
                 input->read((char *)buffer, maxRead);
                 uint32_t read = input->gcount();
 
-                // Create an IVt
-                auto IV = _rng->getRandomBytes(AES256::BLOCK_SIZE);
+                // Encrypt with a fresh IV
+                auto encrypted = encryptChunk(buffer, read, IV);
                 assert(IV.size() == AES256::BLOCK_SIZE);
-
-                // Encrypt
-                auto encrypted = AES256::encrypt(IV, _key, std::vector<uint8_t>(buffer, buffer + read));
                 // Store number of blocks
                 uint8_t blocksCount = (encrypted.size() / AES256::BLOCK_SIZE);
                 (*output) << blocksCount;
@@ -80,19 +200,18 @@ namespace ledger {
             input->seekg(0, input->beg);
             uint32_t maxRead = 255 * AES256::BLOCK_SIZE;
             uint8_t buffer[maxRead];
+            std::vector<uint8_t> IV(AES256::BLOCK_SIZE);
             do {
                 uint8_t blocksCount;
                 uint32_t dataSize;
                 (*input) >> blocksCount;
                 (*input) >> dataSize;
 
-                std::vector<uint8_t> IV;
-                IV.resize(AES256::BLOCK_SIZE);
                 input->read((char *)IV.data(), IV.size());
                 input->read((char *)buffer, blocksCount * AES256::BLOCK_SIZE);
                 if (input->gcount() < blocksCount * AES256::BLOCK_SIZE)
                     break;
-                auto decrypted = AES256::decrypt(IV, _key, std::vector<uint8_t>(buffer, buffer + (blocksCount * AES256::BLOCK_SIZE)));
+                auto decrypted = decryptChunk(buffer, blocksCount * AES256::BLOCK_SIZE, IV);
                 output->write((char *)decrypted.data(), dataSize);
             } while (!input->eof());
 #endif
@@ -100,16 +219,15 @@ namespace ledger {
 
         void AESCipher::encrypt(BytesReader& input, BytesWriter& output) {
             uint32_t maxRead = 254 * AES256::BLOCK_SIZE;
+            std::vector<uint8_t> IV;
             do {
                 // Read 254 * AES_BLOCK_SIZE bytes (we want at most 0xFF blocks to encrypt we the same IV)
                 uint32_t available = input.available();
                 uint32_t minEncryptedRead = std::min(maxRead,available);
                 std::vector<uint8_t> dataToEncrypt = input.read(minEncryptedRead);
                 uint32_t read = dataToEncrypt.size();
-                // Create an IVt
-                auto IV = _rng->getRandomBytes(AES256::BLOCK_SIZE);
-                // Encrypt
-                auto encrypted = AES256::encrypt(IV, _key, dataToEncrypt);
+                // Encrypt with a fresh IV
+                auto encrypted = encryptChunk(dataToEncrypt.data(), read, IV);
                 // Store number of blocks
                 uint8_t blocksCount = (encrypted.size() / AES256::BLOCK_SIZE);
                 //Number of blocks of size AES256::BLOCK_SIZE in enrypted data
@@ -124,7 +242,6 @@ namespace ledger {
         }
 
         void AESCipher::decrypt(BytesReader& input, BytesWriter& output) {
-            uint32_t maxRead = 255 * AES256::BLOCK_SIZE;
             do {
                 //Get number of blocks in encrypted data
                 uint8_t blocksCount = input.readNextByte();
@@ -143,7 +260,7 @@ namespace ledger {
                 //Read encrypted data
                 std::vector<uint8_t> encryptedData = input.read(encryptedDataSize);
                 //Decrypt
-                auto decrypted = AES256::decrypt(IV, _key, encryptedData);
+                auto decrypted = decryptChunk(encryptedData.data(), encryptedData.size(), IV);
                 //Truncate if needed to size of encrypted data that we stored in dataSize bytes
                 if(dataSize <  decrypted.size()){
                     decrypted.resize(dataSize);
@@ -152,5 +269,49 @@ namespace ledger {
                 output.writeByteArray(decrypted);
             } while (input.hasNext());
         }
+
+        std::vector<uint8_t> AESCipher::encryptAuthenticated(const std::vector<uint8_t>& data) {
+            std::vector<uint8_t> output(GCM_NONCE_SIZE + data.size() + GCM_TAG_SIZE);
+            auto nonce = output.data();
+            auto ciphertext = nonce + GCM_NONCE_SIZE;
+            auto tag = ciphertext + data.size();
+
+            std::lock_guard<std::mutex> lock(_context->lock);
+            auto ctx = _context->authenticated;
+            _context->random(nonce, GCM_NONCE_SIZE);
+            check(EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce, 1), "encrypt data");
+            int written = 0;
+            if (!data.empty()) {
+                check(EVP_EncryptUpdate(ctx, ciphertext, &written, data.data(), static_cast<int>(data.size())), "encrypt data");
+            }
+            check(EVP_EncryptFinal_ex(ctx, ciphertext + written, &written), "encrypt data");
+            check(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, tag), "encrypt data");
+            return output;
+        }
+
+        std::vector<uint8_t> AESCipher::decryptAuthenticated(const std::vector<uint8_t>& data) {
+            if (data.size() < GCM_NONCE_SIZE + GCM_TAG_SIZE) {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Encrypted data is too short ({} bytes)", data.size());
+            }
+            auto size = data.size() - GCM_NONCE_SIZE - GCM_TAG_SIZE;
+            auto nonce = data.data();
+            auto ciphertext = nonce + GCM_NONCE_SIZE;
+            std::vector<uint8_t> tag(ciphertext + size, ciphertext + size + GCM_TAG_SIZE);
+            std::vector<uint8_t> output(size);
+
+            std::lock_guard<std::mutex> lock(_context->lock);
+            auto ctx = _context->authenticated;
+            check(EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr, nonce, 0), "decrypt data");
+            int written = 0;
+            if (size > 0) {
+                check(EVP_DecryptUpdate(ctx, output.data(), &written, ciphertext, static_cast<int>(size)), "decrypt data");
+            }
+            check(EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, tag.data()), "decrypt data");
+            uint8_t final[AES_BLOCK_SIZE];
+            if (EVP_DecryptFinal_ex(ctx, final, &written) != 1) {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Unable to authenticate encrypted data");
+            }
+            return output;
+        }
     }
 }
@@ -51,9 +51,24 @@ namespace ledger {
          void encrypt(BytesReader& input, BytesWriter& output);
          void decrypt(BytesReader& input, BytesWriter& output);
 
+         /// Encrypt and authenticate data with AES-256-GCM. The output is laid out as
+         /// nonce (12 bytes) || ciphertext || tag (16 bytes).
+         std::vector<uint8_t> encryptAuthenticated(const std::vector<uint8_t>& data);
+
+         /// Decrypt data produced by encryptAuthenticated. Throws if the data was tampered with
+         /// or was not encrypted with the same key.
+         std::vector<uint8_t> decryptAuthenticated(const std::vector<uint8_t>& data);
+
      private:
+         // OpenSSL contexts and IV generator, created once and shared by the copies of the cipher
+         struct Context;
+
+         std::vector<uint8_t> encryptChunk(const uint8_t *data, size_t size, std::vector<uint8_t>& IV);
+         std::vector<uint8_t> decryptChunk(const uint8_t *data, size_t size, const std::vector<uint8_t>& IV);
+
          std::shared_ptr<api::RandomNumberGenerator> _rng;
          std::vector<uint8_t> _key;
+         std::shared_ptr<Context> _context;
      };
  }
 }
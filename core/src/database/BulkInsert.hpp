@@ -0,0 +1,91 @@
+/*
+ *
+ * BulkInsert
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BULKINSERT_HPP
+#define LEDGER_CORE_BULKINSERT_HPP
+
+#include <soci.h>
+#include "Upsert.hpp"
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        // SQLite rejects statements binding more parameters than this by default
+        static const std::size_t BULK_INSERT_MAX_PARAMETERS = 999;
+        // Limit of the PostgreSQL wire protocol (parameter count is sent as a 16 bits integer)
+        static const std::size_t BULK_INSERT_MAX_PARAMETERS_POSTGRESQL = 65535;
+
+        /**
+         * Insert rows with multi-row "INSERT INTO table VALUES (...), (...)" statements, split so that no statement
+         * binds more than BULK_INSERT_MAX_PARAMETERS values (BULK_INSERT_MAX_PARAMETERS_POSTGRESQL on PostgreSQL). The binder is called once per row and must exchange
+         * exactly `columns` values with soci::use on the given statement, in column order. Bound rows must outlive
+         * the call. If ignoreConflicts is set, rows conflicting with existing ones are skipped (see insertOrIgnore).
+         */
+        template <typename Row, typename Binder>
+        void bulkInsert(soci::session& sql,
+                        const std::string& table,
+                        std::size_t columns,
+                        const std::vector<Row>& rows,
+                        Binder bind,
+                        bool ignoreConflicts = false) {
+            if (rows.empty() || columns == 0) {
+                return;
+            }
+            const auto maxParameters = sql.get_backend_name() == "postgresql" ?
+                                       BULK_INSERT_MAX_PARAMETERS_POSTGRESQL : BULK_INSERT_MAX_PARAMETERS;
+            const auto rowsPerStatement = std::max<std::size_t>(1, maxParameters / columns);
+            for (std::size_t offset = 0; offset < rows.size(); offset += rowsPerStatement) {
+                auto count = std::min(rowsPerStatement, rows.size() - offset);
+                std::stringstream values;
+                values << "VALUES ";
+                soci::statement statement(sql);
+                for (std::size_t index = 0; index < count; index++) {
+                    values << (index == 0 ? "(" : ", (");
+                    for (std::size_t column = 0; column < columns; column++) {
+                        values << (column == 0 ? ":v" : ", :v") << index * columns + column;
+                    }
+                    values << ")";
+                    bind(statement, rows[offset + index]);
+                }
+                auto query = ignoreConflicts ? insertOrIgnore(sql, table, values.str())
+                                             : "INSERT INTO " + table + " " + values.str();
+                statement.alloc();
+                statement.prepare(query);
+                statement.define_and_bind();
+                statement.execute(true);
+            }
+        }
+    }
+}
+
+#endif //LEDGER_CORE_BULKINSERT_HPP
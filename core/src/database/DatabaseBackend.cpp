@@ -32,6 +32,9 @@
 #include "SQLite3Backend.hpp"
 #include <api/DatabaseEngine.hpp>
 #include "ProxyBackend.hpp"
+#ifdef PG_SUPPORT
+#include "PostgreSQLBackend.hpp"
+#endif
 
 namespace ledger {
     namespace core {
@@ -40,6 +43,14 @@ namespace ledger {
             return std::make_shared<SQLite3Backend>();
         }
 
+        std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::getPostgreSQLBackend(int32_t connectionPoolSize) {
+#ifdef PG_SUPPORT
+            return std::make_shared<PostgreSQLBackend>(connectionPoolSize);
+#else
+            throw make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "PostgreSQL backend is not available, build with PG_SUPPORT.");
+#endif
+        }
+
         std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::createBackendFromEngine(
                 const std::shared_ptr<ledger::core::api::DatabaseEngine> &engine) {
             return std::make_shared<ProxyBackend>(engine);
@@ -36,6 +36,7 @@
 #include <soci.h>
 #include <memory>
 #include "../api/PathResolver.hpp"
+#include <utils/Exception.hpp>
 
 namespace ledger {
     namespace core {
@@ -59,6 +60,28 @@ namespace ledger {
                     soci::session &session
             ) = 0;
 
+            /**
+             * Backends able to serve reads while a write is running (e.g. SQLite in WAL mode) open additional
+             * read-only sessions, gathered by DatabaseSessionPool::getReadonlyPool.
+             */
+            virtual bool supportsReadonlySessions() {
+                return false;
+            }
+
+            virtual void initReadonly(
+                    const std::shared_ptr<api::PathResolver> &resolver,
+                    const std::string &dbName,
+                    const std::string &password,
+                    soci::session &session
+            ) {
+                throw make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Read-only sessions are not supported by this backend.");
+            }
+
+            virtual void setReadonlyPassword(const std::string &password,
+                                             soci::session &session) {
+                throw make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Read-only sessions are not supported by this backend.");
+            }
+
             std::shared_ptr<api::DatabaseBackend> enableQueryLogging(bool enable) override;
 
             bool isLoggingEnabled() override;
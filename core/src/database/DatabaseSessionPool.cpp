@@ -39,8 +39,9 @@ namespace ledger {
             const std::shared_ptr<api::PathResolver> &resolver,
             const std::shared_ptr<spdlog::logger>& logger,
             const std::string &dbName,
-            const std::string &password
-        ) : _pool((size_t) backend->getConnectionPoolSize()), _backend(backend), _buffer("SQL", logger) {
+            const std::string &password,
+            int32_t readonlyConnections
+        ) : _pool((size_t) backend->getConnectionPoolSize()), _backend(backend), _readonlyPoolSize(0), _buffer("SQL", logger) {
             if (logger != nullptr && backend->isLoggingEnabled()) {
                 _logger = new std::ostream(&_buffer);
             } else {
@@ -57,6 +58,18 @@ namespace ledger {
 
             // Migrate database
             performDatabaseMigration();
+
+            // Readers are opened once the schema is up to date
+            if (readonlyConnections > 0 && _backend->supportsReadonlySessions()) {
+                _readonlyPoolSize = (size_t) readonlyConnections;
+                _readonlyPool.reset(new soci::connection_pool(_readonlyPoolSize));
+                for (size_t i = 0; i < _readonlyPoolSize; i++) {
+                    auto& session = _readonlyPool->at(i);
+                    _backend->initReadonly(resolver, dbName, password, session);
+                    if (_logger != nullptr)
+                        session.set_log_stream(_logger);
+                }
+            }
         }
 
         DatabaseSessionPool::~DatabaseSessionPool() {
@@ -69,10 +82,11 @@ namespace ledger {
                                             const std::shared_ptr<api::PathResolver> &resolver,
                                             const std::shared_ptr<spdlog::logger> &logger,
                                             const std::string &dbName,
-                                            const std::string &password) {
-            return FuturePtr<DatabaseSessionPool>::async(context, [backend, resolver, dbName, logger, password] () {
+                                            const std::string &password,
+                                            int32_t readonlyConnections) {
+            return FuturePtr<DatabaseSessionPool>::async(context, [backend, resolver, dbName, logger, password, readonlyConnections] () {
                 auto pool = std::shared_ptr<DatabaseSessionPool>(new DatabaseSessionPool(
-                    backend, resolver, logger, dbName, password
+                    backend, resolver, logger, dbName, password, readonlyConnections
                 ));
 
                 return pool;
@@ -83,6 +97,10 @@ namespace ledger {
             return _pool;
         }
 
+        soci::connection_pool &DatabaseSessionPool::getReadonlyPool() {
+            return _readonlyPool ? *_readonlyPool : _pool;
+        }
+
         void DatabaseSessionPool::performDatabaseMigration() {
             soci::session sql(getPool());
             int version = getDatabaseMigrationVersion(sql);
@@ -103,10 +121,27 @@ namespace ledger {
 
         void DatabaseSessionPool::performChangePassword(const std::string &oldPassword,
                                                         const std::string &newPassword) {
+            // Re-keying rewrites the whole database: do it once, through the first session, then
+            // reopen the other sessions of the pool with the new password. Readers are closed first since the
+            // backend may need exclusive access to the database file while re-keying it.
+            if (_readonlyPool) {
+                for (size_t i = 0; i < _readonlyPoolSize; i++) {
+                    _readonlyPool->at(i).close();
+                }
+            }
             auto poolSize = _backend->getConnectionPoolSize();
             for (size_t i = 0; i < poolSize; i++) {
                 auto& session = getPool().at(i);
-                _backend->changePassword(oldPassword, newPassword, session);
+                if (i == 0) {
+                    _backend->changePassword(oldPassword, newPassword, session);
+                } else {
+                    _backend->setPassword(newPassword, session);
+                }
+            }
+            if (_readonlyPool) {
+                for (size_t i = 0; i < _readonlyPoolSize; i++) {
+                    _backend->setReadonlyPassword(newPassword, _readonlyPool->at(i));
+                }
             }
         }
     }
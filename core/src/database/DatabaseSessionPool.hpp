@@ -46,8 +46,14 @@ namespace ledger {
                                 const std::shared_ptr<api::PathResolver> &resolver,
                                 const std::shared_ptr<spdlog::logger> &logger,
                                 const std::string &dbName,
-                                const std::string &password);
+                                const std::string &password,
+                                int32_t readonlyConnections = 0);
             soci::connection_pool& getPool();
+            /**
+             * Sessions which can only read from the database. Use them for queries which never write, so that
+             * they don't wait behind the writer. Falls back to getPool() when the backend has no read-only session.
+             */
+            soci::connection_pool& getReadonlyPool();
             ~DatabaseSessionPool();
 
             static FuturePtr<DatabaseSessionPool> getSessionPool(
@@ -56,10 +62,11 @@ namespace ledger {
                 const std::shared_ptr<api::PathResolver> &resolver,
                 const std::shared_ptr<spdlog::logger> &logger,
                 const std::string &dbName,
-                const std::string &password = ""
+                const std::string &password = "",
+                int32_t readonlyConnections = 0
             );
 
-            static const int CURRENT_DATABASE_SCHEME_VERSION = 10;
+            static const int CURRENT_DATABASE_SCHEME_VERSION = 14;
 
             void performDatabaseMigration();
             void performDatabaseRollback();
@@ -69,6 +76,8 @@ namespace ledger {
         private:
             std::shared_ptr<DatabaseBackend> _backend;
             soci::connection_pool _pool;
+            std::unique_ptr<soci::connection_pool> _readonlyPool;
+            size_t _readonlyPoolSize;
             std::ostream* _logger;
             LoggerStreamBuffer _buffer;
         };
@@ -0,0 +1,74 @@
+/*
+ *
+ * PostgreSQLBackend
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "PostgreSQLBackend.hpp"
+#include <utils/Exception.hpp>
+
+namespace ledger {
+    namespace core {
+        PostgreSQLBackend::PostgreSQLBackend(int32_t connectionPoolSize) : DatabaseBackend(),
+                                                                         _connectionPoolSize(connectionPoolSize) {
+            if (connectionPoolSize <= 0) {
+                throw make_exception(api::ErrorCode::ILLEGAL_ARGUMENT, "PostgreSQL connection pool size must be positive, got {}.", connectionPoolSize);
+            }
+        }
+
+        int32_t PostgreSQLBackend::getConnectionPoolSize() {
+            return _connectionPoolSize;
+        }
+
+        void PostgreSQLBackend::init(const std::shared_ptr<ledger::core::api::PathResolver> &resolver,
+                                     const std::string &dbName,
+                                     const std::string &password,
+                                     soci::session &session) {
+            _dbConnectionString = dbName;
+            setPassword(password, session);
+        }
+
+        void PostgreSQLBackend::setPassword(const std::string &password,
+                                            soci::session &session) {
+            // Encryption at rest is left to the server, the pool password only encrypts SQLite databases
+            if (!password.empty()) {
+                throw make_exception(api::ErrorCode::UNSUPPORTED_OPERATION, "PostgreSQL databases cannot be encrypted with a pool password.");
+            }
+            if (_dbConnectionString.empty()) {
+                throw make_exception(api::ErrorCode::DATABASE_EXCEPTION, "Database should be initiated before setting password.");
+            }
+            session.close();
+            session.open(*soci::factory_postgresql(), _dbConnectionString);
+        }
+
+        void PostgreSQLBackend::changePassword(const std::string & oldPassword,
+                                               const std::string & newPassword,
+                                               soci::session &session) {
+            setPassword(newPassword, session);
+        }
+    }
+}
@@ -48,11 +48,33 @@ namespace ledger {
                                   soci::session &session) {
             _dbResolvedPath = resolver->resolveDatabasePath(dbName);
             setPassword(password, session);
-            session << "PRAGMA foreign_keys = ON";
         }
 
         void SQLite3Backend::setPassword(const std::string &password,
                                          soci::session &session) {
+            open(password, session);
+            setupSession(session, false);
+        }
+
+        bool SQLite3Backend::supportsReadonlySessions() {
+            return true;
+        }
+
+        void SQLite3Backend::initReadonly(const std::shared_ptr<ledger::core::api::PathResolver> &resolver,
+                                          const std::string &dbName,
+                                          const std::string &password,
+                                          soci::session &session) {
+            _dbResolvedPath = resolver->resolveDatabasePath(dbName);
+            setReadonlyPassword(password, session);
+        }
+
+        void SQLite3Backend::setReadonlyPassword(const std::string &password,
+                                                 soci::session &session) {
+            open(password, session);
+            setupSession(session, true);
+        }
+
+        void SQLite3Backend::open(const std::string &password, soci::session &session) {
             if (_dbResolvedPath.empty()) {
                 throw make_exception(api::ErrorCode::DATABASE_EXCEPTION, "Database should be initiated before setting password.");
             }
@@ -61,6 +83,19 @@ namespace ledger {
             session.open(*soci::factory_sqlite3(), parameters);
         }
 
+        void SQLite3Backend::setupSession(soci::session &session, bool readonly) {
+            if (readonly) {
+                // Readers share the database with the writer, make sure they never write
+                session << "PRAGMA query_only = ON";
+                return;
+            }
+            // In WAL mode, readers don't wait for the writer to commit (and the other way around). The mode
+            // is persisted in the database file so it is already set when read-only sessions are opened.
+            std::string journalMode;
+            session << "PRAGMA journal_mode = WAL", soci::into(journalMode);
+            session << "PRAGMA foreign_keys = ON";
+        }
+
         void SQLite3Backend::changePassword(const std::string & oldPassword,
                                             const std::string & newPassword,
                                             soci::session &session) {
@@ -77,8 +112,12 @@ namespace ledger {
                 db_params += "disable_encryption=\"true\" ";
             }
 
+            // Re-keying copies the database file, get back to a rollback journal so that no WAL file is left behind
+            std::string journalMode;
+            session << "PRAGMA journal_mode = DELETE", soci::into(journalMode);
             session.close();
             session.open(*soci::factory_sqlite3(), db_params);
+            setupSession(session, false);
         }
     }
 }
@@ -54,7 +54,20 @@ namespace ledger {
                              const std::string & newPassword,
                              soci::session &session) override;
 
+         bool supportsReadonlySessions() override;
+
+         void initReadonly(const std::shared_ptr<api::PathResolver> &resolver,
+                           const std::string &dbName,
+                           const std::string &password,
+                           soci::session &session) override;
+
+         void setReadonlyPassword(const std::string &password,
+                                  soci::session &session) override;
+
      private:
+         void open(const std::string &password, soci::session &session);
+         void setupSession(soci::session &session, bool readonly);
+
          // Resolved path to db
          std::string _dbResolvedPath;
      };
@@ -0,0 +1,92 @@
+/*
+ *
+ * Upsert.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "Upsert.hpp"
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace ledger {
+    namespace core {
+        namespace {
+            // ON CONFLICT clauses appeared in SQLite 3.24.0
+            const int UPSERT_SQLITE_MAJOR_VERSION = 3;
+            const int UPSERT_SQLITE_MINOR_VERSION = 24;
+
+            bool isSQLiteVersionSupportingUpsert(soci::session& sql) {
+                std::string version;
+                try {
+                    sql << "SELECT sqlite_version()", soci::into(version);
+                } catch (const std::exception&) {
+                    return false;
+                }
+                int major = 0;
+                int minor = 0;
+                char separator;
+                std::istringstream is(version);
+                is >> major >> separator >> minor;
+                return major > UPSERT_SQLITE_MAJOR_VERSION ||
+                       (major == UPSERT_SQLITE_MAJOR_VERSION && minor >= UPSERT_SQLITE_MINOR_VERSION);
+            }
+        }
+
+        bool supportsUpsert(soci::session& sql) {
+            static std::mutex lock;
+            static std::unordered_map<std::string, bool> supportByBackend;
+
+            auto backend = sql.get_backend_name();
+            std::lock_guard<std::mutex> guard(lock);
+            auto it = supportByBackend.find(backend);
+            if (it == supportByBackend.end()) {
+                // SQLite is linked in (or provided by the host for the proxy backend): its version doesn't change
+                auto supported = backend == "postgresql" || isSQLiteVersionSupportingUpsert(sql);
+                it = supportByBackend.emplace(backend, supported).first;
+            }
+            return it->second;
+        }
+
+        std::string insertOrIgnore(soci::session& sql,
+                                   const std::string& table,
+                                   const std::string& values,
+                                   const std::string& conflictTarget) {
+            std::stringstream query;
+            if (supportsUpsert(sql)) {
+                query << "INSERT INTO " << table << " " << values << " ON CONFLICT";
+                if (!conflictTarget.empty()) {
+                    query << "(" << conflictTarget << ")";
+                }
+                query << " DO NOTHING";
+            } else {
+                query << "INSERT OR IGNORE INTO " << table << " " << values;
+            }
+            return query.str();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/*
+ *
+ * Upsert.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_UPSERT_HPP
+#define LEDGER_CORE_UPSERT_HPP
+
+#include <soci.h>
+#include <string>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Whether the database accepts "INSERT ... ON CONFLICT" clauses: PostgreSQL, and SQLite from 3.24. SQLite
+         * engines given through the proxy backend can be older (Android before API 30 ships SQLite 3.22). The answer
+         * is computed once per backend.
+         */
+        bool supportsUpsert(soci::session& sql);
+
+        /**
+         * Build a "INSERT INTO <table> <values>" statement skipping rows that conflict with an existing one on
+         * conflictTarget (any unique constraint if empty), with ON CONFLICT DO NOTHING when the database supports it
+         * and INSERT OR IGNORE otherwise. The number of inserted rows tells whether rows already existed.
+         */
+        std::string insertOrIgnore(soci::session& sql,
+                                   const std::string& table,
+                                   const std::string& values,
+                                   const std::string& conflictTarget = "");
+    }
+}
+
+#endif //LEDGER_CORE_UPSERT_HPP
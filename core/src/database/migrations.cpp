@@ -30,9 +30,19 @@
  */
 
 #include "migrations.hpp"
+#include <collections/strings.hpp>
+#include <bytes/serialization.hpp>
+#include <wallet/common/TrustIndicator.h>
+#include "soci-number.h"
+#include "soci-option.h"
+#include <unordered_set>
 
 namespace ledger {
     namespace core {
+        bool isPostgreSQLSession(soci::session& sql) {
+            return sql.get_backend_name() == "postgresql";
+        }
+
         int getDatabaseMigrationVersion(soci::session& sql) {
             int version = -1;
 
@@ -461,6 +471,12 @@ namespace ledger {
             // Since ALTER TABLE for changing data is non standard we have no choice but create a swap table, migrate all data from the legacy table to the swap and
             // then remove the legacy table and rename the swap table to the final table name. We are doing this to change input_data for ET and ERC txs data type from
             // VARCHAR(255) to TEXT since nothings prevents those fields to be bigger than 255 characters long.
+            // PostgreSQL supports it (and would refuse to drop ethereum_transactions, still referenced by ethereum_operations).
+            if (isPostgreSQLSession(sql)) {
+                sql << "ALTER TABLE ethereum_transactions ALTER COLUMN input_data TYPE TEXT";
+                sql << "ALTER TABLE erc20_operations ALTER COLUMN input_data TYPE TEXT";
+                return;
+            }
 
              // ETH transactions
             sql << "CREATE TABLE eth_swap("
@@ -513,6 +529,12 @@ namespace ledger {
         }
 
         template <> void rollback<9>(soci::session& sql) {
+            if (isPostgreSQLSession(sql)) {
+                sql << "ALTER TABLE ethereum_transactions ALTER COLUMN input_data TYPE VARCHAR(255)";
+                sql << "ALTER TABLE erc20_operations ALTER COLUMN input_data TYPE VARCHAR(255)";
+                return;
+            }
+
              // ETH transactions
             sql << "CREATE TABLE eth_swap("
                 "transaction_uid VARCHAR(255) PRIMARY KEY NOT NULL,"
@@ -569,6 +591,116 @@ namespace ledger {
 
         template <> void rollback<10>(soci::session& sql) {
             // not supported in standard ways by SQLite :(
+            if (isPostgreSQLSession(sql)) {
+                sql << "ALTER TABLE erc20_operations DROP COLUMN block_height";
+            }
+        }
+
+        template <> void migrate<11>(soci::session& sql) {
+            sql << "CREATE INDEX operations_account_date_index ON operations(account_uid, date, uid)";
+        }
+
+        template <> void rollback<11>(soci::session& sql) {
+            sql << "DROP INDEX operations_account_date_index";
+        }
+
+        template <> void migrate<12>(soci::session& sql) {
+            sql << "CREATE TABLE operation_addresses("
+                "operation_uid VARCHAR(255) NOT NULL REFERENCES operations(uid) ON DELETE CASCADE,"
+                "address VARCHAR(255) NOT NULL,"
+                "role VARCHAR(255) NOT NULL"
+            ")";
+            sql << "CREATE INDEX operation_addresses_address_index ON operation_addresses(address, role)";
+            sql << "CREATE INDEX operation_addresses_operation_index ON operation_addresses(operation_uid)";
+
+            // Backfill from the comma separated senders and recipients columns
+            soci::rowset<soci::row> rows = (sql.prepare << "SELECT uid, senders, recipients FROM operations");
+            std::vector<std::tuple<std::string, std::string, std::string>> addresses;
+            for (auto& row : rows) {
+                auto uid = row.get<std::string>(0);
+                auto collect = [&] (const std::string& joined, const std::string& role) {
+                    std::unordered_set<std::string> seen;
+                    for (auto& address : strings::split(joined, ",")) {
+                        if (!address.empty() && seen.insert(address).second) {
+                            addresses.emplace_back(uid, address, role);
+                        }
+                    }
+                };
+                collect(row.get<std::string>(1), "SENDER");
+                collect(row.get<std::string>(2), "RECIPIENT");
+            }
+            for (auto& address : addresses) {
+                sql << "INSERT INTO operation_addresses VALUES(:uid, :address, :role)",
+                    soci::use(std::get<0>(address)), soci::use(std::get<1>(address)), soci::use(std::get<2>(address));
+            }
+        }
+
+        template <> void rollback<12>(soci::session& sql) {
+            sql << "DROP TABLE operation_addresses";
+        }
+
+        template <> void migrate<13>(soci::session& sql) {
+            sql << "ALTER TABLE operations ADD COLUMN trust_level VARCHAR(255)";
+            sql << "ALTER TABLE operations ADD COLUMN sortable_amount VARCHAR(64)";
+            sql << "ALTER TABLE operations ADD COLUMN sortable_fees VARCHAR(64)";
+
+            // Backfill from the serialized trust indicator and the hex amounts
+            soci::rowset<soci::row> rows = (sql.prepare << "SELECT uid, amount, fees, trust FROM operations");
+            std::vector<std::tuple<std::string, std::string, std::string, std::string>> values;
+            for (auto& row : rows) {
+                auto fees = row.get_indicator(2) == soci::i_null ? BigInt::ZERO : BigInt::fromHex(row.get<std::string>(2));
+                std::string trustLevel;
+                if (row.get_indicator(3) != soci::i_null) {
+                    TrustIndicator trust;
+                    serialization::loadBase64<TrustIndicator>(row.get<std::string>(3), trust);
+                    trustLevel = api::to_string(trust.getTrustLevel());
+                }
+                values.emplace_back(
+                    row.get<std::string>(0),
+                    trustLevel,
+                    soci_number::toSortableHex(BigInt::fromHex(row.get<std::string>(1))),
+                    soci_number::toSortableHex(fees)
+                );
+            }
+            for (auto& value : values) {
+                auto trustLevel = std::get<1>(value).empty() ? Option<std::string>() : Option<std::string>(std::get<1>(value));
+                sql << "UPDATE operations SET trust_level = :trust_level, sortable_amount = :amount, sortable_fees = :fees "
+                       "WHERE uid = :uid",
+                    soci::use(trustLevel), soci::use(std::get<2>(value)), soci::use(std::get<3>(value)),
+                    soci::use(std::get<0>(value));
+            }
+
+            sql << "CREATE INDEX operations_trust_amount_index ON operations(account_uid, trust_level, sortable_amount)";
+            sql << "CREATE INDEX operations_amount_index ON operations(account_uid, sortable_amount)";
+        }
+
+        template <> void rollback<13>(soci::session& sql) {
+            sql << "DROP INDEX operations_amount_index";
+            sql << "DROP INDEX operations_trust_amount_index";
+            // dropping columns is not supported in standard ways by SQLite :(
+            if (isPostgreSQLSession(sql)) {
+                sql << "ALTER TABLE operations DROP COLUMN sortable_fees";
+                sql << "ALTER TABLE operations DROP COLUMN sortable_amount";
+                sql << "ALTER TABLE operations DROP COLUMN trust_level";
+            }
+        }
+
+        template <> void migrate<14>(soci::session& sql) {
+            sql << "CREATE TABLE bitcoin_account_outputs("
+                "account_uid VARCHAR(255) NOT NULL REFERENCES accounts(uid) ON DELETE CASCADE,"
+                "transaction_uid VARCHAR(255) NOT NULL,"
+                "idx INTEGER NOT NULL,"
+                "PRIMARY KEY (account_uid, transaction_uid, idx),"
+                "FOREIGN KEY (idx, transaction_uid) REFERENCES bitcoin_outputs(idx, transaction_uid) ON DELETE CASCADE"
+            ")";
+            // bitcoin_outputs.account_uid is no longer written, ownership now lives in the link table
+            sql << "INSERT INTO bitcoin_account_outputs "
+                   "SELECT account_uid, transaction_uid, idx FROM bitcoin_outputs "
+                   "WHERE account_uid IN (SELECT uid FROM accounts)";
+        }
+
+        template <> void rollback<14>(soci::session& sql) {
+            sql << "DROP TABLE bitcoin_account_outputs";
         }
     }
 }
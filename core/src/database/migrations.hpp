@@ -38,6 +38,10 @@
 
 namespace ledger {
     namespace core {
+        /// Whether the session is connected to PostgreSQL, for the few statements that can't be written the same way on
+        /// both engines.
+        bool isPostgreSQLSession(soci::session& sql);
+
         /// Get the current database migration version.
         int getDatabaseMigrationVersion(soci::session& sql);
 
@@ -137,6 +141,22 @@ namespace ledger {
         // Add block_height column to erc20_operations table
         template <> void migrate<10>(soci::session& sql);
         template <> void rollback<10>(soci::session& sql);
+
+        // Index operations by account and date to serve cursor paginated operation queries
+        template <> void migrate<11>(soci::session& sql);
+        template <> void rollback<11>(soci::session& sql);
+
+        // Normalize operation senders and recipients into an indexed operation_addresses table
+        template <> void migrate<12>(soci::session& sql);
+        template <> void rollback<12>(soci::session& sql);
+
+        // Add trust level and fixed width amount columns so trust and amount filters can use indexes
+        template <> void migrate<13>(soci::session& sql);
+        template <> void rollback<13>(soci::session& sql);
+
+        // Link accounts to the bitcoin outputs they own, so that transactions can be shared between accounts
+        template <> void migrate<14>(soci::session& sql);
+        template <> void rollback<14>(soci::session& sql);
     }
 }
 
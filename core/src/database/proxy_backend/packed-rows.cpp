@@ -0,0 +1,103 @@
+/*
+ *
+ * packed-rows.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "soci-proxy.h"
+
+using namespace soci;
+using namespace ledger::core;
+
+proxy_packed_rows::proxy_packed_rows(api::DatabaseResultBatch &&batch) : _batch(std::move(batch)) {
+    if (_batch.rowCount < 0 || _batch.columnCount < 0) {
+        throw soci_error("Malformed database result batch");
+    }
+    auto cells = static_cast<std::size_t>(_batch.rowCount) * static_cast<std::size_t>(_batch.columnCount);
+    if (_batch.nulls.size() != cells || _batch.offsets.size() != (cells + 1) * sizeof(uint32_t)) {
+        throw soci_error("Malformed database result batch");
+    }
+    uint32_t previous = 0;
+    for (std::size_t index = 0; index <= cells; index++) {
+        auto current = offset(index);
+        if (current < previous || current > _batch.values.size()) {
+            throw soci_error("Malformed database result batch");
+        }
+        previous = current;
+    }
+}
+
+bool proxy_packed_rows::is_null(int row, int column) const {
+    return _batch.nulls[cell(row, column)] != 0;
+}
+
+std::string proxy_packed_rows::get_string(int row, int column) const {
+    auto index = cell(row, column);
+    auto begin = _batch.values.begin() + offset(index);
+    auto end = _batch.values.begin() + offset(index + 1);
+    return std::string(begin, end);
+}
+
+long long proxy_packed_rows::get_long(int row, int column) const {
+    try {
+        return std::stoll(get_string(row, column));
+    } catch (const std::exception&) {
+        throw soci_error("Cannot read a number from database result batch");
+    }
+}
+
+unsigned long long proxy_packed_rows::get_unsigned_long(int row, int column) const {
+    try {
+        return std::stoull(get_string(row, column));
+    } catch (const std::exception&) {
+        throw soci_error("Cannot read a number from database result batch");
+    }
+}
+
+double proxy_packed_rows::get_double(int row, int column) const {
+    try {
+        return std::stod(get_string(row, column));
+    } catch (const std::exception&) {
+        throw soci_error("Cannot read a number from database result batch");
+    }
+}
+
+std::size_t proxy_packed_rows::cell(int row, int column) const {
+    if (row < 0 || row >= _batch.rowCount || column < 0 || column >= _batch.columnCount) {
+        throw soci_error("Out of bounds access in database result batch");
+    }
+    return static_cast<std::size_t>(row) * _batch.columnCount + column;
+}
+
+uint32_t proxy_packed_rows::offset(std::size_t index) const {
+    const auto bytes = _batch.offsets.data() + index * sizeof(uint32_t);
+    return static_cast<uint32_t>(bytes[0]) |
+           static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+}
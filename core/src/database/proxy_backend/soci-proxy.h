@@ -48,6 +48,7 @@
 #include <api/DatabaseValueType.hpp>
 #include <api/DatabaseColumn.hpp>
 #include <api/DatabaseResultRow.hpp>
+#include <api/DatabaseResultBatch.hpp>
 
 #include <cstddef>
 #include <string>
@@ -75,6 +76,34 @@ namespace soci
 
     struct proxy_statement_backend;
 
+    /**
+     * Maximum number of rows requested to the DatabaseEngine each time a single row fetch runs out of packed rows.
+     */
+    static const int PROXY_FETCH_BATCH_SIZE = 64;
+
+    /**
+     * Read only view over a batch of rows packed by the DatabaseEngine (see api::DatabaseResultBatch).
+     */
+    struct proxy_packed_rows
+    {
+        explicit proxy_packed_rows(ledger::core::api::DatabaseResultBatch&& batch);
+
+        int rows() const { return _batch.rowCount; }
+        int columns() const { return _batch.columnCount; }
+
+        bool is_null(int row, int column) const;
+        std::string get_string(int row, int column) const;
+        long long get_long(int row, int column) const;
+        unsigned long long get_unsigned_long(int row, int column) const;
+        double get_double(int row, int column) const;
+
+    private:
+        std::size_t cell(int row, int column) const;
+        uint32_t offset(std::size_t index) const;
+
+        ledger::core::api::DatabaseResultBatch _batch;
+    };
+
     struct SOCI_PROXY_DECL proxy_standard_into_type_backend : details::standard_into_type_backend
     {
         proxy_standard_into_type_backend(proxy_statement_backend &st)
@@ -94,6 +123,28 @@ namespace soci
         details::exchange_type  _type;
     };
 
+    struct SOCI_PROXY_DECL proxy_vector_into_type_backend : details::vector_into_type_backend
+    {
+        proxy_vector_into_type_backend(proxy_statement_backend &st)
+                : _statement(st)
+        {}
+
+        void define_by_pos(int& position, void* data, details::exchange_type type) SOCI_OVERRIDE;
+
+        void pre_fetch() SOCI_OVERRIDE;
+        void post_fetch(bool gotData, indicator* ind) SOCI_OVERRIDE;
+
+        void resize(std::size_t sz) SOCI_OVERRIDE;
+        std::size_t size() SOCI_OVERRIDE;
+
+        void clean_up() SOCI_OVERRIDE;
+
+        proxy_statement_backend& _statement;
+        void* _data;
+        int _position;
+        details::exchange_type  _type;
+    };
+
     struct SOCI_PROXY_DECL proxy_standard_use_type_backend : details::standard_use_type_backend
     {
         proxy_standard_use_type_backend(proxy_statement_backend &st)
@@ -140,7 +191,7 @@ namespace soci
 
         proxy_standard_into_type_backend* make_into_type_backend() SOCI_OVERRIDE;
         proxy_standard_use_type_backend* make_use_type_backend() SOCI_OVERRIDE;
-        details::vector_into_type_backend* make_vector_into_type_backend() SOCI_OVERRIDE;
+        proxy_vector_into_type_backend* make_vector_into_type_backend() SOCI_OVERRIDE;
         details::vector_use_type_backend* make_vector_use_type_backend() SOCI_OVERRIDE;
 
         bool reset_if_necessary();
@@ -149,6 +200,16 @@ namespace soci
         std::shared_ptr<ledger::core::api::DatabaseStatement> _stmt;
         std::shared_ptr<ledger::core::api::DatabaseResultSet> _results;
         std::shared_ptr<ledger::core::api::DatabaseResultRow> _lastRow;
+        // Rows fetched through DatabaseResultSet::nextBatch, _packedRow is the current row for single row fetches
+        std::shared_ptr<proxy_packed_rows> _packed;
+        int _packedRow {0};
+        // Number of rows read by the last batch fetch, -1 when rows are fetched one by one
+        int _fetchedRows {-1};
+        // Update count of the last execution, kept apart from _results which fetches release
+        long long _affectedRows {0};
+        // Cleared as soon as the engine returns no batch, blobs are always read row by row through DatabaseResultRow
+        bool _batchesSupported {true};
+        bool _hasBlobInto {false};
     };
 
     struct proxy_rowid_backend : details::rowid_backend
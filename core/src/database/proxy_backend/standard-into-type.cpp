@@ -41,11 +41,14 @@ using namespace ledger::core;
      make_try<type>([&, this] () { \
         return _statement._lastRow->get##Type##ByPos(index); \
      }).getOrThrowException<soci_error>()
+#define PACKED(Getter, type) static_cast<type>(packed->get_##Getter(row, index))
 
 void proxy_standard_into_type_backend::define_by_pos(int &position, void *data, details::exchange_type type) {
     _position = position++;
     _data = data;
     _type = type;
+    if (type == details::x_blob)
+        _statement._hasBlobInto = true;
 }
 
 void proxy_standard_into_type_backend::pre_fetch() {
@@ -57,8 +60,11 @@ void proxy_standard_into_type_backend::post_fetch(bool gotData, bool calledFromF
     if (gotData == false && calledFromFetch == true) return ;
 
     auto index = _position - 1;
+    // Rows coming from a batch are read from the packed buffers, otherwise from the last row of the result set
+    const auto packed = _statement._packed;
+    const auto row = _statement._packedRow;
 
-    if (_statement._lastRow->isNullAtPos(index)) {
+    if (packed ? packed->is_null(row, index) : _statement._lastRow->isNullAtPos(index)) {
 
         *ind = i_null;
         return ;
@@ -69,27 +75,27 @@ void proxy_standard_into_type_backend::post_fetch(bool gotData, bool calledFromF
     switch (_type) {
         case details::x_char: throw soci_error("Unsupported type char in select statement");
         case details::x_stdstring: {
-            OUT(std::string)->assign(GET(String, std::string));
+            OUT(std::string)->assign(packed ? packed->get_string(row, index) : GET(String, std::string));
             break;
         }
         case details::x_short: {
-            *OUT(short) = GET(Short, short);
+            *OUT(short) = packed ? PACKED(long, short) : GET(Short, short);
             break;
         }
         case details::x_integer: {
-            *OUT(int32_t) = GET(Int, int32_t);
+            *OUT(int32_t) = packed ? PACKED(long, int32_t) : GET(Int, int32_t);
             break;
         }
         case details::x_long_long: {
-            *OUT(int64_t) = GET(Long, int64_t);
+            *OUT(int64_t) = packed ? PACKED(long, int64_t) : GET(Long, int64_t);
             break;
         }
         case details::x_unsigned_long_long: {
-            *OUT(uint64_t) = GET(Long, uint64_t);
+            *OUT(uint64_t) = packed ? PACKED(unsigned_long, uint64_t) : GET(Long, uint64_t);
             break;
         }
         case details::x_double: {
-            *OUT(double) = GET(Double, double);
+            *OUT(double) = packed ? PACKED(double, double) : GET(Double, double);
             break;
         }
         case details::x_stdtm: throw soci_error("Unsupported type timestamp in select statement");
@@ -57,12 +57,17 @@ void proxy_statement_backend::clean_up() {
         _results = nullptr;
     }
     SP_PRINT("CLEAN UP STATEMENT result done" << this)
+    _packed = nullptr;
+    _lastRow = nullptr;
+    _hasBlobInto = false;
     } catch (...) {
         // Ignore
     }
 }
 
 bool proxy_statement_backend::reset_if_necessary() {
+    _packed = nullptr;
+    _fetchedRows = -1;
     if (_results != nullptr) {
         _results->close();
         _results = nullptr;
@@ -89,6 +94,8 @@ details::statement_backend::exec_fetch_result proxy_statement_backend::execute(i
     return make_try<details::statement_backend::exec_fetch_result>([&, this] {
         reset_if_necessary();
         _results = _stmt->execute();
+        // Fetching drops _results once rows are exhausted, which is always the case for an INSERT
+        _affectedRows = _results->getUpdateCount();
         if (number == 0) {
             return _results->hasNext() ? ef_success : ef_no_data;
         }
@@ -108,11 +115,47 @@ details::statement_backend::exec_fetch_result proxy_statement_backend::fetch(int
 }
 
 details::statement_backend::exec_fetch_result proxy_statement_backend::batch_fetch(int number) {
-    throw soci_error("Batch operation are not supported by proxy backend");
+    SP_PRINT("FETCH BATCH " << number)
+    _packed = nullptr;
+    _packedRow = 0;
+    _fetchedRows = 0;
+    if (!_results)
+        return ef_no_data;
+    auto batch = make_try<std::experimental::optional<api::DatabaseResultBatch>>([&, this] () {
+        return _results->nextBatch(number);
+    }).getOrThrowException<soci_error>();
+    if (!batch)
+        throw soci_error("Batch operation are not supported by the database engine");
+    if (batch->rowCount > 0)
+        _packed = std::make_shared<proxy_packed_rows>(std::move(batch.value()));
+    _fetchedRows = _packed ? _packed->rows() : 0;
+    return _fetchedRows < number ? ef_no_data : ef_success;
 }
 
 details::statement_backend::exec_fetch_result proxy_statement_backend::single_row_fetch() {
     SP_PRINT("FETCH SINGLE")
+    if (_packed && _packedRow + 1 < _packed->rows()) {
+        _packedRow += 1;
+        return ef_success;
+    }
+    _packed = nullptr;
+    if (_results && _batchesSupported && !_hasBlobInto) {
+        auto batch = make_try<std::experimental::optional<api::DatabaseResultBatch>>([&, this] () {
+            return _results->nextBatch(PROXY_FETCH_BATCH_SIZE);
+        }).getOrThrowException<soci_error>();
+        if (batch) {
+            _lastRow = nullptr;
+            if (batch->rowCount == 0) {
+                _results = nullptr;
+                return ef_no_data;
+            }
+            _packed = std::make_shared<proxy_packed_rows>(std::move(batch.value()));
+            _packedRow = 0;
+            return ef_success;
+        }
+        // The engine cannot pack rows, don't ask again for this statement
+        _batchesSupported = false;
+    }
     if (_results && _results->hasNext())
         _results->next();
     else {
@@ -128,10 +171,12 @@ details::statement_backend::exec_fetch_result proxy_statement_backend::single_ro
 
 long long proxy_statement_backend::get_affected_rows() {
     SP_PRINT("GET AFFECTED ROWS")
-    return _results ? _results->getUpdateCount() : 0;
+    return _affectedRows;
 }
 
 int proxy_statement_backend::get_number_of_rows() {
+    if (_fetchedRows >= 0)
+        return _fetchedRows;
     SP_PRINT("GET NUMBER OF ROWS returns " << (_results ? _results->available() : 0))
     return _results ? _results->available() : 0;
 }
@@ -195,9 +240,9 @@ proxy_standard_use_type_backend *proxy_statement_backend::make_use_type_backend(
     return new proxy_standard_use_type_backend(*this);
 }
 
-details::vector_into_type_backend *proxy_statement_backend::make_vector_into_type_backend() {
+proxy_vector_into_type_backend *proxy_statement_backend::make_vector_into_type_backend() {
     SP_PRINT("MAKE VECTOR INTO TYPE BACKEND")
-    throw soci_error("Unsupported feature used, bulk operation on SOCI");
+    return new proxy_vector_into_type_backend(*this);
 }
 
 details::vector_use_type_backend *proxy_statement_backend::make_vector_use_type_backend() {
@@ -0,0 +1,133 @@
+/*
+ *
+ * vector-into-type.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "soci-proxy.h"
+#include <soci.h>
+#include <vector>
+
+using namespace soci;
+using namespace ledger::core;
+
+#define OUT(Type) (static_cast<std::vector<Type> *>(_data))
+
+namespace {
+    template <typename T, typename Getter>
+    void fill(std::vector<T>& out, const proxy_packed_rows& packed, int index, indicator* ind, Getter get) {
+        for (std::size_t row = 0; row < out.size(); row++) {
+            if (packed.is_null(static_cast<int>(row), index)) {
+                if (ind == nullptr)
+                    throw soci_error("Null value fetched and no indicator defined.");
+                ind[row] = i_null;
+                continue;
+            }
+            if (ind != nullptr)
+                ind[row] = i_ok;
+            out[row] = static_cast<T>(get(static_cast<int>(row)));
+        }
+    }
+}
+
+void proxy_vector_into_type_backend::define_by_pos(int &position, void *data, details::exchange_type type) {
+    switch (type) {
+        case details::x_stdstring:
+        case details::x_short:
+        case details::x_integer:
+        case details::x_long_long:
+        case details::x_unsigned_long_long:
+        case details::x_double:
+            break;
+        default: throw soci_error("Unsupported type in bulk select statement");
+    }
+    _position = position++;
+    _data = data;
+    _type = type;
+}
+
+void proxy_vector_into_type_backend::pre_fetch() {
+    // Nothing to prepare, rows are packed by the engine
+}
+
+void proxy_vector_into_type_backend::post_fetch(bool gotData, indicator *ind) {
+    SP_PRINT("VECTOR INTO POST FETCH " << _position << " " << _type);
+    if (!gotData || !_statement._packed) return ;
+
+    const auto& packed = *_statement._packed;
+    auto index = _position - 1;
+    switch (_type) {
+        case details::x_stdstring:
+            fill(*OUT(std::string), packed, index, ind, [&] (int row) { return packed.get_string(row, index); });
+            break;
+        case details::x_short:
+            fill(*OUT(short), packed, index, ind, [&] (int row) { return packed.get_long(row, index); });
+            break;
+        case details::x_integer:
+            fill(*OUT(int32_t), packed, index, ind, [&] (int row) { return packed.get_long(row, index); });
+            break;
+        case details::x_long_long:
+            fill(*OUT(int64_t), packed, index, ind, [&] (int row) { return packed.get_long(row, index); });
+            break;
+        case details::x_unsigned_long_long:
+            fill(*OUT(uint64_t), packed, index, ind, [&] (int row) { return packed.get_unsigned_long(row, index); });
+            break;
+        case details::x_double:
+            fill(*OUT(double), packed, index, ind, [&] (int row) { return packed.get_double(row, index); });
+            break;
+        default: throw soci_error("Unsupported type in bulk select statement");
+    }
+}
+
+void proxy_vector_into_type_backend::resize(std::size_t sz) {
+    switch (_type) {
+        case details::x_stdstring: OUT(std::string)->resize(sz); break;
+        case details::x_short: OUT(short)->resize(sz); break;
+        case details::x_integer: OUT(int32_t)->resize(sz); break;
+        case details::x_long_long: OUT(int64_t)->resize(sz); break;
+        case details::x_unsigned_long_long: OUT(uint64_t)->resize(sz); break;
+        case details::x_double: OUT(double)->resize(sz); break;
+        default: throw soci_error("Unsupported type in bulk select statement");
+    }
+}
+
+std::size_t proxy_vector_into_type_backend::size() {
+    switch (_type) {
+        case details::x_stdstring: return OUT(std::string)->size();
+        case details::x_short: return OUT(short)->size();
+        case details::x_integer: return OUT(int32_t)->size();
+        case details::x_long_long: return OUT(int64_t)->size();
+        case details::x_unsigned_long_long: return OUT(uint64_t)->size();
+        case details::x_double: return OUT(double)->size();
+        default: throw soci_error("Unsupported type in bulk select statement");
+    }
+}
+
+void proxy_vector_into_type_backend::clean_up() {
+    // Nothing to release
+}
@@ -57,5 +57,34 @@ namespace ledger {
                 getNext()->toString(ss);
             }
         }
+
+        void OperationAddressQueryFilter::toString(std::stringstream &ss) const {
+            ss << "o.uid IN (SELECT operation_uid FROM operation_addresses WHERE address = :address AND role = '"
+               << _role << "')";
+            if (!isTail()) {
+                switch (getOperatorForNextFilter()) {
+                    case QueryFilterOperator::OP_AND :
+                        ss << " AND ";
+                        break;
+                    case QueryFilterOperator::OP_AND_NOT :
+                        ss << " AND NOT ";
+                        break;
+                    case QueryFilterOperator::OP_OR :
+                        ss << " OR ";
+                        break;
+                    case QueryFilterOperator::OP_OR_NOT :
+                        ss << " OR NOT ";
+                        break;
+                }
+                getNext()->toString(ss);
+            }
+        }
+
+        void OperationAddressQueryFilter::bindValue(soci::details::prepare_temp_type &statement) const {
+            statement, soci::use(_address);
+            if (!isTail()) {
+                getNext()->bindValue(statement);
+            }
+        }
     }
 }
\ No newline at end of file
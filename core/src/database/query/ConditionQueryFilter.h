@@ -104,6 +104,21 @@ namespace ledger {
         private:
             std::string _condition;
         };
+
+        // Matches operations having the given address in the given role, through the indexed operation_addresses table
+        class OperationAddressQueryFilter : public QueryFilter {
+        public:
+            OperationAddressQueryFilter(const std::string& role, const std::string& address)
+                    : _role(role), _address(address) {};
+
+            void toString(std::stringstream &ss) const override;
+
+            void bindValue(soci::details::prepare_temp_type &statement) const override;
+
+        private:
+            std::string _role;
+            std::string _address;
+        };
     }
 }
 
@@ -48,7 +48,21 @@ namespace ledger {
             if (_filter) {
                 query << " WHERE ";
                 std::string sFilter = _filter->getHead()->toString();
-                query << sFilter;
+                if (_seek.nonEmpty()) {
+                    query << "(" << sFilter << ")";
+                } else {
+                    query << sFilter;
+                }
+            }
+
+            if (_seek.nonEmpty()) {
+                // (key, tieBreaker) > (v, t) written so that the first term can be used as an index range
+                auto& seek = _seek.getValue();
+                auto symbol = seek.descending ? "<" : ">";
+                query << (_filter ? " AND " : " WHERE ")
+                      << seek.key << (seek.descending ? " <= " : " >= ") << ":seek_key AND ("
+                      << seek.key << " " << symbol << " :seek_key_bound OR "
+                      << seek.tieBreaker << " " << symbol << " :seek_tie_breaker)";
             }
 
             if (_order.size() > 0) {
@@ -75,6 +89,10 @@ namespace ledger {
             if (_filter) {
                 _filter->getHead()->bindValue(statement);
             }
+            if (_seek.nonEmpty()) {
+                auto& seek = _seek.getValue();
+                statement, soci::use(seek.keyValue), soci::use(seek.keyBoundValue), soci::use(seek.tieBreakerValue);
+            }
             return statement;
         }
 
@@ -128,6 +146,12 @@ namespace ledger {
             return *this;
         }
 
+        QueryBuilder &QueryBuilder::seekAfter(const std::string &key, const std::string &tieBreaker, bool descending,
+                                              const std::string &keyValue, const std::string &tieBreakerValue) {
+            _seek = Seek {key, tieBreaker, descending, keyValue, keyValue, tieBreakerValue};
+            return *this;
+        }
+
         QueryBuilder& QueryBuilder::outerJoin(const std::string &table, const std::string &condition) {
             _outerJoins.emplace_back(Option<LeftOuterJoin>(std::make_tuple(table, condition)));
             return *this;
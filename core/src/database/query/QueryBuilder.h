@@ -55,11 +55,28 @@ namespace ledger {
             QueryBuilder& order(std::string&& keys, bool&& descending);
             QueryBuilder& limit(int32_t limit);
             QueryBuilder& offset(int32_t offset);
+            /**
+             * Restricts the results to the rows coming strictly after (keyValue, tieBreakerValue) when ordered by
+             * (key, tieBreaker), in ascending or descending order (keyset pagination). The query must be ordered
+             * by key then tieBreaker in the same direction.
+             */
+            QueryBuilder& seekAfter(const std::string& key, const std::string& tieBreaker, bool descending,
+                                    const std::string& keyValue, const std::string& tieBreakerValue);
             soci::details::prepare_temp_type execute(soci::session& sql);
 
         private:
             using LeftOuterJoin = std::tuple<std::string, std::string>;
 
+            struct Seek {
+                std::string key;
+                std::string tieBreaker;
+                bool descending;
+                std::string keyValue;
+                // Bound twice, the key is compared twice
+                std::string keyBoundValue;
+                std::string tieBreakerValue;
+            };
+
             std::string _keys;
             std::string _table;
             std::string _output;
@@ -68,6 +85,7 @@ namespace ledger {
             std::shared_ptr<QueryFilter> _filter;
             Option<int32_t> _limit;
             Option<int32_t> _offset;
+            Option<Seek> _seek;
         };
     }
 }
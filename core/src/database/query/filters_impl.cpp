@@ -31,13 +31,20 @@
 
 #include "ConditionQueryFilter.h"
 #include <utils/DateUtils.hpp>
-#include <cereal/external/base64.hpp>
+#include <database/soci-number.h>
+#include <api/BigInt.hpp>
 #include <api/TrustLevel.hpp>
 #include <api/OperationType.hpp>
 
 namespace ledger {
     namespace core {
 
+        namespace {
+            std::string toSortableAmount(const std::shared_ptr<api::Amount> &amount) {
+                return soci_number::toSortableHex(BigInt::fromDecimal(amount->toBigInt()->toString(10)));
+            }
+        }
+
         std::shared_ptr<api::QueryFilter> api::QueryFilter::accountEq(const std::string &accountUid) {
             return std::make_shared<ConditionQueryFilter<std::string>>("account_uid", "=", accountUid, "o");
         }
@@ -71,23 +78,19 @@ namespace ledger {
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::trustEq(TrustLevel trust) {
-            auto string = api::to_string(trust);
-            auto base64 = cereal::base64::encode((const unsigned char *)string.data(), string.size());
-            return std::make_shared<ConditionQueryFilter<std::string>>("trust", "LIKE", fmt::format("%{}%", base64), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("trust_level", "=", api::to_string(trust), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::trustNeq(TrustLevel trust) {
-            auto string = api::to_string(trust);
-            auto base64 = cereal::base64::encode((const unsigned char *)string.data(), string.size());
-            return std::make_shared<ConditionQueryFilter<std::string>>("trust", "NOT LIKE", fmt::format("%{}%", base64), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("trust_level", "<>", api::to_string(trust), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::containsSender(const std::string &senderAddress) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("senders", "LIKE", fmt::format("%{}%", senderAddress), "o");
+            return std::make_shared<OperationAddressQueryFilter>("SENDER", senderAddress);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::containsRecipient(const std::string &recipientAddress) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("recipients", "LIKE", fmt::format("%{}%", recipientAddress), "o");
+            return std::make_shared<OperationAddressQueryFilter>("RECIPIENT", recipientAddress);
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::currencyEq(const std::string &currencyName) {
@@ -103,51 +106,51 @@ namespace ledger {
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<>", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<>", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", ">", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", ">=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<>", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<>", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", ">", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", ">=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<=", toSortableAmount(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::blockHeightEq(int64_t blockHeight) {
@@ -35,6 +35,7 @@
 #include <boost/lexical_cast.hpp>
 #include <utils/Exception.hpp>
 #include <math/BigInt.h>
+#include <algorithm>
 
 namespace soci {
 
@@ -67,5 +68,28 @@ namespace soci {
 
 }
 
+namespace ledger {
+    namespace core {
+        namespace soci_number {
+            // Width of the zero padded hex strings used to store amounts, enough for 256-bit values
+            static const std::size_t SORTABLE_HEX_LENGTH = 64;
+
+            // Fixed width lowercase hex representation of a non negative number. Such strings compare like the
+            // numbers they represent, so amount range predicates stay sargable even for values that overflow BIGINT.
+            inline std::string toSortableHex(const BigInt& value) {
+                if (value.isNegative()) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Cannot store negative amount {}", value.toString());
+                }
+                auto hex = value.toHexString();
+                std::transform(hex.begin(), hex.end(), hex.begin(), ::tolower);
+                if (hex.size() < SORTABLE_HEX_LENGTH) {
+                    hex.insert(0, SORTABLE_HEX_LENGTH - hex.size(), '0');
+                }
+                return hex;
+            }
+        }
+    }
+}
+
 
 #endif //LEDGER_CORE_SOCI_NUMBER_H
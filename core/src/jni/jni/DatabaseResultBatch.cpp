@@ -0,0 +1,36 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from database.djinni
+
+#include "DatabaseResultBatch.hpp"  // my header
+#include "Marshal.hpp"
+
+namespace djinni_generated {
+
+DatabaseResultBatch::DatabaseResultBatch() = default;
+
+DatabaseResultBatch::~DatabaseResultBatch() = default;
+
+auto DatabaseResultBatch::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<DatabaseResultBatch>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.rowCount)),
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.columnCount)),
+                                                           ::djinni::get(::djinni::Binary::fromCpp(jniEnv, c.nulls)),
+                                                           ::djinni::get(::djinni::Binary::fromCpp(jniEnv, c.offsets)),
+                                                           ::djinni::get(::djinni::Binary::fromCpp(jniEnv, c.values)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto DatabaseResultBatch::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 6);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<DatabaseResultBatch>::get();
+    return {::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_rowCount)),
+            ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_columnCount)),
+            ::djinni::Binary::toCpp(jniEnv, (jbyteArray)jniEnv->GetObjectField(j, data.field_nulls)),
+            ::djinni::Binary::toCpp(jniEnv, (jbyteArray)jniEnv->GetObjectField(j, data.field_offsets)),
+            ::djinni::Binary::toCpp(jniEnv, (jbyteArray)jniEnv->GetObjectField(j, data.field_values))};
+}
+
+}  // namespace djinni_generated
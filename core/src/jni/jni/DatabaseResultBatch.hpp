@@ -0,0 +1,38 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from database.djinni
+
+#ifndef DJINNI_GENERATED_DATABASERESULTBATCH_HPP_JNI_
+#define DJINNI_GENERATED_DATABASERESULTBATCH_HPP_JNI_
+
+#include "../../api/DatabaseResultBatch.hpp"
+#include "djinni_support.hpp"
+
+namespace djinni_generated {
+
+class DatabaseResultBatch final {
+public:
+    using CppType = ::ledger::core::api::DatabaseResultBatch;
+    using JniType = jobject;
+
+    using Boxed = DatabaseResultBatch;
+
+    ~DatabaseResultBatch();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    DatabaseResultBatch();
+    friend ::djinni::JniClass<DatabaseResultBatch>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("co/ledger/core/DatabaseResultBatch") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(II[B[B[B)V") };
+    const jfieldID field_rowCount { ::djinni::jniGetFieldID(clazz.get(), "rowCount", "I") };
+    const jfieldID field_columnCount { ::djinni::jniGetFieldID(clazz.get(), "columnCount", "I") };
+    const jfieldID field_nulls { ::djinni::jniGetFieldID(clazz.get(), "nulls", "[B") };
+    const jfieldID field_offsets { ::djinni::jniGetFieldID(clazz.get(), "offsets", "[B") };
+    const jfieldID field_values { ::djinni::jniGetFieldID(clazz.get(), "values", "[B") };
+};
+
+}  // namespace djinni_generated
+#endif //DJINNI_GENERATED_DATABASERESULTBATCH_HPP_JNI_
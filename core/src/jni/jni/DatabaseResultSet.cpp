@@ -3,6 +3,7 @@
 
 #include "DatabaseResultSet.hpp"  // my header
 #include "DatabaseError.hpp"
+#include "DatabaseResultBatch.hpp"
 #include "DatabaseResultRow.hpp"
 #include "Marshal.hpp"
 
@@ -55,6 +56,15 @@ void DatabaseResultSet::JavaProxy::next() {
     jniEnv->CallVoidMethod(Handle::get().get(), data.method_next);
     ::djinni::jniExceptionCheck(jniEnv);
 }
+std::experimental::optional<::ledger::core::api::DatabaseResultBatch> DatabaseResultSet::JavaProxy::nextBatch(int32_t c_maxRows) {
+    auto jniEnv = ::djinni::jniGetThreadEnv();
+    ::djinni::JniLocalScope jscope(jniEnv, 10);
+    const auto& data = ::djinni::JniClass<::djinni_generated::DatabaseResultSet>::get();
+    auto jret = jniEnv->CallObjectMethod(Handle::get().get(), data.method_nextBatch,
+                                         ::djinni::get(::djinni::I32::fromCpp(jniEnv, c_maxRows)));
+    ::djinni::jniExceptionCheck(jniEnv);
+    return ::djinni::Optional<std::experimental::optional, ::djinni_generated::DatabaseResultBatch>::toCpp(jniEnv, jret);
+}
 void DatabaseResultSet::JavaProxy::close() {
     auto jniEnv = ::djinni::jniGetThreadEnv();
     ::djinni::JniLocalScope jscope(jniEnv, 10);
@@ -39,6 +39,7 @@ private:
         bool hasNext() override;
         int32_t available() override;
         void next() override;
+        std::experimental::optional<::ledger::core::api::DatabaseResultBatch> nextBatch(int32_t maxRows) override;
         void close() override;
         std::shared_ptr<::ledger::core::api::DatabaseError> getError() override;
 
@@ -52,6 +53,7 @@ private:
     const jmethodID method_hasNext { ::djinni::jniGetMethodID(clazz.get(), "hasNext", "()Z") };
     const jmethodID method_available { ::djinni::jniGetMethodID(clazz.get(), "available", "()I") };
     const jmethodID method_next { ::djinni::jniGetMethodID(clazz.get(), "next", "()V") };
+    const jmethodID method_nextBatch { ::djinni::jniGetMethodID(clazz.get(), "nextBatch", "(I)Lco/ledger/core/DatabaseResultBatch;") };
     const jmethodID method_close { ::djinni::jniGetMethodID(clazz.get(), "close", "()V") };
     const jmethodID method_getError { ::djinni::jniGetMethodID(clazz.get(), "getError", "()Lco/ledger/core/DatabaseError;") };
 };
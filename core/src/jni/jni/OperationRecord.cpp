@@ -0,0 +1,53 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#include "OperationRecord.hpp"  // my header
+#include "Marshal.hpp"
+#include "OperationType.hpp"
+#include "TrustLevel.hpp"
+#include "WalletType.hpp"
+
+namespace djinni_generated {
+
+OperationRecord::OperationRecord() = default;
+
+OperationRecord::~OperationRecord() = default;
+
+auto OperationRecord::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<OperationRecord>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c.uid)),
+                                                           ::djinni::get(::djinni::I32::fromCpp(jniEnv, c.accountIndex)),
+                                                           ::djinni::get(::djinni_generated::OperationType::fromCpp(jniEnv, c.operationType)),
+                                                           ::djinni::get(::djinni::Date::fromCpp(jniEnv, c.date)),
+                                                           ::djinni::get(::djinni::List<::djinni::String>::fromCpp(jniEnv, c.senders)),
+                                                           ::djinni::get(::djinni::List<::djinni::String>::fromCpp(jniEnv, c.recipients)),
+                                                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c.amount)),
+                                                           ::djinni::get(::djinni::Optional<std::experimental::optional, ::djinni::String>::fromCpp(jniEnv, c.fees)),
+                                                           ::djinni::get(::djinni::String::fromCpp(jniEnv, c.currencyName)),
+                                                           ::djinni::get(::djinni_generated::TrustLevel::fromCpp(jniEnv, c.trustLevel)),
+                                                           ::djinni::get(::djinni::Optional<std::experimental::optional, ::djinni::I64>::fromCpp(jniEnv, c.blockHeight)),
+                                                           ::djinni::get(::djinni_generated::WalletType::fromCpp(jniEnv, c.walletType)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto OperationRecord::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 13);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<OperationRecord>::get();
+    return {::djinni::String::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_uid)),
+            ::djinni::I32::toCpp(jniEnv, jniEnv->GetIntField(j, data.field_accountIndex)),
+            ::djinni_generated::OperationType::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_operationType)),
+            ::djinni::Date::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_date)),
+            ::djinni::List<::djinni::String>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_senders)),
+            ::djinni::List<::djinni::String>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_recipients)),
+            ::djinni::String::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_amount)),
+            ::djinni::Optional<std::experimental::optional, ::djinni::String>::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_fees)),
+            ::djinni::String::toCpp(jniEnv, (jstring)jniEnv->GetObjectField(j, data.field_currencyName)),
+            ::djinni_generated::TrustLevel::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_trustLevel)),
+            ::djinni::Optional<std::experimental::optional, ::djinni::I64>::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_blockHeight)),
+            ::djinni_generated::WalletType::toCpp(jniEnv, jniEnv->GetObjectField(j, data.field_walletType))};
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,45 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from wallet.djinni
+
+#ifndef DJINNI_GENERATED_OPERATIONRECORD_HPP_JNI_
+#define DJINNI_GENERATED_OPERATIONRECORD_HPP_JNI_
+
+#include "../../api/OperationRecord.hpp"
+#include "djinni_support.hpp"
+
+namespace djinni_generated {
+
+class OperationRecord final {
+public:
+    using CppType = ::ledger::core::api::OperationRecord;
+    using JniType = jobject;
+
+    using Boxed = OperationRecord;
+
+    ~OperationRecord();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    OperationRecord();
+    friend ::djinni::JniClass<OperationRecord>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("co/ledger/core/OperationRecord") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(Ljava/lang/String;ILco/ledger/core/OperationType;Ljava/util/Date;Ljava/util/ArrayList;Ljava/util/ArrayList;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Lco/ledger/core/TrustLevel;Ljava/lang/Long;Lco/ledger/core/WalletType;)V") };
+    const jfieldID field_uid { ::djinni::jniGetFieldID(clazz.get(), "uid", "Ljava/lang/String;") };
+    const jfieldID field_accountIndex { ::djinni::jniGetFieldID(clazz.get(), "accountIndex", "I") };
+    const jfieldID field_operationType { ::djinni::jniGetFieldID(clazz.get(), "operationType", "Lco/ledger/core/OperationType;") };
+    const jfieldID field_date { ::djinni::jniGetFieldID(clazz.get(), "date", "Ljava/util/Date;") };
+    const jfieldID field_senders { ::djinni::jniGetFieldID(clazz.get(), "senders", "Ljava/util/ArrayList;") };
+    const jfieldID field_recipients { ::djinni::jniGetFieldID(clazz.get(), "recipients", "Ljava/util/ArrayList;") };
+    const jfieldID field_amount { ::djinni::jniGetFieldID(clazz.get(), "amount", "Ljava/lang/String;") };
+    const jfieldID field_fees { ::djinni::jniGetFieldID(clazz.get(), "fees", "Ljava/lang/String;") };
+    const jfieldID field_currencyName { ::djinni::jniGetFieldID(clazz.get(), "currencyName", "Ljava/lang/String;") };
+    const jfieldID field_trustLevel { ::djinni::jniGetFieldID(clazz.get(), "trustLevel", "Lco/ledger/core/TrustLevel;") };
+    const jfieldID field_blockHeight { ::djinni::jniGetFieldID(clazz.get(), "blockHeight", "Ljava/lang/Long;") };
+    const jfieldID field_walletType { ::djinni::jniGetFieldID(clazz.get(), "walletType", "Lco/ledger/core/WalletType;") };
+};
+
+}  // namespace djinni_generated
+#endif //DJINNI_GENERATED_OPERATIONRECORD_HPP_JNI_
@@ -0,0 +1,29 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from callback.djinni
+
+#include "OperationRecordListCallback.hpp"  // my header
+#include "Error.hpp"
+#include "Marshal.hpp"
+#include "OperationRecord.hpp"
+
+namespace djinni_generated {
+
+OperationRecordListCallback::OperationRecordListCallback() : ::djinni::JniInterface<::ledger::core::api::OperationRecordListCallback, OperationRecordListCallback>() {}
+
+OperationRecordListCallback::~OperationRecordListCallback() = default;
+
+OperationRecordListCallback::JavaProxy::JavaProxy(JniType j) : Handle(::djinni::jniGetThreadEnv(), j) { }
+
+OperationRecordListCallback::JavaProxy::~JavaProxy() = default;
+
+void OperationRecordListCallback::JavaProxy::onCallback(const std::experimental::optional<std::vector<::ledger::core::api::OperationRecord>> & c_result, const std::experimental::optional<::ledger::core::api::Error> & c_error) {
+    auto jniEnv = ::djinni::jniGetThreadEnv();
+    ::djinni::JniLocalScope jscope(jniEnv, 10);
+    const auto& data = ::djinni::JniClass<::djinni_generated::OperationRecordListCallback>::get();
+    jniEnv->CallVoidMethod(Handle::get().get(), data.method_onCallback,
+                           ::djinni::get(::djinni::Optional<std::experimental::optional, ::djinni::List<::djinni_generated::OperationRecord>>::fromCpp(jniEnv, c_result)),
+                           ::djinni::get(::djinni::Optional<std::experimental::optional, ::djinni_generated::Error>::fromCpp(jniEnv, c_error)));
+    ::djinni::jniExceptionCheck(jniEnv);
+}
+
+}  // namespace djinni_generated
@@ -0,0 +1,48 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from callback.djinni
+
+#ifndef DJINNI_GENERATED_OPERATIONRECORDLISTCALLBACK_HPP_JNI_
+#define DJINNI_GENERATED_OPERATIONRECORDLISTCALLBACK_HPP_JNI_
+
+#include "../../api/OperationRecordListCallback.hpp"
+#include "djinni_support.hpp"
+
+namespace djinni_generated {
+
+class OperationRecordListCallback final : ::djinni::JniInterface<::ledger::core::api::OperationRecordListCallback, OperationRecordListCallback> {
+public:
+    using CppType = std::shared_ptr<::ledger::core::api::OperationRecordListCallback>;
+    using CppOptType = std::shared_ptr<::ledger::core::api::OperationRecordListCallback>;
+    using JniType = jobject;
+
+    using Boxed = OperationRecordListCallback;
+
+    ~OperationRecordListCallback();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j) { return ::djinni::JniClass<OperationRecordListCallback>::get()._fromJava(jniEnv, j); }
+    static ::djinni::LocalRef<JniType> fromCppOpt(JNIEnv* jniEnv, const CppOptType& c) { return {jniEnv, ::djinni::JniClass<OperationRecordListCallback>::get()._toJava(jniEnv, c)}; }
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c) { return fromCppOpt(jniEnv, c); }
+
+private:
+    OperationRecordListCallback();
+    friend ::djinni::JniClass<OperationRecordListCallback>;
+    friend ::djinni::JniInterface<::ledger::core::api::OperationRecordListCallback, OperationRecordListCallback>;
+
+    class JavaProxy final : ::djinni::JavaProxyHandle<JavaProxy>, public ::ledger::core::api::OperationRecordListCallback
+    {
+    public:
+        JavaProxy(JniType j);
+        ~JavaProxy();
+
+        void onCallback(const std::experimental::optional<std::vector<::ledger::core::api::OperationRecord>> & result, const std::experimental::optional<::ledger::core::api::Error> & error) override;
+
+    private:
+        friend ::djinni::JniInterface<::ledger::core::api::OperationRecordListCallback, ::djinni_generated::OperationRecordListCallback>;
+    };
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("co/ledger/core/OperationRecordListCallback") };
+    const jmethodID method_onCallback { ::djinni::jniGetMethodID(clazz.get(), "onCallback", "(Ljava/util/ArrayList;Lco/ledger/core/Error;)V") };
+};
+
+}  // namespace djinni_generated
+#endif //DJINNI_GENERATED_OPERATIONRECORDLISTCALLBACK_HPP_JNI_
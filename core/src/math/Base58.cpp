@@ -38,7 +38,6 @@
 #include <crypto/Keccak.h>
 
 using namespace ledger::core;
-static const std::string DIGITS = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
 static const ledger::core::BigInt V_58(58);
 
 static void _encode(const ledger::core::BigInt &v,
@@ -53,34 +52,54 @@ static void _encode(const ledger::core::BigInt &v,
     ss << networkBase58Dictionary[r];
 }
 
-static std::string getNetworkIdentifier(const std::shared_ptr<api::DynamicObject> &config) {
-    return config->getString("networkIdentifier").value_or("");
-}
+const std::string ledger::core::Base58::DIGITS = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+const std::string ledger::core::Base58::Parameters::NO_NETWORK_IDENTIFIER = "";
+
+ledger::core::Base58::Parameters::Parameters(const std::string &networkIdentifier,
+                                             const std::string &dictionary,
+                                             bool useNetworkDictionary)
+    : networkIdentifier(networkIdentifier),
+      dictionary(dictionary.empty() ? DIGITS : dictionary),
+      useNetworkDictionary(useNetworkDictionary) {
 
-static std::string getNetworkBase58Dictionary(const std::shared_ptr<api::DynamicObject> &config) {
-    return config->getString("base58Dictionary").value_or(DIGITS);
 }
 
-static bool shouldUseNetworkBase58Dictionary(const std::shared_ptr<api::DynamicObject> &config) {
-    return config->getBoolean("useNetworkDictionary").value_or(false);
+// Runs f with the parameters held by the configuration, read into locals the parameters can reference
+template <typename T>
+static T withConfiguration(const std::shared_ptr<ledger::core::api::DynamicObject> &config,
+                           const std::function<T (const ledger::core::Base58::Parameters&)> &f) {
+    auto networkIdentifier = config->getString("networkIdentifier").value_or("");
+    auto dictionary = config->getString("base58Dictionary").value_or(ledger::core::Base58::DIGITS);
+    auto useNetworkDictionary = config->getBoolean("useNetworkDictionary").value_or(false);
+    return f(ledger::core::Base58::Parameters(networkIdentifier, dictionary, useNetworkDictionary));
 }
 
 std::string ledger::core::Base58::encode(const std::vector<uint8_t> &bytes,
                                          const std::shared_ptr<api::DynamicObject> &config) {
+    return withConfiguration<std::string>(config, [&] (const Parameters &params) {
+        return encode(bytes, params);
+    });
+}
+
+std::string ledger::core::Base58::encode(const std::vector<uint8_t> &bytes, const Parameters &params) {
     BigInt intData(bytes.data(), bytes.size(), false);
     std::stringstream ss;
-    auto base58Dictionary = getNetworkBase58Dictionary(config);
     for (auto i = 0; i < bytes.size() && bytes[i] == 0; i++) {
-        ss << base58Dictionary[0];
+        ss << params.dictionary[0];
     }
-    _encode(intData, ss, getNetworkIdentifier(config), base58Dictionary);
+    _encode(intData, ss, params.networkIdentifier, params.dictionary);
     return ss.str();
 }
 
 std::string ledger::core::Base58::encodeWithChecksum(const std::vector<uint8_t> &bytes,
                                                      const std::shared_ptr<api::DynamicObject> &config) {
+    return withConfiguration<std::string>(config, [&] (const Parameters &params) {
+        return encodeWithChecksum(bytes, params);
+    });
+}
 
-    return encode(vector::concat<uint8_t>(bytes, computeChecksum(bytes, getNetworkIdentifier(config))), config);
+std::string ledger::core::Base58::encodeWithChecksum(const std::vector<uint8_t> &bytes, const Parameters &params) {
+    return encode(vector::concat<uint8_t>(bytes, computeChecksum(bytes, params.networkIdentifier)), params);
 }
 
 std::string ledger::core::Base58::encodeWithEIP55(const std::vector<uint8_t> &bytes) {
@@ -118,10 +137,15 @@ std::string ledger::core::Base58::encodeWithEIP55(const std::string &address) {
 
 std::vector<uint8_t> ledger::core::Base58::decode(const std::string &str,
                                                   const std::shared_ptr<api::DynamicObject> &config) {
+    return withConfiguration<std::vector<uint8_t>>(config, [&] (const Parameters &params) {
+        return decode(str, params);
+    });
+}
+
+std::vector<uint8_t> ledger::core::Base58::decode(const std::string &str, const Parameters &params) {
     BigInt intData(0);
     std::vector<uint8_t> prefix;
-    auto useBase58Dict = shouldUseNetworkBase58Dictionary(config);
-    auto base58Dictionary = useBase58Dict ? getNetworkBase58Dictionary(config) : DIGITS;
+    const auto& base58Dictionary = params.useNetworkDictionary ? params.dictionary : DIGITS;
     for (auto& c : str) {
         if (c == '1' && intData == BigInt::ZERO) {
             prefix.push_back(0);
@@ -136,7 +160,7 @@ std::vector<uint8_t> ledger::core::Base58::decode(const std::string &str,
     }
 
     //For XRP, hash160 is preceeded by a null byte prefix
-    if (useBase58Dict && prefix.empty() && getNetworkIdentifier(config) == "xrp") {
+    if (params.useNetworkDictionary && prefix.empty() && params.networkIdentifier == "xrp") {
         prefix.push_back(0);
     }
 
@@ -153,15 +177,22 @@ std::vector<uint8_t> ledger::core::Base58::computeChecksum(const std::vector<uin
 
 ledger::core::Try<std::vector<uint8_t>> ledger::core::Base58::checkAndDecode(const std::string &str,
                                                                              const std::shared_ptr<api::DynamicObject> &config) {
+    return withConfiguration<Try<std::vector<uint8_t>>>(config, [&] (const Parameters &params) {
+        return checkAndDecode(str, params);
+    });
+}
+
+ledger::core::Try<std::vector<uint8_t>> ledger::core::Base58::checkAndDecode(const std::string &str,
+                                                                             const Parameters &params) {
     return Try<std::vector<uint8_t>>::from([&] () {
-        auto decoded = decode(str, config);
+        auto decoded = decode(str, params);
         //Check decoded address size
         if (decoded.size() <= 4) {
             throw Exception(api::ErrorCode::INVALID_BASE58_FORMAT, "Invalid address : Invalid base 58 format");
         }
         std::vector<uint8_t> data(decoded.begin(), decoded.end() - 4);
         std::vector<uint8_t> checksum(decoded.end() - 4, decoded.end());
-        auto chks = computeChecksum(data, getNetworkIdentifier(config));
+        auto chks = computeChecksum(data, params.networkIdentifier);
         if (checksum != chks) {
             throw Exception(api::ErrorCode::INVALID_CHECKSUM, "Base 58 invalid checksum");
         }
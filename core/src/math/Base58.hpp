@@ -45,15 +45,37 @@ namespace ledger {
             Base58() = delete;
             ~Base58() = delete;
 
+            static const std::string DIGITS;
+
+            // Typed form of the configuration entries ("networkIdentifier", "base58Dictionary" and
+            // "useNetworkDictionary"). It only references the identifier and the dictionary, which
+            // must outlive it (network parameters and dictionaries are static).
+            struct Parameters {
+                const std::string& networkIdentifier;
+                const std::string& dictionary;
+                bool useNetworkDictionary;
+
+                explicit Parameters(const std::string& networkIdentifier = NO_NETWORK_IDENTIFIER,
+                                    const std::string& dictionary = DIGITS,
+                                    bool useNetworkDictionary = false);
+
+            private:
+                static const std::string NO_NETWORK_IDENTIFIER;
+            };
+
             static std::string encode(const std::vector<uint8_t>& bytes, const std::shared_ptr<api::DynamicObject> &config);
+            static std::string encode(const std::vector<uint8_t>& bytes, const Parameters &params);
             static std::string encodeWithChecksum(const std::vector<uint8_t>& bytes, const std::shared_ptr<api::DynamicObject> &config);
+            static std::string encodeWithChecksum(const std::vector<uint8_t>& bytes, const Parameters &params);
             static std::string encodeWithEIP55(const std::vector<uint8_t>& bytes);
             static std::string encodeWithEIP55(const std::string &address);
 
             static std::vector<uint8_t> decode(const std::string& str,
                                                const std::shared_ptr<api::DynamicObject> &config);
+            static std::vector<uint8_t> decode(const std::string& str, const Parameters &params);
             static Try<std::vector<uint8_t>> checkAndDecode(const std::string& str,
                                                             const std::shared_ptr<api::DynamicObject> &config);
+            static Try<std::vector<uint8_t>> checkAndDecode(const std::string& str, const Parameters &params);
 
 
             static std::vector<uint8_t> computeChecksum(const std::vector<uint8_t>& bytes, const std::string &networkIdentifier = "");
@@ -45,6 +45,39 @@ namespace ledger {
 
             // key at which the encryption salt is found
             const std::string ENCRYPTION_SALT_KEY = "preferences.backend.salt";
+
+            // maximum number of decrypted values kept in memory
+            const size_t DECRYPTED_VALUES_CACHE_SIZE = 1024;
+
+            // prefix of the keys used by the backend itself, which are never re-encrypted
+            const std::string BACKEND_KEY_PREFIX = "preferences.backend.";
+
+            // keys at which an unfinished encryption reset is journaled: the salt of the new
+            // cipher, a check value encrypted with it, the state of the reset and the last key
+            // staged with the new cipher
+            const std::string REENCRYPTION_SALT_KEY = "preferences.backend.reencryption.salt";
+            const std::string REENCRYPTION_CHECK_KEY = "preferences.backend.reencryption.check";
+            const std::string REENCRYPTION_STATE_KEY = "preferences.backend.reencryption.state";
+            const std::string REENCRYPTION_CURSOR_KEY = "preferences.backend.reencryption.cursor";
+
+            // prefix under which entries re-encrypted with the new cipher are staged
+            const std::string REENCRYPTION_ENTRY_PREFIX = "preferences.backend.reencryption.entry:";
+
+            // plaintext of the check value
+            const std::string REENCRYPTION_CHECK_VALUE = "preferences.backend.reencryption";
+
+            // states of an unfinished encryption reset: entries are being staged, all of them are
+            // staged, or they are being moved in place of the old ones (which can't be undone)
+            const std::string REENCRYPTION_STAGING = "staging";
+            const std::string REENCRYPTION_STAGED = "staged";
+            const std::string REENCRYPTION_COMMITTING = "committing";
+
+            // number of entries re-encrypted and written at once when resetting encryption
+            const size_t REENCRYPTION_CHUNK_SIZE = 512;
+
+            std::vector<uint8_t> toBytes(const std::string& str) {
+                return std::vector<uint8_t>(str.cbegin(), str.cend());
+            }
         }
 
         PreferencesChange::PreferencesChange(PreferencesChangeType t, std::vector<uint8_t> k, std::vector<uint8_t> v)
@@ -56,7 +89,8 @@ namespace ledger {
 
         PreferencesBackend::PreferencesBackend(const std::string &path,
                                                const std::shared_ptr<api::ExecutionContext>& writingContext,
-                                               const std::shared_ptr<api::PathResolver> &resolver) {
+                                               const std::shared_ptr<api::PathResolver> &resolver)
+            : _decryptedValues(DECRYPTED_VALUES_CACHE_SIZE) {
             _context = writingContext;
             _dbName = resolver->resolvePreferencesPath(path);
             _db = obtainInstance(_dbName);
@@ -94,11 +128,26 @@ namespace ledger {
             leveldb::WriteOptions options;
             options.sync = true;
 
+            // while an encryption reset is prepared, entries are also staged with the new cipher so
+            // that committing the reset doesn't bring back their previous values
+            std::lock_guard<std::mutex> resetLock(_encryptionResetLock);
             for (auto& item : changes) {
                 putPreferencesChange(batch, _cipher, item);
+                if (_encryptionResetPending) {
+                    auto stagedKey = toBytes(REENCRYPTION_ENTRY_PREFIX);
+                    stagedKey.insert(stagedKey.end(), item.key.begin(), item.key.end());
+                    putPreferencesChange(batch, _pendingCipher, PreferencesChange(item.type, stagedKey, item.value));
+                }
             }
 
             db->Write(options, &batch);
+
+            if (_cipher.hasValue()) {
+                std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+                for (auto& item : changes) {
+                    _decryptedValues.remove(std::string(item.key.begin(), item.key.end()));
+                }
+            }
         }
 
         // Put a single PreferencesChange.
@@ -129,9 +178,7 @@ namespace ledger {
 
             if (value) {
                 if (_cipher.hasValue()) {
-                    auto ciphertext = std::vector<uint8_t>(value->cbegin(), value->cend());
-                    auto plaindata = decrypt_preferences_change(ciphertext, *_cipher);
-                    auto plaintext = std::string(plaindata.cbegin(), plaindata.cend());
+                    auto plaintext = decryptValue(std::string(key.begin(), key.end()), *value);
 
                     return optional<std::string>(plaintext);
                 } else {
@@ -170,10 +217,7 @@ namespace ledger {
 
                 if (_cipher.hasValue()) {
                     // decrypt the value on the fly
-                    auto value = it->value().ToString();
-                    auto ciphertext = std::vector<uint8_t>(value.cbegin(), value.cend());
-                    auto plaindata = decrypt_preferences_change(ciphertext, *_cipher);
-                    auto plaintext = std::string(plaindata.cbegin(), plaindata.cbegin());
+                    auto plaintext = decryptValue(it->key().ToString(), it->value().ToString());
                     leveldb::Slice slice(plaintext);
 
                     if (!f(it->key(), std::move(slice))) {
@@ -187,6 +231,27 @@ namespace ledger {
             }
         }
 
+        std::string PreferencesBackend::decryptValue(const std::string& key, const std::string& value) {
+            {
+                std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+                // The LevelDB instance is shared with the other backends opened on the same path, which
+                // may have written the key since: the cached plaintext is only valid for the ciphertext
+                // it was decrypted from (a fresh IV is drawn on every write).
+                auto cached = _decryptedValues.get(key);
+                if (cached.hasValue() && cached.getValue().first == value) {
+                    return cached.getValue().second;
+                }
+            }
+
+            auto ciphertext = std::vector<uint8_t>(value.cbegin(), value.cend());
+            auto plaindata = decrypt_preferences_change(ciphertext, *_cipher);
+            auto plaintext = std::string(plaindata.cbegin(), plaindata.cend());
+
+            std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+            _decryptedValues.put(key, std::make_pair(value, plaintext));
+            return plaintext;
+        }
+
         std::shared_ptr<Preferences> PreferencesBackend::getPreferences(const std::string &name) {
             return std::make_shared<Preferences>(*this, std::vector<uint8_t>(name.data(), name.data() + name.size()));
         }
@@ -200,22 +265,65 @@ namespace ledger {
             const std::shared_ptr<api::RandomNumberGenerator>& rng,
             const std::string& password
         ) {
+            // a password change may have been interrupted: the salt and the entries must match
+            // the password before deriving the cipher from them
+            recoverEncryptionReset(rng, password);
+
             // setting encryption is akin to resetting with an old password that is empty
             resetEncryption(rng, "", password);
         }
 
         void PreferencesBackend::unsetEncryption() {
             _cipher = Option<AESCipher>::NONE;
+
+            std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+            _decryptedValues.clear();
         }
 
         bool PreferencesBackend::resetEncryption(
             const std::shared_ptr<api::RandomNumberGenerator>& rng,
             const std::string& oldPassword,
-            const std::string& newPassword
+            const std::string& newPassword,
+            const std::function<void (size_t)>& onProgress
+        ) {
+            if (!prepareEncryptionReset(rng, oldPassword, newPassword, onProgress)) {
+                return false;
+            }
+            commitEncryptionReset();
+            return true;
+        }
+
+        bool PreferencesBackend::prepareEncryptionReset(
+            const std::shared_ptr<api::RandomNumberGenerator>& rng,
+            const std::string& oldPassword,
+            const std::string& newPassword,
+            const std::function<void (size_t)>& onProgress
         ) {
             Option<AESCipher> noCipher;
             auto newCipher = noCipher;
+
+            // an interrupted reset is resumed if it has the same target, otherwise it is dropped
+            auto state = getRaw(toBytes(REENCRYPTION_STATE_KEY));
+            auto resume = false;
+            if (state) {
+                if (*state == REENCRYPTION_COMMITTING) {
+                    finishEncryptionReset();
+                } else if (isEncryptionResetTarget(rng, newPassword)) {
+                    resume = true;
+                } else {
+                    rollbackEncryptionReset();
+                }
+            }
             auto salt = getEncryptionSalt();
+            auto getNewSalt = [&] () {
+                return resume ? getRaw(toBytes(REENCRYPTION_SALT_KEY)).value_or("") : createNewSalt(rng);
+            };
+
+            // cached values were decrypted with the previous cipher
+            {
+                std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+                _decryptedValues.clear();
+            }
 
             if (oldPassword.empty()) {
                 // password empty means we either want to encrypt a plaintext DB (if there’s no
@@ -225,7 +333,7 @@ namespace ledger {
                         // no salt, then we want to encrypt a plaintext DB: we only need to set the
                         // new cipher and leave the decrypting cipher disabled; we’ll also not leave
                         // this function right away as we need to encrypt the plaintext values
-                        salt = createNewSalt(rng);
+                        salt = getNewSalt();
                         newCipher = Option<AESCipher>(AESCipher(rng, newPassword, salt, PBKDF2_ITERS));
                         _cipher = noCipher;
                     } else {
@@ -233,11 +341,13 @@ namespace ledger {
                         // decrypting the data already present; we don’t need anything besides
                         // setting the cipher and returning from the function
                         _cipher = Option<AESCipher>(AESCipher(rng, newPassword, salt, PBKDF2_ITERS));
+                        _pendingCipher = _cipher;
                         return true;
                     }
                 } else {
                     // no old password and no new password; do nothing (this is not considered an
                     // error)
+                    _pendingCipher = _cipher;
                     return true;
                 }
             } else {
@@ -255,7 +365,7 @@ namespace ledger {
 
                 if (!newPassword.empty()) {
                     // encrypt with the new password if present
-                    salt = createNewSalt(rng);
+                    salt = getNewSalt();
                     newCipher = Option<AESCipher>(AESCipher(rng, newPassword, salt, PBKDF2_ITERS));
                 }
             }
@@ -276,54 +386,241 @@ namespace ledger {
                 };
             }
 
-            // now we can iterate over all data, decrypt with the “old” cipher, encrypt with the
-            // “new” cipher and generate two changes per entry: one that deletes it (to prevent to
-            // duplicating it) and one that puts the new encoded one; once the iteration is done,
-            // we submit the batch to leveldb and it applies it atomically
+            leveldb::WriteOptions writeOpts;
+            writeOpts.sync = true;
             leveldb::WriteBatch batch;
+            auto cursorKey = toBytes(REENCRYPTION_CURSOR_KEY);
+            auto stateKey = toBytes(REENCRYPTION_STATE_KEY);
+
+            // journal the reset before touching any entry so that it can be resumed if interrupted;
+            // the check value tells later which password the staged entries are encrypted with
+            auto cursor = resume ? getRaw(cursorKey) : optional<std::string>();
+            if (!resume) {
+                auto newSalt = newCipher.hasValue() ? salt : "";
+                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, toBytes(REENCRYPTION_SALT_KEY), toBytes(newSalt)));
+                putPreferencesChange(batch, newCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, toBytes(REENCRYPTION_CHECK_KEY), toBytes(REENCRYPTION_CHECK_VALUE)));
+                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, stateKey, toBytes(REENCRYPTION_STAGING)));
+                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, cursorKey, {}));
+                _db->Write(writeOpts, &batch);
+                batch.Clear();
+            }
+
+            // the new cipher is installed once the reset is committed; until then, written entries
+            // are staged with it as well
+            {
+                std::lock_guard<std::mutex> resetLock(_encryptionResetLock);
+                _pendingCipher = newCipher;
+                _encryptionResetPending = true;
+            }
+
+            // now we can iterate over all data, decrypt with the “old” cipher and encrypt with the
+            // “new” cipher; re-encrypted entries are staged next to the old ones by chunks, each of
+            // them moving the journal cursor in the same atomic write, so memory doesn't grow with
+            // the size of the store and the old entries stay readable until the reset is committed
             auto it = std::unique_ptr<leveldb::Iterator>(_db->NewIterator(leveldb::ReadOptions()));
+            if (cursor && !cursor->empty()) {
+                it->Seek(*cursor);
+                if (it->Valid() && it->key().ToString() == *cursor) {
+                    it->Next();
+                }
+            } else {
+                it->SeekToFirst();
+            }
 
-            for (it->SeekToFirst(); it->Valid(); it->Next()) {
-                // decrypt with the old cipher, if any
-                auto value = it->value().ToString();
-                auto plaindata = std::vector<uint8_t>(value.cbegin(), value.cend());
-                plaindata = readValue(plaindata);
+            size_t processed = 0;
+            std::vector<std::string> chunk;
+            auto flushChunk = [&] () {
+                {
+                    // entries may have been written since the iterator was created: stage their
+                    // current value, under the lock so that a concurrent write can't be undone
+                    std::lock_guard<std::mutex> resetLock(_encryptionResetLock);
+                    for (const auto& key : chunk) {
+                        auto value = getRaw(toBytes(key));
+                        if (!value) {
+                            continue;
+                        }
+
+                        // decrypt with the old cipher, if any, encrypt with the new cipher (if any)
+                        // and stage the entry
+                        auto plaindata = readValue(std::vector<uint8_t>(value->cbegin(), value->cend()));
+                        putPreferencesChange(batch, newCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, toBytes(REENCRYPTION_ENTRY_PREFIX + key), plaindata));
+                    }
+                    putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, cursorKey, toBytes(chunk.back())));
+                    _db->Write(writeOpts, &batch);
+                }
+                batch.Clear();
+                processed += chunk.size();
+                chunk.clear();
+                if (onProgress) {
+                    onProgress(processed);
+                }
+            };
 
+            for (; it->Valid(); it->Next()) {
                 // the key is never encrypted
                 auto keyStr = it->key().ToString();
-                auto key = std::vector<uint8_t>(keyStr.cbegin(), keyStr.cend());
+                if (keyStr.compare(0, BACKEND_KEY_PREFIX.size(), BACKEND_KEY_PREFIX) == 0) {
+                    continue;
+                }
 
-                // remove the key and its associated value to prevent duplication
-                putPreferencesChange(batch, _cipher, PreferencesChange(PreferencesChangeType::DELETE_TYPE, key, {}));
+                chunk.push_back(keyStr);
+                if (chunk.size() == REENCRYPTION_CHUNK_SIZE) {
+                    flushChunk();
+                }
+            }
+            it.reset();
 
-                // encrypt with the new cipher (if any); in order to do that, we need a PreferencesChange
-                // to add with the new cipher
-                auto change = PreferencesChange(PreferencesChangeType::PUT_TYPE, key, plaindata);
-                putPreferencesChange(batch, newCipher, change);
+            putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, stateKey, toBytes(REENCRYPTION_STAGED)));
+            if (!chunk.empty()) {
+                flushChunk();
+            } else {
+                _db->Write(writeOpts, &batch);
             }
 
-            // we also need to update the salt if we are encrypting
-            auto saltKey = std::vector<uint8_t>(ENCRYPTION_SALT_KEY.cbegin(), ENCRYPTION_SALT_KEY.cend());
+            return true;
+        }
+
+        void PreferencesBackend::commitEncryptionReset() {
+            {
+                std::lock_guard<std::mutex> resetLock(_encryptionResetLock);
+                if (getRaw(toBytes(REENCRYPTION_STATE_KEY))) {
+                    finishEncryptionReset();
+                }
+                _cipher = _pendingCipher;
+                _pendingCipher = Option<AESCipher>::NONE;
+                _encryptionResetPending = false;
+            }
+
+            std::lock_guard<std::mutex> lock(_decryptedValuesLock);
+            _decryptedValues.clear();
+        }
+
+        void PreferencesBackend::abortEncryptionReset() {
+            std::lock_guard<std::mutex> resetLock(_encryptionResetLock);
+            auto state = getRaw(toBytes(REENCRYPTION_STATE_KEY));
+            if (state && *state != REENCRYPTION_COMMITTING) {
+                rollbackEncryptionReset();
+            }
+            _pendingCipher = Option<AESCipher>::NONE;
+            _encryptionResetPending = false;
+        }
+
+        void PreferencesBackend::recoverEncryptionReset(
+            const std::shared_ptr<api::RandomNumberGenerator>& rng,
+            const std::string& password
+        ) {
+            auto state = getRaw(toBytes(REENCRYPTION_STATE_KEY));
+            if (!state) {
+                return;
+            }
+
+            // the reset is finished if it was committed, or if every entry is staged and the
+            // password is the new one (the owner of the store moved on to it); otherwise the old
+            // entries are still in place and the staged ones are dropped
+            if (*state == REENCRYPTION_COMMITTING ||
+                (*state == REENCRYPTION_STAGED && isEncryptionResetTarget(rng, password))) {
+                finishEncryptionReset();
+            } else {
+                rollbackEncryptionReset();
+            }
+        }
+
+        bool PreferencesBackend::isEncryptionResetTarget(
+            const std::shared_ptr<api::RandomNumberGenerator>& rng,
+            const std::string& password
+        ) {
+            auto salt = getRaw(toBytes(REENCRYPTION_SALT_KEY)).value_or("");
+            auto check = getRaw(toBytes(REENCRYPTION_CHECK_KEY)).value_or("");
+            if (salt.empty() != password.empty()) {
+                return false;
+            }
+            if (password.empty()) {
+                return check == REENCRYPTION_CHECK_VALUE;
+            }
+
+            AESCipher cipher(rng, password, salt, PBKDF2_ITERS);
+            try {
+                auto plaindata = decrypt_preferences_change(std::vector<uint8_t>(check.cbegin(), check.cend()), cipher);
+                return std::string(plaindata.cbegin(), plaindata.cend()) == REENCRYPTION_CHECK_VALUE;
+            } catch (const std::exception&) {
+                // wrong key
+                return false;
+            }
+        }
+
+        void PreferencesBackend::finishEncryptionReset() {
+            Option<AESCipher> noCipher;
+            leveldb::WriteOptions writeOpts;
+            writeOpts.sync = true;
+            leveldb::WriteBatch batch;
+
+            // from now on the old entries get overwritten: the reset can only go forward
+            putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, toBytes(REENCRYPTION_STATE_KEY), toBytes(REENCRYPTION_COMMITTING)));
+            _db->Write(writeOpts, &batch);
+            batch.Clear();
+
+            // move the staged entries in place of the old ones, by chunks
+            size_t chunkSize = 0;
+            forEachStagedEntry([&] (const leveldb::Slice& stagedKey, const leveldb::Slice& value) {
+                leveldb::Slice key(stagedKey.data() + REENCRYPTION_ENTRY_PREFIX.size(),
+                                   stagedKey.size() - REENCRYPTION_ENTRY_PREFIX.size());
+                batch.Put(key, value);
+                batch.Delete(stagedKey);
+                chunkSize += 1;
+                if (chunkSize == REENCRYPTION_CHUNK_SIZE) {
+                    _db->Write(writeOpts, &batch);
+                    batch.Clear();
+                    chunkSize = 0;
+                }
+            });
+
+            // we also need to update the salt if we are encrypting, and drop the journal; this is
+            // written along with the last entries
+            auto saltKey = toBytes(ENCRYPTION_SALT_KEY);
+            auto newSalt = getRaw(toBytes(REENCRYPTION_SALT_KEY)).value_or("");
             putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::DELETE_TYPE, saltKey, {}));
 
-            if (newCipher.hasValue()) {
+            if (!newSalt.empty()) {
                 // we put a new salt only if we are encrypting
-                auto newSaltBytes = std::vector<uint8_t>(salt.cbegin(), salt.cend());
-
-                // remove the previous salt
-                // add the new salt
-                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, saltKey, newSaltBytes));
+                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::PUT_TYPE, saltKey, toBytes(newSalt)));
             }
+            dropEncryptionResetJournal(batch);
+            _db->Write(writeOpts, &batch);
+        }
 
-            // atomic update
+        void PreferencesBackend::rollbackEncryptionReset() {
             leveldb::WriteOptions writeOpts;
             writeOpts.sync = true;
+            leveldb::WriteBatch batch;
+
+            // the old entries are untouched: only drop the staged ones, by chunks
+            size_t chunkSize = 0;
+            forEachStagedEntry([&] (const leveldb::Slice& stagedKey, const leveldb::Slice&) {
+                batch.Delete(stagedKey);
+                chunkSize += 1;
+                if (chunkSize == REENCRYPTION_CHUNK_SIZE) {
+                    _db->Write(writeOpts, &batch);
+                    batch.Clear();
+                    chunkSize = 0;
+                }
+            });
+            dropEncryptionResetJournal(batch);
             _db->Write(writeOpts, &batch);
+        }
 
-            // update the cipher to use with the new one
-            _cipher = newCipher;
+        void PreferencesBackend::forEachStagedEntry(const std::function<void (const leveldb::Slice&, const leveldb::Slice&)>& f) {
+            std::unique_ptr<leveldb::Iterator> it(_db->NewIterator(leveldb::ReadOptions()));
+            leveldb::Slice prefix(REENCRYPTION_ENTRY_PREFIX);
+            for (it->Seek(prefix); it->Valid() && it->key().starts_with(prefix); it->Next()) {
+                f(it->key(), it->value());
+            }
+        }
 
-            return true;
+        void PreferencesBackend::dropEncryptionResetJournal(leveldb::WriteBatch& batch) {
+            Option<AESCipher> noCipher;
+            for (auto& key : {REENCRYPTION_SALT_KEY, REENCRYPTION_CHECK_KEY, REENCRYPTION_STATE_KEY, REENCRYPTION_CURSOR_KEY}) {
+                putPreferencesChange(batch, noCipher, PreferencesChange(PreferencesChangeType::DELETE_TYPE, toBytes(key), {}));
+            }
         }
 
         void PreferencesBackend::clear() {
@@ -362,7 +659,7 @@ namespace ledger {
           auto output = BytesWriter();
           cipher.encrypt(input, output);
 
-          return output.toByteArray();
+          return std::move(output).toByteArray();
         }
 
         std::vector<uint8_t> PreferencesBackend::decrypt_preferences_change(
@@ -373,7 +670,7 @@ namespace ledger {
           auto output = BytesWriter();
           cipher.decrypt(input, output);
 
-          return output.toByteArray();
+          return std::move(output).toByteArray();
         }
     }
 }
@@ -49,6 +49,7 @@
 #include <api/RandomNumberGenerator.hpp>
 #include <utils/Option.hpp>
 #include <crypto/AESCipher.hpp>
+#include <collections/LRUCache.hpp>
 
 namespace ledger {
     namespace core {
@@ -87,6 +88,10 @@ namespace ledger {
             /// This method will set encryption on for all future values that will be persisted.
             /// If this function is called on a plaintext storage (i.e. first encryption for
             /// instance), it will also encrypt all data already present.
+            ///
+            /// If a reset of the encryption was interrupted, it is first finished when it was
+            /// committed, or when every entry was staged and password is the new password of the
+            /// reset. Otherwise it is rolled back, leaving the entries encrypted with the old one.
             void setEncryption(
                 const std::shared_ptr<api::RandomNumberGenerator>& rng,
                 const std::string& password
@@ -106,14 +111,40 @@ namespace ledger {
             /// If the new password is an empty string, after this method is called, the database
             /// is completely unciphered and no password is required to read from it.
             ///
+            /// This is prepareEncryptionReset followed by commitEncryptionReset.
+            ///
             /// Return true if the reset occurred correctly, false otherwise (e.g. trying to change
             /// password with an old password but without a proper salt already persisted).
             bool resetEncryption(
                 const std::shared_ptr<api::RandomNumberGenerator>& rng,
                 const std::string& oldPassword,
-                const std::string& newPassword
+                const std::string& newPassword,
+                const std::function<void (size_t)>& onProgress = nullptr
+            );
+
+            /// Re-encrypt the data present with the new password, without replacing it yet.
+            ///
+            /// Entries are re-encrypted and staged by chunks, along with a journal of the progress.
+            /// If this is interrupted, calling it again with the same new password resumes it where
+            /// it stopped. onProgress, if set, is called after each chunk with the number of entries
+            /// re-encrypted so far. Entries written until the reset is committed or aborted are
+            /// staged as well.
+            ///
+            /// Return false if the reset can't occur (see resetEncryption).
+            bool prepareEncryptionReset(
+                const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                const std::string& oldPassword,
+                const std::string& newPassword,
+                const std::function<void (size_t)>& onProgress = nullptr
             );
 
+            /// Replace the entries with the ones staged by prepareEncryptionReset and switch to the
+            /// new password. Once started, the reset is finished even if this is interrupted.
+            void commitEncryptionReset();
+
+            /// Drop the entries staged by prepareEncryptionReset, keeping the old password.
+            void abortEncryptionReset();
+
             /// Get encryption salt, if any.
             std::string getEncryptionSalt();
 
@@ -125,6 +156,20 @@ namespace ledger {
             std::shared_ptr<leveldb::DB> _db;
             std::string _dbName;
             Option<AESCipher> _cipher;
+            // Cipher installed when the prepared encryption reset is committed
+            Option<AESCipher> _pendingCipher;
+            // Whether a prepared encryption reset waits to be committed or aborted; written entries
+            // are then staged with _pendingCipher too
+            bool _encryptionResetPending {false};
+            std::mutex _encryptionResetLock;
+
+            // Recently decrypted values (ciphertext, plaintext), indexed by key; only used when
+            // encryption is on
+            LRUCache<std::string, std::pair<std::string, std::string>> _decryptedValues;
+            std::mutex _decryptedValuesLock;
+
+            // Get the plaintext of an encrypted value, from the cache if possible.
+            std::string decryptValue(const std::string& key, const std::string& value);
 
             // Get a raw entry from the key-value store.
             optional<std::string> getRaw(const std::vector<uint8_t>& key) const;
@@ -154,6 +199,28 @@ namespace ledger {
                 AESCipher& cipher
             );
 
+            // Finish or roll back an interrupted encryption reset, depending on its state and on
+            // the password the store is opened with.
+            void recoverEncryptionReset(
+                const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                const std::string& password
+            );
+
+            // Whether the entries staged by an encryption reset are encrypted with this password.
+            bool isEncryptionResetTarget(
+                const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                const std::string& password
+            );
+
+            // Move the staged entries in place and install the new salt.
+            void finishEncryptionReset();
+
+            // Drop the staged entries.
+            void rollbackEncryptionReset();
+
+            void forEachStagedEntry(const std::function<void (const leveldb::Slice&, const leveldb::Slice&)>& f);
+            void dropEncryptionResetJournal(leveldb::WriteBatch& batch);
+
             static std::unordered_map<std::string, std::weak_ptr<leveldb::DB>> LEVELDB_INSTANCE_POOL;
             static std::mutex LEVELDB_INSTANCE_POOL_MUTEX;
 
@@ -65,11 +65,8 @@ namespace ledger {
         }
 
         std::string RippleLikeAddress::toBase58() {
-            auto config = std::make_shared<DynamicObject>();
-            config->putString("networkIdentifier", _params.Identifier);
-            config->putString("base58Dictionary", networks::RIPPLE_DIGITS);
-            config->putBoolean("useNetworkDictionary", true);
-            return Base58::encodeWithChecksum(vector::concat(_version, _hash160), config);
+            return Base58::encodeWithChecksum(vector::concat(_version, _hash160),
+                                              Base58::Parameters(_params.Identifier, networks::RIPPLE_DIGITS, true));
         }
 
         std::experimental::optional<std::string> RippleLikeAddress::getDerivationPath() {
@@ -93,11 +90,7 @@ namespace ledger {
                                                                          const api::Currency &currency,
                                                                          const Option<std::string> &derivationPath) {
             auto& params = currency.rippleLikeNetworkParameters.value();
-            auto config = std::make_shared<DynamicObject>();
-            config->putString("networkIdentifier", params.Identifier);
-            config->putString("base58Dictionary", networks::RIPPLE_DIGITS);
-            config->putBoolean("useNetworkDictionary", true);
-            auto decoded = Base58::checkAndDecode(address, config);
+            auto decoded = Base58::checkAndDecode(address, Base58::Parameters(params.Identifier, networks::RIPPLE_DIGITS, true));
             if (decoded.isFailure()) {
                 throw decoded.getFailure();
             }
@@ -95,6 +95,7 @@ namespace ledger {
             out.currencyName = getWallet()->getCurrency().name;
             out.walletType = getWalletType();
             out.walletUid = wallet->getWalletUid();
+            out.sharedTransactionStorage = wallet->getConfigSnapshot().sharedTransactionStorage;
             out.date = tx.receivedAt;
             if (out.block.nonEmpty())
                 out.block.getValue().currencyName = wallet->getCurrency().name;
@@ -236,26 +237,14 @@ namespace ledger {
                         emitNewOperationEvent(operation);
                 }
 
-                auto accountUid = getAccountUid();
-                //Update account_uid column of bitcoin_outputs table
+                // Link the received outputs to the account, the transaction itself may be shared with other accounts
+                std::vector<uint64_t> outputIndexes;
+                outputIndexes.reserve(accountOutputs.size());
                 for (auto& o : accountOutputs) {
-                    if (o.first->address.nonEmpty()) {
-                        auto address = o.first->address.getValue();
-                        soci::rowset<soci::row> rows = (sql.prepare << "SELECT transaction_uid, transaction_hash FROM bitcoin_outputs WHERE address = :address AND account_uid IS NULL ",
-                                soci::use(address));
-
-                        for (auto &row : rows) {
-                            auto txUid = row.get<std::string>(0);
-                            auto txHash = row.get<std::string>(1);
-                            //This check is made to avoid setting account_uid of bitcoin_outputs which was set during another's account scan/sync
-                            //since now bitcoin_outputs has transaction_uid (accountUid-hash) as primary key
-                            if (txUid == BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(accountUid, txHash)) {
-                                sql << "UPDATE bitcoin_outputs SET account_uid = :accountUid WHERE address = :address AND transaction_uid = :txUid",
-                                        soci::use(accountUid), soci::use(address), soci::use(txUid);
-                            }
-                        }
-                    }
+                    outputIndexes.push_back(o.first->index);
                 }
+                auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(getTransactionOwner(), transaction.hash);
+                BitcoinLikeTransactionDatabaseHelper::putAccountOutputs(sql, getAccountUid(), btcTxUid, outputIndexes);
 
             }
 
@@ -280,6 +269,11 @@ namespace ledger {
             }
         }
 
+        std::string BitcoinLikeAccount::getTransactionOwner() {
+            auto wallet = getWallet();
+            return wallet->getConfigSnapshot().sharedTransactionStorage ? wallet->getCurrency().name : getAccountUid();
+        }
+
         std::shared_ptr<BitcoinLikeKeychain> BitcoinLikeAccount::getKeychain() const {
             return _keychain;
         }
@@ -342,7 +336,7 @@ namespace ledger {
             auto self = getSelf();
             return async<std::vector<std::shared_ptr<api::BitcoinLikeOutput>>>([=] () -> std::vector<std::shared_ptr<api::BitcoinLikeOutput>> {
                 auto keychain = self->getKeychain();
-                soci::session sql(self->getWallet()->getDatabase()->getPool());
+                soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 std::vector<BitcoinLikeBlockchainExplorerOutput> utxo;
                 BitcoinLikeUTXODatabaseHelper::queryUTXO(sql, self->getAccountUid(), from, to - from, utxo, [&keychain] (const std::string& addr) {
                     return keychain->contains(addr);
@@ -373,11 +367,15 @@ namespace ledger {
             return false;
         }
 
+        void BitcoinLikeAccount::persistPendingState() {
+            _keychain->persistState();
+        }
+
         Future<int32_t> BitcoinLikeAccount::getUTXOCount() {
             auto self = getSelf();
             return async<int32_t>([=] () -> int32_t {
                 auto keychain = self->getKeychain();
-                soci::session sql(self->getWallet()->getDatabase()->getPool());
+                soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 return (int32_t) BitcoinLikeUTXODatabaseHelper::UTXOcount(sql, self->getAccountUid(), [keychain] (const std::string& addr) -> bool {
                     return keychain->contains(addr);
                 });
@@ -388,7 +386,7 @@ namespace ledger {
             auto query = std::make_shared<OperationQuery>(
                     api::QueryFilter::accountEq(getAccountUid()),
                     getWallet()->getDatabase(),
-                    getWallet()->getContext(),
+                    getContext(),
                     getWallet()->getMainExecutionContext()
             );
             query->registerAccount(shared_from_this());
@@ -425,7 +423,7 @@ namespace ledger {
             return async<std::shared_ptr<Amount>>([=] () -> std::shared_ptr<Amount> {
                 const int32_t BATCH_SIZE = 100;
                 const auto& uid = self->getAccountUid();
-                soci::session sql(self->getWallet()->getDatabase()->getPool());
+                soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 std::vector<BitcoinLikeBlockchainExplorerOutput> utxos;
                 auto offset = 0;
                 std::size_t count = 0;
@@ -457,7 +455,7 @@ namespace ledger {
                 }
 
                 const auto &uid = self->getAccountUid();
-                soci::session sql(self->getWallet()->getDatabase()->getPool());
+                soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                 std::vector<Operation> operations;
 
                 auto keychain = self->getKeychain();
@@ -579,7 +577,7 @@ namespace ledger {
                         auto prevTxHash = input->getPreviousTxHash().value_or("");
                         auto prevTxOutputIndex = input->getPreviousOutputIndex().value_or(0);
                         BitcoinLikeBlockchainExplorerTransaction prevTx;
-                        if (!BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, prevTxHash, self->getAccountUid(), prevTx) || prevTxOutputIndex >= prevTx.outputs.size()) {
+                        if (!BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, prevTxHash, self->getTransactionOwner(), prevTx) || prevTxOutputIndex >= prevTx.outputs.size()) {
                             throw make_exception(api::ErrorCode::TRANSACTION_NOT_FOUND, "Transaction {} not found while broadcasting", prevTxHash);
                         }
                         in.value = prevTx.outputs[prevTxOutputIndex].value;
@@ -608,7 +606,12 @@ namespace ledger {
                     }
 
                     //Store in DB
-                    return self->putTransaction(sql, txExplorer);
+                    soci::transaction tr(sql);
+                    auto flag = self->putTransaction(sql, txExplorer);
+                    tr.commit();
+                    // Change addresses marked as used must survive a restart, as after a synchronization
+                    self->persistPendingState();
+                    return flag;
                 });
 
                 // Failing optimistic update should not throw an exception
@@ -663,7 +666,7 @@ namespace ledger {
             return async<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>([=] () -> std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction> {
                 auto tx = std::make_shared<BitcoinLikeBlockchainExplorerTransaction>();
                 soci::session sql(self->getWallet()->getDatabase()->getPool());
-                if (!BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, hash, self->getAccountUid(), *tx)) {
+                if (!BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, hash, self->getTransactionOwner(), *tx)) {
                     throw make_exception(api::ErrorCode::TRANSACTION_NOT_FOUND, "Transaction {} not found", hash);
                 }
                 return tx;
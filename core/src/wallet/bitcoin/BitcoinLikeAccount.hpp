@@ -81,6 +81,7 @@ namespace ledger {
              * @return A flag indicating if the transaction was ignored, inserted
              */
             int putTransaction(soci::session& sql, const BitcoinLikeBlockchainExplorerTransaction& transaction);
+            void persistPendingState() override;
             /**
              *
              * @param block
@@ -90,6 +91,12 @@ namespace ledger {
 
             std::shared_ptr<BitcoinLikeKeychain> getKeychain() const;
 
+            /**
+             * Owner of the raw transaction rows written by this account: the account itself, or its currency when
+             * the wallet shares transactions between accounts.
+             */
+            std::string getTransactionOwner();
+
             void startBlockchainObservation() override;
             void stopBlockchainObservation() override;
             bool isObservingBlockchain() override;
@@ -60,14 +60,6 @@ namespace ledger {
             _synchronizerFactory = synchronizer;
         }
 
-        bool BitcoinLikeWallet::isSynchronizing() {
-            return false;
-        }
-
-        std::shared_ptr<api::EventBus> BitcoinLikeWallet::synchronize() {
-            return nullptr;
-        }
-
         FuturePtr<ledger::core::api::Account>
         BitcoinLikeWallet::newAccountWithInfo(const api::AccountCreationInfo &info) {
             // TODO: Update data structure to be able to do P2SH with mixed HD and Solo keys.
@@ -174,7 +166,7 @@ namespace ledger {
                 info.index = accountIndex;
                 auto scheme = self->getDerivationScheme();
                 scheme.setCoinType(self->getCurrency().bip44CoinType).setAccountIndex(accountIndex);;
-                auto keychainEngine = self->getConfiguration()->getString(api::Configuration::KEYCHAIN_ENGINE).value_or(api::ConfigurationDefaults::DEFAULT_KEYCHAIN);
+                auto& keychainEngine = self->getConfigSnapshot().keychainEngine;
                 if (keychainEngine == api::KeychainEngines::BIP32_P2PKH ||
                     keychainEngine == api::KeychainEngines::BIP49_P2SH ||
                     keychainEngine == api::KeychainEngines::BIP173_P2WPKH ||
@@ -61,9 +61,6 @@ namespace ledger {
             );
 
             // API methods
-            bool isSynchronizing() override;
-            std::shared_ptr<api::EventBus> synchronize() override;
-
             FuturePtr<ledger::core::api::Account> newAccountWithInfo(const api::AccountCreationInfo &info) override;
 
             FuturePtr<ledger::core::api::Account>
@@ -132,11 +132,22 @@ namespace ledger {
 
         std::vector<uint8_t> BitcoinLikeTransactionApi::serialize() {
             BytesWriter writer;
+            writer.reserve(getSerializedSizeHint());
             serializeProlog(writer);
             serializeInputs(writer);
             serializeOutputs(writer);
             serializeEpilogue(writer);
-            return writer.toByteArray();
+            return std::move(writer).toByteArray();
+        }
+
+        size_t BitcoinLikeTransactionApi::getSerializedSizeHint() const {
+            // Upper bound for standard transactions: version, version group id, timestamp, segwit marker and flag,
+            // counts and lock time, then a signed P2PKH (or P2WPKH with its witness) input and a P2PKH/P2WSH output.
+            // Bigger scripts only cost a reallocation.
+            static const size_t FIXED_SIZE = 4 + 4 + 4 + 2 + 9 + 9 + 4 + 4;
+            static const size_t INPUT_SIZE = 32 + 4 + 1 + 107 + 4 + 108;
+            static const size_t OUTPUT_SIZE = 8 + 2 + 1 + 34;
+            return FIXED_SIZE + INPUT_SIZE * _inputs.size() + OUTPUT_SIZE * _outputs.size();
         }
 
         optional<std::vector<uint8_t>> BitcoinLikeTransactionApi::getWitness() {
@@ -173,7 +184,7 @@ namespace ledger {
                     }
                 }
             }
-            return Option<std::vector<uint8_t>>(witness.toByteArray()).toOptional();
+            return Option<std::vector<uint8_t>>(std::move(witness).toByteArray()).toOptional();
         }
 
         api::EstimatedSize BitcoinLikeTransactionApi::getEstimatedSize() {
@@ -264,8 +275,9 @@ namespace ledger {
 
         std::vector<uint8_t> BitcoinLikeTransactionApi::serializeOutputs() {
             BytesWriter writer;
+            writer.reserve(getSerializedSizeHint());
             serializeOutputs(writer);
-            return writer.toByteArray();
+            return std::move(writer).toByteArray();
         }
 
         int32_t BitcoinLikeTransactionApi::getVersion() {
@@ -446,7 +458,7 @@ namespace ledger {
                 version -= (~(overwinterFlag << 24) + 1);
 
                 //Read version group Id
-                reader.read(zipParameters.versionGroupId.size());
+                reader.readView(zipParameters.versionGroupId.size());
             }
 
             // Parse timestamp
@@ -494,22 +506,28 @@ namespace ledger {
                 } else {
                     auto scriptSize = reader.readNextVarInt();
                     auto scriptSig = reader.read(scriptSize);
-                    auto parsedScript = ledger::core::BitcoinLikeScript::parse(scriptSig);
-                    if (parsedScript.isSuccess()) {
+                    // Unsigned transactions carry the previous output script, which is usually a standard template
+                    // that does not need a full parse
+                    auto standardScript = isSigned ? BitcoinLikeStandardScript() :
+                                          BitcoinLikeStandardScript::classify(scriptSig);
+                    auto parsedScript = standardScript.isStandard() ? Try<BitcoinLikeScript>() :
+                                        ledger::core::BitcoinLikeScript::parse(scriptSig);
+                    if (standardScript.isStandard() || parsedScript.isSuccess()) {
 
                         // Useful to remove script sigs from rawTx to compute txHash (e.g. XST)
                         {
                             BytesWriter localWriter;
+                            localWriter.reserve(9 + scriptSig.size());
                             localWriter.writeVarInt(scriptSize);
                             localWriter.writeByteArray(scriptSig);
-                            scriptSigs.emplace_back(localWriter.toByteArray());
+                            scriptSigs.emplace_back(std::move(localWriter).toByteArray());
                         }
 
                         BytesReader localReader(scriptSig);
                         if (isSigned && !isSegwit) {
                             //Get address from signed script
                             auto sigSize = localReader.readNextVarInt();
-                            auto sig = localReader.read(sigSize);
+                            localReader.readView(sigSize);
                             // For example XST, sometimes does not have pubKey in signature ... (e.g. 6a1e7109ce7cae649c2f79200c946622f97ea6c86b2366cbbb7a512acdb3c1c2)
                             if (scriptSize - sigSize > 1) {
                                 auto pubKeySize = localReader.readNextVarInt();
@@ -533,6 +551,13 @@ namespace ledger {
                                                             api::KeychainEngines::BIP49_P2SH);
                             address = localAddress.toBase58();
 
+                        } else if (standardScript.isStandard()) {
+                            auto parsedAddress = BitcoinLikeScript::parseAddress(scriptSig, currency);
+                            if (parsedAddress.hasValue()) {
+                                address = parsedAddress.getValue().toString();
+                            }
+                            // Standard templates serialize back to their exact raw bytes
+                            output.script = hex::toString(scriptSig);
                         } else {
                             auto parsedAddress = parsedScript.getValue().parseAddress(currency);
                             if (parsedAddress.hasValue()) {
@@ -557,16 +582,13 @@ namespace ledger {
                 output.value = reader.readNextLeBigInt(8);
                 //Decred has an additional version script (2 byte)
                 if (isDecred) {
-                    reader.read(2);
+                    reader.readView(2);
                 }
                 auto scriptSize = reader.readNextVarInt();
                 auto lockScript = reader.read(scriptSize);
-                auto parsedScript = ledger::core::BitcoinLikeScript::parse(lockScript);
-                if (parsedScript.isSuccess()) {
-                    auto parsedAddress = parsedScript.getValue().parseAddress(currency);
-                    if (parsedAddress.hasValue())
-                        output.address = Option<std::string>(parsedAddress.getValue().toString());
-                }
+                auto parsedAddress = ledger::core::BitcoinLikeScript::parseAddress(lockScript, currency);
+                if (parsedAddress.hasValue())
+                    output.address = Option<std::string>(parsedAddress.getValue().toString());
                 output.script = hex::toString(lockScript);
                 tx->addOutput(std::shared_ptr<BitcoinLikeOutputApi>(new BitcoinLikeOutputApi(
                         output, currency
@@ -578,13 +600,15 @@ namespace ledger {
                 //LockTime
                 tx->setLockTime(reader.readNextLeUint());
                 //Expiry Height
-                reader.read(4);
+                reader.readView(4);
                 //Number of inputs
                 reader.readNextVarInt();
             }
 
             //This will usefull to computes tx hash (txID)
-            std::vector<uint8_t> modifTx(rawTransaction.begin(), rawTransaction.begin() + reader.getCursor());
+            std::vector<uint8_t> modifTx;
+            modifTx.reserve(reader.getCursor() + 4);
+            modifTx.assign(rawTransaction.begin(), rawTransaction.begin() + reader.getCursor());
 
             // For XST we should remove the script sigs
             // Reference: https://github.com/StealthSend/Stealth/commit/5be35d6c2c500b32ed82e5d6913d66d18a4b0a7f#diff-e8db9b851adc2422aadfffca88f14c91R566
@@ -622,27 +646,28 @@ namespace ledger {
 
                         if (isDecred) {
                             //Amount
-                            reader.read(8);
+                            reader.readView(8);
                             //Block height
-                            reader.read(4);
+                            reader.readView(4);
                             //Block Index
-                            reader.read(4);
+                            reader.readView(4);
                             //Whole script size
                             reader.readNextVarInt();
                         }
 
                         auto scriptSigSize = reader.readNextVarInt();
-                        auto scriptSig = reader.read(scriptSigSize);
+                        auto scriptSig = reader.readView(scriptSigSize);
                         auto pubKeySize = reader.readNextVarInt();
-                        auto pubKey = reader.read(pubKeySize);
+                        auto pubKey = reader.readView(pubKeySize);
 
                         //Get script sig
                         BytesWriter writer;
+                        writer.reserve(9 + scriptSig.size() + 9 + pubKey.size());
                         writer.writeVarInt(scriptSigSize);
-                        writer.writeByteArray(scriptSig);
+                        writer.writeByteArray(scriptSig.data(), scriptSig.size());
                         writer.writeVarInt(pubKeySize);
-                        writer.writeByteArray(pubKey);
-                        preparedInputs[index].output.script = hex::toString(writer.toByteArray());
+                        writer.writeByteArray(pubKey.data(), pubKey.size());
+                        preparedInputs[index].output.script = hex::toString(std::move(writer).toByteArray());
 
                         // Get address, if not recovered yet
                         // This is only possible in case of BIP173_P2WPKH or BIP173_P2WSH
@@ -656,7 +681,7 @@ namespace ledger {
                             // BIP173_P2WSH script : <sig> <witness>
                             auto keychain = pubKey.size() == 33 ? api::KeychainEngines::BIP173_P2WPKH : api::KeychainEngines::BIP173_P2WSH;
                             // Get hash160 to construct address
-                            auto hash160 = BitcoinLikeAddress::fromPublicKeyToHash160(pubKey, currency, keychain);
+                            auto hash160 = BitcoinLikeAddress::fromPublicKeyToHash160(pubKey.toVector(), currency, keychain);
                             preparedInputs[index].address = BitcoinLikeAddress(currency, hash160, keychain).toString();
                         }
                     }
@@ -666,10 +691,10 @@ namespace ledger {
 
             //Decred has lockTime before witness
             if (!isDecred) {
-                auto timelock = reader.read(4);
-                modifTx = vector::concat(modifTx, timelock);
+                auto timelock = reader.readView(4);
+                modifTx.insert(modifTx.end(), timelock.begin(), timelock.end());
 
-                BytesReader timelockReader(timelock);
+                BytesReader timelockReader(timelock.data(), timelock.size());
                 tx->setLockTime(timelockReader.readNextLeUint());
             }
 
@@ -151,6 +151,8 @@ namespace ledger {
 
             inline void serializeEpilogue(BytesWriter &out);
 
+            size_t getSerializedSizeHint() const;
+
         private:
             int32_t _version;
             std::vector<std::shared_ptr<api::BitcoinLikeInput>> _inputs;
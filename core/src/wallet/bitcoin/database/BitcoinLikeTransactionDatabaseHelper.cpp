@@ -34,6 +34,8 @@
 #include <database/soci-option.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/BulkInsert.hpp>
+#include <database/Upsert.hpp>
 
 #include <iostream>
 using namespace std;
@@ -49,125 +51,173 @@ namespace ledger {
             return count == 1;
         }
 
-        std::string BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(const std::string& accountUid, const std::string& txHash) {
-            auto result = SHA256::stringToHexHash(fmt::format("uid:{}+{}", accountUid, txHash));
+        std::string BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(const std::string& owner, const std::string& txHash) {
+            auto result = SHA256::stringToHexHash(fmt::format("uid:{}+{}", owner, txHash));
             return result;
         }
 
         std::string BitcoinLikeTransactionDatabaseHelper::putTransaction(soci::session &sql,
-                                                                  const std::string& accountUid,
+                                                                  const std::string& owner,
                                                                   const BitcoinLikeBlockchainExplorerTransaction &tx) {
             auto blockUid = tx.block.map<std::string>([] (const BitcoinLikeBlockchainExplorer::Block& block) {
                                    return block.getUid();
                                });
 
-            auto btcTxUid = createBitcoinTransactionUid(accountUid, tx.hash);
+            auto btcTxUid = createBitcoinTransactionUid(owner, tx.hash);
 
-            if (transactionExists(sql, btcTxUid)) {
+            if (tx.block.nonEmpty()) {
+                BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
+            }
+            soci::statement insertion = (sql.prepare << insertOrIgnore(sql, "bitcoin_transactions", "VALUES("
+                    ":tx_uid, :hash, :version, :block_uid, :time, :locktime"
+                    ")", "transaction_uid"),
+                    use(btcTxUid),
+                    use(tx.hash),
+                    use(tx.version),
+                    use(blockUid),
+                    use(tx.receivedAt),
+                    use(tx.lockTime));
+            insertion.execute(true);
+            if (insertion.get_affected_rows() > 0) {
+                insertOutputs(sql, btcTxUid, tx.hash, tx.outputs);
+                insertInputs(sql, btcTxUid, owner, tx.hash, tx.inputs);
+            } else if (tx.block.nonEmpty()) {
                 // UPDATE (we only update block information)
-                if (tx.block.nonEmpty()) {
-                    sql << "UPDATE bitcoin_transactions SET block_uid = :uid WHERE hash = :tx_hash",
-                            use(blockUid), use(tx.hash);
-                }
-                return btcTxUid;
-            } else {
-                // Insert
-                if (tx.block.nonEmpty()) {
-                    BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
-                }
-                sql << "INSERT INTO bitcoin_transactions VALUES("
-                        ":tx_uid, :hash, :version, :block_uid, :time, :locktime"
-                        ")",
-                        use(btcTxUid),
-                        use(tx.hash),
-                        use(tx.version),
-                        use(blockUid),
-                        use(tx.receivedAt),
-                        use(tx.lockTime);
-                // Insert outputs
-                for (const auto& output : tx.outputs) {
-                    insertOutput(sql, btcTxUid, tx.hash, output);
-                }
-                // Insert inputs
-                for (const auto& input : tx.inputs) {
-                    insertInput(sql, btcTxUid, accountUid, tx.hash, input);
-                }
-                return btcTxUid;
+                sql << "UPDATE bitcoin_transactions SET block_uid = :uid WHERE transaction_uid = :tx_uid",
+                        use(blockUid), use(btcTxUid);
+            }
+            return btcTxUid;
+        }
+
+        void BitcoinLikeTransactionDatabaseHelper::insertOutputs(soci::session &sql,
+                                                                 const std::string& btcTxUid,
+                                                                 const std::string& transactionHash,
+                                                                 const std::vector<BitcoinLikeBlockchainExplorerOutput> &outputs) {
+            std::vector<std::pair<const BitcoinLikeBlockchainExplorerOutput *, uint64_t>> rows;
+            rows.reserve(outputs.size());
+            for (const auto& output : outputs) {
+                rows.emplace_back(&output, output.value.toUint64());
             }
+            // Outputs are attached to accounts by bitcoin_account_outputs
+            const Option<std::string> accountUid;
+            bulkInsert(sql, "bitcoin_outputs", 7, rows,
+                       [&] (soci::statement& statement, const std::pair<const BitcoinLikeBlockchainExplorerOutput *, uint64_t>& row) {
+                auto& output = *row.first;
+                statement.exchange(use(output.index));
+                statement.exchange(use(btcTxUid));
+                statement.exchange(use(transactionHash));
+                statement.exchange(use(row.second));
+                statement.exchange(use(output.script));
+                statement.exchange(use(output.address));
+                statement.exchange(use(accountUid));
+            });
         }
 
-        void BitcoinLikeTransactionDatabaseHelper::insertOutput(soci::session &sql,
+        void BitcoinLikeTransactionDatabaseHelper::insertInputs(soci::session &sql,
                                                                 const std::string& btcTxUid,
+                                                                const std::string& owner,
                                                                 const std::string& transactionHash,
-                                                                const BitcoinLikeBlockchainExplorerOutput &output) {
-            auto value = output.value.toUint64();
-            sql << "INSERT INTO bitcoin_outputs VALUES(:idx, :tx_uid, :hash, :amount, :script, :address, NULL)",
-                    use(output.index), use(btcTxUid),
-                    use(transactionHash), use(value),
-                    use(output.script), use(output.address);
-        }
+                                                                const std::vector<BitcoinLikeBlockchainExplorerInput> &inputs) {
+            struct InputRow {
+                const BitcoinLikeBlockchainExplorerInput* input;
+                std::string uid;
+                std::string prevBtcTxUid;
+                Option<uint64_t> amount;
+            };
+            std::vector<InputRow> rows;
+            rows.reserve(inputs.size());
+            for (const auto& input : inputs) {
+                /*
+                 * In case transactions are issued with respect to zero knowledge protocol,
+                 * previousTxHash is empty which causes conflict in bitcoin_inputs table
+                 * Right now we generate a random 'hash' to compute inputUid, should be improved
+                 * (e.g. use scriptSig of each input and sha256 it ...)
+                */
 
-        void BitcoinLikeTransactionDatabaseHelper::insertInput(soci::session &sql,
-                                                               const std::string& btcTxUid,
-                                                               const std::string& accountUid,
-                                                               const std::string& transactionHash,
-                                                               const BitcoinLikeBlockchainExplorerInput &input) {
-            /*
-             * In case transactions are issued with respect to zero knowledge protocol,
-             * previousTxHash is empty which causes conflict in bitcoin_inputs table
-             * Right now we generate a random 'hash' to compute inputUid, should be improved
-             * (e.g. use scriptSig of each input and sha256 it ...)
-            */
-            std::string hash;
-
-            //Returned by explorers when tx from zk protocol
-            std::string emptyPreviousTxHash = "0000000000000000000000000000000000000000000000000000000000000000";
-            auto previousTxHash = input.previousTxHash.getValueOr(emptyPreviousTxHash);
-            if (previousTxHash == emptyPreviousTxHash && input.signatureScript.nonEmpty()) {
-                previousTxHash =  SHA256::stringToHexHash(input.signatureScript.getValue());
-            }
+                //Returned by explorers when tx from zk protocol
+                std::string emptyPreviousTxHash = "0000000000000000000000000000000000000000000000000000000000000000";
+                auto previousTxHash = input.previousTxHash.getValueOr(emptyPreviousTxHash);
+                if (previousTxHash == emptyPreviousTxHash && input.signatureScript.nonEmpty()) {
+                    previousTxHash =  SHA256::stringToHexHash(input.signatureScript.getValue());
+                }
 
-            auto uid = createInputUid(accountUid,
-                                      input.previousTxOutputIndex.getValueOr(0),
-                                      previousTxHash,
-                                      input.coinbase.getValueOr(""));
+                InputRow row;
+                row.input = &input;
+                row.uid = createInputUid(owner,
+                                         input.previousTxOutputIndex.getValueOr(0),
+                                         previousTxHash,
+                                         input.coinbase.getValueOr(""));
+                row.amount = input.value.map<uint64_t>([] (const BigInt& v) {
+                    return v.toUint64();
+                });
+                if (input.previousTxHash.nonEmpty() && input.previousTxHash.getValue() != emptyPreviousTxHash) {
+                    row.prevBtcTxUid = createBitcoinTransactionUid(owner, input.previousTxHash.getValue());
+                }
+                rows.push_back(std::move(row));
+            }
 
-            auto amount = input.value.map<uint64_t>([] (const BigInt& v) {
-                return v.toUint64();
+            bulkInsert(sql, "bitcoin_inputs", 8, rows, [] (soci::statement& statement, const InputRow& row) {
+                auto& input = *row.input;
+                statement.exchange(use(row.uid));
+                statement.exchange(use(input.previousTxOutputIndex));
+                statement.exchange(use(input.previousTxHash));
+                statement.exchange(use(row.prevBtcTxUid));
+                statement.exchange(use(row.amount));
+                statement.exchange(use(input.address));
+                statement.exchange(use(input.coinbase));
+                statement.exchange(use(input.sequence));
             });
+            bulkInsert(sql, "bitcoin_transaction_inputs", 4, rows, [&] (soci::statement& statement, const InputRow& row) {
+                statement.exchange(use(btcTxUid));
+                statement.exchange(use(transactionHash));
+                statement.exchange(use(row.uid));
+                statement.exchange(use(row.input->index));
+            });
+        }
 
-            std::string prevBtcTxUid;
-            if (input.previousTxHash.nonEmpty() && input.previousTxHash.getValue() != emptyPreviousTxHash) {
-                prevBtcTxUid = createBitcoinTransactionUid(accountUid, input.previousTxHash.getValue());
-            }
-
-            sql << "INSERT INTO bitcoin_inputs VALUES(:uid, :idx, :hash, :prev_tx_uid, :amount, :address, :coinbase, :sequence)",
-                    use(uid), use(input.previousTxOutputIndex), use(input.previousTxHash), use(prevBtcTxUid), use(amount),
-                    use(input.address), use(input.coinbase), use(input.sequence);
-            sql << "INSERT INTO bitcoin_transaction_inputs VALUES(:tx_uid, :tx_hash, :input_uid, :input_idx)",
-                    use(btcTxUid), use(transactionHash), use(uid), use(input.index);
+        void BitcoinLikeTransactionDatabaseHelper::putAccountOutputs(soci::session &sql,
+                                                                     const std::string &accountUid,
+                                                                     const std::string &btcTxUid,
+                                                                     const std::vector<uint64_t> &outputIndexes) {
+            bulkInsert(sql, "bitcoin_account_outputs", 3, outputIndexes, [&] (soci::statement& statement, const uint64_t& index) {
+                statement.exchange(use(accountUid));
+                statement.exchange(use(btcTxUid));
+                statement.exchange(use(index));
+            }, true);
         }
 
-        std::string BitcoinLikeTransactionDatabaseHelper::createInputUid(const std::string& accountUid,
+        std::string BitcoinLikeTransactionDatabaseHelper::createInputUid(const std::string& owner,
                                                                          int32_t previousOutputIndex,
                                                                          const std::string &previousTxHash,
                                                                          const std::string &coinbase) {
-            return SHA256::stringToHexHash(fmt::format("uid:{}+{}+{}+{}", accountUid, previousOutputIndex, previousTxHash, coinbase));
+            return SHA256::stringToHexHash(fmt::format("uid:{}+{}+{}+{}", owner, previousOutputIndex, previousTxHash, coinbase));
         }
 
         bool BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(soci::session &sql,
                                                                         const std::string &hash,
-                                                                        const std::string &accountUid,
+                                                                        const std::string &owner,
                                                                         BitcoinLikeBlockchainExplorerTransaction &out) {
+            if (getTransactionByUid(sql, createBitcoinTransactionUid(owner, hash), out)) {
+                return true;
+            }
+            // Rows stored under another owner (e.g. before the storage layout was chosen) are still found by hash
+            Option<std::string> btcTxUid;
+            sql << "SELECT transaction_uid FROM bitcoin_transactions WHERE hash = :hash LIMIT 1", use(hash), into(btcTxUid);
+            return btcTxUid.nonEmpty() && getTransactionByUid(sql, btcTxUid.getValue(), out);
+        }
+
+        bool BitcoinLikeTransactionDatabaseHelper::getTransactionByUid(soci::session &sql,
+                                                                       const std::string &btcTxUid,
+                                                                       BitcoinLikeBlockchainExplorerTransaction &out) {
             rowset<row> rows = (sql.prepare <<
                     "SELECT  tx.hash, tx.version, tx.time, tx.locktime, "
                             "block.hash, block.height, block.time, block.currency_name "
                             "FROM bitcoin_transactions AS tx "
                             "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
-                            "WHERE tx.hash = :hash", use(hash)
+                            "WHERE tx.transaction_uid = :uid", use(btcTxUid)
             );
             for (auto& row : rows) {
-                inflateTransaction(sql, row, accountUid, out);
+                inflateTransaction(sql, row, btcTxUid, out);
                 return true;
             }
             return false;
@@ -175,7 +225,7 @@ namespace ledger {
 
         bool BitcoinLikeTransactionDatabaseHelper::inflateTransaction(soci::session &sql,
                                                                       const soci::row &row,
-                                                                      const std::string &accountUid,
+                                                                      const std::string &btcTxUid,
                                                                       BitcoinLikeBlockchainExplorerTransaction &out) {
             out.hash = row.get<std::string>(0);
             out.version = (uint32_t) row.get<int32_t>(1);
@@ -195,7 +245,7 @@ namespace ledger {
                         "i.sequence "
                 "FROM bitcoin_transaction_inputs AS ti "
                 "JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
-                "WHERE ti.transaction_hash = :hash ORDER BY ti.input_idx", use(out.hash)
+                "WHERE ti.transaction_uid = :uid ORDER BY ti.input_idx", use(btcTxUid)
             );
             for (auto& inputRow : inputRows) {
                 BitcoinLikeBlockchainExplorerInput input;
@@ -215,22 +265,16 @@ namespace ledger {
 
             // Fetch outputs
             rowset<soci::row> outputRows = (sql.prepare <<
-                    "SELECT idx, amount, script, address, transaction_uid FROM bitcoin_outputs WHERE transaction_hash = :hash "
-                    "ORDER BY idx", use(out.hash)
+                    "SELECT idx, amount, script, address FROM bitcoin_outputs WHERE transaction_uid = :uid "
+                    "ORDER BY idx", use(btcTxUid)
             );
             for (auto& outputRow : outputRows) {
-                //Check if the output belongs to this account
-                //solve case of 2 accounts in DB one as sender and one as receiver
-                //of same transaction (filter on account_uid won't solve the issue because
-                //bitcoin_outputs going to external accounts have NULL account_uid)
-                if (outputRow.get<std::string>(4) == BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(accountUid, out.hash)) {
-                    BitcoinLikeBlockchainExplorerOutput output;
-                    output.index = (uint64_t) outputRow.get<int>(0);
-                    output.value.assignScalar(outputRow.get<long long>(1));
-                    output.script = outputRow.get<std::string>(2);
-                    output.address = outputRow.get<Option<std::string>>(3);
-                    out.outputs.push_back(std::move(output));
-                }
+                BitcoinLikeBlockchainExplorerOutput output;
+                output.index = (uint64_t) outputRow.get<int>(0);
+                output.value.assignScalar(outputRow.get<long long>(1));
+                output.script = outputRow.get<std::string>(2);
+                output.address = outputRow.get<Option<std::string>>(3);
+                out.outputs.push_back(std::move(output));
             }
 
             // Enjoy the silence.
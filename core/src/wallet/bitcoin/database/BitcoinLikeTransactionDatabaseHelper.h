@@ -36,30 +36,43 @@
 
 namespace ledger {
     namespace core {
+        /**
+         * Raw transactions (with their inputs and outputs) are stored once per owner: the account uid, or the currency
+         * name when the wallet shares transactions between accounts (see Configuration::SHARED_TRANSACTION_STORAGE).
+         * Accounts are linked to their transactions by bitcoin_operations and to their outputs by bitcoin_account_outputs.
+         */
         class BitcoinLikeTransactionDatabaseHelper {
         public:
             static bool transactionExists(soci::session& sql, const std::string& btcTxUid);
-            static std::string putTransaction(soci::session& sql, const std::string& accountUid, const BitcoinLikeBlockchainExplorerTransaction& tx);
-            static inline void insertOutput(soci::session& sql,
+            static std::string putTransaction(soci::session& sql, const std::string& owner, const BitcoinLikeBlockchainExplorerTransaction& tx);
+            static inline void insertOutputs(soci::session& sql,
+                                             const std::string& btcTxUid,
+                                             const std::string& transactionHash,
+                                             const std::vector<BitcoinLikeBlockchainExplorerOutput>& outputs);
+            static inline void insertInputs(soci::session& sql,
                                             const std::string& btcTxUid,
+                                            const std::string& owner,
                                             const std::string& transactionHash,
-                                            const BitcoinLikeBlockchainExplorerOutput& output);
-            static inline void insertInput(soci::session& sql,
-                                           const std::string& btcTxUid,
-                                           const std::string& accountUid,
-                                           const std::string& transactionHash,
-                                           const BitcoinLikeBlockchainExplorerInput& input);
+                                            const std::vector<BitcoinLikeBlockchainExplorerInput>& inputs);
+            /// Attach outputs of a stored transaction to the account receiving them
+            static void putAccountOutputs(soci::session& sql,
+                                          const std::string& accountUid,
+                                          const std::string& btcTxUid,
+                                          const std::vector<uint64_t>& outputIndexes);
 
-            static std::string createInputUid(const std::string& accountUid, int32_t previousOutputIndex, const std::string& previousTxHash, const std::string& coinbase);
-            static std::string createBitcoinTransactionUid(const std::string& accountUid, const std::string& txHash);
+            static std::string createInputUid(const std::string& owner, int32_t previousOutputIndex, const std::string& previousTxHash, const std::string& coinbase);
+            static std::string createBitcoinTransactionUid(const std::string& owner, const std::string& txHash);
             static bool getTransactionByHash(soci::session &sql,
                                              const std::string &hash,
-                                             const std::string &accountUid,
+                                             const std::string &owner,
                                              BitcoinLikeBlockchainExplorerTransaction &out);
+            static bool getTransactionByUid(soci::session &sql,
+                                            const std::string &btcTxUid,
+                                            BitcoinLikeBlockchainExplorerTransaction &out);
 
             static inline bool inflateTransaction(soci::session& sql,
                                                   const soci::row& row,
-                                                  const std::string &accountUid,
+                                                  const std::string &btcTxUid,
                                                   BitcoinLikeBlockchainExplorerTransaction& out);
         };
     }
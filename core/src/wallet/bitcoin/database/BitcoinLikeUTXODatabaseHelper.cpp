@@ -42,10 +42,11 @@ namespace ledger {
         std::size_t BitcoinLikeUTXODatabaseHelper::UTXOcount(soci::session &sql, const std::string &accountUid,
                                                              std::function<bool(const std::string &address)> filter) {
             rowset<row> rows = (sql.prepare <<
-                                            "SELECT o.address FROM bitcoin_outputs AS o "
+                                            "SELECT o.address FROM bitcoin_account_outputs AS ao "
+                                                    " JOIN bitcoin_outputs AS o ON o.transaction_uid = ao.transaction_uid AND o.idx = ao.idx"
                                                     " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid "
                                                     " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid", use(accountUid));
+                                                    " WHERE i.previous_tx_uid IS NULL AND ao.account_uid = :uid", use(accountUid));
             std::size_t count = 0;
             for (auto& row : rows) {
                 if (row.get_indicator(0) != i_null && filter(row.get<std::string>(0)))
@@ -60,10 +61,11 @@ namespace ledger {
                                                  std::function<bool(const std::string &address)> filter) {
             rowset<row> rows = (sql.prepare <<
                                             "SELECT o.address, o.idx, o.transaction_hash, o.amount, o.script"
-                                                    " FROM bitcoin_outputs AS o "
+                                                    " FROM bitcoin_account_outputs AS ao "
+                                                    " JOIN bitcoin_outputs AS o ON o.transaction_uid = ao.transaction_uid AND o.idx = ao.idx"
                                                     " LEFT OUTER JOIN bitcoin_inputs AS i ON  i.previous_tx_uid = o.transaction_uid "
                                                     " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid", use(accountUid));
+                                                    " WHERE i.previous_tx_uid IS NULL AND ao.account_uid = :uid", use(accountUid));
 
             std::size_t c = 0;
             std::size_t o = 0;
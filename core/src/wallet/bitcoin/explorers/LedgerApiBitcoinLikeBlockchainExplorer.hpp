@@ -81,9 +81,11 @@ namespace ledger {
             api::BitcoinLikeNetworkParameters getNetworkParameters() const override;
             std::string getExplorerVersion() const override;
             Future<std::vector<std::shared_ptr<api::BigInt>>> getFees() override;
+            void onNewBlock(const Block& block) override;
         private:
             api::BitcoinLikeNetworkParameters _parameters;
             std::string _explorerVersion;
+            ExpiringCache<std::vector<std::shared_ptr<api::BigInt>>> _feesCache {std::chrono::seconds(30)};
         };
     }
 }
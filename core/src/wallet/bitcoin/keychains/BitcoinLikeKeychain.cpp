@@ -46,8 +46,12 @@ namespace ledger {
         bool BitcoinLikeKeychain::markAsUsed(const std::vector<std::string> &addresses) {
             bool result = false;
             for (auto& address : addresses) {
-                result = markAsUsed(address) || result;
+                auto path = getAddressDerivationPath(address);
+                if (path.nonEmpty()) {
+                    result = markPathAsUsed(DerivationPath(path.getValue())) || result;
+                }
             }
+            persistState();
             return result;
         }
 
@@ -87,7 +91,9 @@ namespace ledger {
         bool BitcoinLikeKeychain::markAsUsed(const std::string &address) {
             auto path = getAddressDerivationPath(address);
             if (path.nonEmpty()) {
-                return markPathAsUsed(DerivationPath(path.getValue()));
+                auto result = markPathAsUsed(DerivationPath(path.getValue()));
+                persistState();
+                return result;
             } else {
                 return false;
             }
@@ -65,7 +65,10 @@ namespace ledger {
 
             virtual bool markAsUsed(const std::vector<std::string>& addresses);
             virtual bool markAsUsed(const std::string& address);
+            // Mark a path as used in memory; call persistState to save the change.
             virtual bool markPathAsUsed(const DerivationPath& path) = 0;
+            // Persist the paths marked as used since the last call.
+            virtual void persistState() = 0;
 
             virtual std::vector<Address> getAllObservableAddresses(uint32_t from, uint32_t to)  = 0;
             virtual std::vector<Address> getAllObservableAddresses(KeyPurpose purpose, uint32_t from, uint32_t to) = 0;
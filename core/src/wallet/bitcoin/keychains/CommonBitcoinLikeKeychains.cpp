@@ -32,6 +32,7 @@
 #include "cereal/cereal.hpp"
 #include "cereal/archives/binary.hpp"
 #include "cereal/types/set.hpp"
+#include "cereal/types/vector.hpp"
 #include "boost/iostreams/device/array.hpp"
 #include "boost/iostreams/stream.hpp"
 #include "fmt/format.h"
@@ -48,6 +49,16 @@ using namespace std;
 
 namespace ledger {
     namespace core {
+        namespace {
+            const std::string STATE_KEY = "state";
+            const std::string STATE_JOURNAL_SIZE_KEY = "state_journal_size";
+            // Number of journal entries after which they are merged back into the state
+            const int32_t STATE_JOURNAL_MAX_SIZE = 64;
+
+            std::string getStateJournalKey(int32_t index) {
+                return fmt::format("state_journal:{}", index);
+            }
+        }
 
         CommonBitcoinLikeKeychains::CommonBitcoinLikeKeychains(const std::shared_ptr<api::DynamicObject> &configuration,
                                                                const api::Currency &params,
@@ -73,7 +84,7 @@ namespace ledger {
             }
 
             // Try to restore the state from preferences
-            auto state = preferences->getData("state", {});
+            auto state = preferences->getData(STATE_KEY, {});
             if (!state.empty()) {
                 boost::iostreams::array_source my_vec_source(reinterpret_cast<char*>(&state[0]), state.size());
                 boost::iostreams::stream<boost::iostreams::array_source> is(my_vec_source);
@@ -84,38 +95,71 @@ namespace ledger {
                 _state.maxConsecutiveChangeIndex = 0;
                 _state.empty = true;
             }
+            // Replay the indexes journaled since the state was saved
+            _journalSize = preferences->getInt(STATE_JOURNAL_SIZE_KEY, 0);
+            for (auto index = 0; index < _journalSize; index++) {
+                auto delta = preferences->getObject<KeychainStateDelta>(getStateJournalKey(index));
+                if (delta.hasValue()) {
+                    for (auto receiveIndex : delta.getValue().receiveIndexes) {
+                        markIndexAsUsed(KeyPurpose::RECEIVE, receiveIndex);
+                    }
+                    for (auto changeIndex : delta.getValue().changeIndexes) {
+                        markIndexAsUsed(KeyPurpose::CHANGE, changeIndex);
+                    }
+                }
+            }
             _observableRange = (uint32_t) configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE).value_or(20);
         }
 
         bool CommonBitcoinLikeKeychains::markPathAsUsed(const DerivationPath &p) {
             DerivationPath path(p);
-            if (path.getParent().getLastChildNum() == 0) {
-                if (path.getLastChildNum() < _state.maxConsecutiveReceiveIndex ||
-                    _state.nonConsecutiveReceiveIndexes.find(path.getLastChildNum()) != _state.nonConsecutiveReceiveIndexes.end()) {
-                    return false;
-                } else {
-                    if (path.getLastChildNum() == _state.maxConsecutiveReceiveIndex)
-                        _state.maxConsecutiveReceiveIndex += 1;
-                    else
-                        _state.nonConsecutiveReceiveIndexes.insert(path.getLastChildNum());
-                    _state.empty = false;
-                    saveState();
-                    getAllObservableAddresses(path.getLastChildNum(), path.getLastChildNum() + _observableRange);
-                    return true;
+            auto purpose = path.getParent().getLastChildNum() == 0 ? KeyPurpose::RECEIVE : KeyPurpose::CHANGE;
+            auto index = path.getLastChildNum();
+            if (!markIndexAsUsed(purpose, index)) {
+                return false;
+            }
+            if (purpose == KeyPurpose::RECEIVE) {
+                _pendingDelta.receiveIndexes.push_back(index);
+            } else {
+                _pendingDelta.changeIndexes.push_back(index);
+            }
+            extendObservableRange(index);
+            return true;
+        }
+
+        bool CommonBitcoinLikeKeychains::markIndexAsUsed(KeyPurpose purpose, uint32_t index) {
+            auto& maxConsecutiveIndex = purpose == KeyPurpose::RECEIVE ? _state.maxConsecutiveReceiveIndex : _state.maxConsecutiveChangeIndex;
+            auto& nonConsecutiveIndexes = purpose == KeyPurpose::RECEIVE ? _state.nonConsecutiveReceiveIndexes : _state.nonConsecutiveChangeIndexes;
+            if (index < maxConsecutiveIndex || nonConsecutiveIndexes.find(index) != nonConsecutiveIndexes.end()) {
+                return false;
+            }
+            if (index == maxConsecutiveIndex) {
+                maxConsecutiveIndex += 1;
+                // Absorb the indexes which are now consecutive
+                auto it = nonConsecutiveIndexes.find(maxConsecutiveIndex);
+                while (it != nonConsecutiveIndexes.end()) {
+                    nonConsecutiveIndexes.erase(it);
+                    maxConsecutiveIndex += 1;
+                    it = nonConsecutiveIndexes.find(maxConsecutiveIndex);
                 }
             } else {
-                if (path.getLastChildNum() < _state.maxConsecutiveChangeIndex ||
-                    _state.nonConsecutiveChangeIndexes.find(path.getLastChildNum()) != _state.nonConsecutiveChangeIndexes.end()) {
-                    return false;
-                } else {
-                    if (path.getLastChildNum() == _state.maxConsecutiveChangeIndex)
-                        _state.maxConsecutiveChangeIndex += 1;
-                    else
-                        _state.nonConsecutiveChangeIndexes.insert(path.getLastChildNum());
-                    _state.empty = false;
-                    saveState();
-                    getAllObservableAddresses(path.getLastChildNum(), path.getLastChildNum() + _observableRange);
-                    return true;
+                nonConsecutiveIndexes.insert(index);
+            }
+            _state.empty = false;
+            return true;
+        }
+
+        void CommonBitcoinLikeKeychains::extendObservableRange(uint32_t index) {
+            // Only derive the addresses of the window which were not derived yet
+            auto last = index + _observableRange;
+            if (_observedIndexes.size() <= last) {
+                _observedIndexes.resize(last + 1, false);
+            }
+            for (auto i = index; i <= last; i++) {
+                if (!_observedIndexes[i]) {
+                    derive(KeyPurpose::RECEIVE, i);
+                    derive(KeyPurpose::CHANGE, i);
+                    _observedIndexes[i] = true;
                 }
             }
         }
@@ -187,20 +231,29 @@ namespace ledger {
             return result;
         }
 
-        void CommonBitcoinLikeKeychains::saveState() {
-            while (_state.nonConsecutiveReceiveIndexes.find(_state.maxConsecutiveReceiveIndex) != _state.nonConsecutiveReceiveIndexes.end()) {
-                _state.nonConsecutiveReceiveIndexes.erase(_state.maxConsecutiveReceiveIndex);
-                _state.maxConsecutiveReceiveIndex += 1;
+        void CommonBitcoinLikeKeychains::persistState() {
+            if (_pendingDelta.receiveIndexes.empty() && _pendingDelta.changeIndexes.empty()) {
+                return;
             }
-            while (_state.nonConsecutiveChangeIndexes.find(_state.maxConsecutiveChangeIndex) != _state.nonConsecutiveChangeIndexes.end()) {
-                _state.nonConsecutiveChangeIndexes.erase(_state.maxConsecutiveChangeIndex);
-                _state.maxConsecutiveChangeIndex += 1;
+            auto editor = getPreferences()->editor();
+            if (_journalSize + 1 >= STATE_JOURNAL_MAX_SIZE) {
+                // Compact the journal: save the whole state and drop the journal entries
+                std::stringstream is;
+                ::cereal::BinaryOutputArchive archive(is);
+                archive(_state);
+                auto savedState = is.str();
+                editor->putData(STATE_KEY, std::vector<uint8_t>((const uint8_t *)savedState.data(),(const uint8_t *)savedState.data() + savedState.size()));
+                for (auto index = 0; index < _journalSize; index++) {
+                    editor->remove(getStateJournalKey(index));
+                }
+                _journalSize = 0;
+            } else {
+                editor->putObject(getStateJournalKey(_journalSize), _pendingDelta);
+                _journalSize += 1;
             }
-            std::stringstream is;
-            ::cereal::BinaryOutputArchive archive(is);
-            archive(_state);
-            auto savedState = is.str();
-            getPreferences()->edit()->putData("state", std::vector<uint8_t>((const uint8_t *)savedState.data(),(const uint8_t *)savedState.data() + savedState.size()))->commit();
+            editor->putInt(STATE_JOURNAL_SIZE_KEY, _journalSize);
+            editor->commit();
+            _pendingDelta = KeychainStateDelta();
         }
 
         std::shared_ptr<api::BitcoinLikeExtendedPublicKey> CommonBitcoinLikeKeychains::getExtendedPublicKey() const {
@@ -239,24 +292,27 @@ namespace ledger {
             auto cacheKey = fmt::format("path:{}", localPath);
             auto address = getPreferences()->getString(cacheKey, "");
 
-            if (address.empty()) {
-
-                auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose)
-                        .setAddressIndex((int) index).getPath().toString();
-                auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                // Feed path -> address cache
-                // Feed address -> path cache
-                getPreferences()
-                        ->edit()
-                        ->putString(cacheKey, address)
-                        ->putString(fmt::format("address:{}", address), localPath)
-                        ->commit();
+            if (!address.empty()) {
+                return std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, currency, Option<std::string>(localPath)));
             }
-            return std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, getCurrency(), Option<std::string>(localPath)));
+
+            auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
+                    .setAccountIndex(getAccountIndex())
+                    .setCoinType(currency.bip44CoinType)
+                    .setNode(iPurpose)
+                    .setAddressIndex((int) index).getPath();
+            auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
+            // Build the address from the derived key instead of parsing back its encoded form
+            auto derivedAddress = BitcoinLikeAddress::fromPublicKey(xpub->deriveKey(p), currency, _keychainEngine, Option<std::string>(localPath));
+            address = derivedAddress->toString();
+            // Feed path -> address cache
+            // Feed address -> path cache
+            getPreferences()
+                    ->edit()
+                    ->putString(cacheKey, address)
+                    ->putString(fmt::format("address:{}", address), localPath)
+                    ->commit();
+            return derivedAddress;
         }
     }
 }
@@ -60,6 +60,18 @@ namespace ledger {
             }
         };
 
+        // Indexes marked as used since the previous persisted state, appended to a journal so
+        // that the whole state is not rewritten for every bulk of transactions.
+        struct KeychainStateDelta {
+            std::vector<uint32_t> receiveIndexes;
+            std::vector<uint32_t> changeIndexes;
+
+            template <class Archive>
+            void serialize(Archive& archive) {
+                archive(receiveIndexes, changeIndexes);
+            }
+        };
+
         class CommonBitcoinLikeKeychains : public BitcoinLikeKeychain {
         public:
             CommonBitcoinLikeKeychains(const std::shared_ptr<api::DynamicObject> &configuration,
@@ -68,6 +80,7 @@ namespace ledger {
                                      const std::shared_ptr<Preferences> &preferences);
 
             bool markPathAsUsed(const DerivationPath &path) override;
+            void persistState() override;
 
             BitcoinLikeKeychain::Address getFreshAddress(KeyPurpose purpose) override;
             std::vector<BitcoinLikeKeychain::Address> getAllObservableAddresses(uint32_t from, uint32_t to) override;
@@ -86,15 +99,20 @@ namespace ledger {
             Option<std::vector<uint8_t>> getPublicKey(const std::string &address) const override;
 
         protected:
-            std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _internalNodeXpub;
-            std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _publicNodeXpub;
+            std::shared_ptr<BitcoinLikeExtendedPublicKey> _internalNodeXpub;
+            std::shared_ptr<BitcoinLikeExtendedPublicKey> _publicNodeXpub;
             uint32_t _observableRange;
             std::string _keychainEngine;
 
         private:
             BitcoinLikeKeychain::Address derive(KeyPurpose purpose, off_t index);
-            void saveState();
+            bool markIndexAsUsed(KeyPurpose purpose, uint32_t index);
+            void extendObservableRange(uint32_t index);
             KeychainPersistentState _state;
+            KeychainStateDelta _pendingDelta;
+            int32_t _journalSize;
+            // Address indexes already derived for both purposes since the keychain was created
+            std::vector<bool> _observedIndexes;
             std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _xpub;
         };
     }
@@ -48,30 +48,51 @@ namespace ledger {
         }
 
         void BitcoinLikeBlockchainObserver::putTransaction(const BitcoinLikeBlockchainExplorerTransaction &tx) {
-            std::lock_guard<std::mutex> lock(_lock);
-            for (const auto& account : _accounts) {
-                account->run([account, tx] () {
-                    soci::session sql(account->getWallet()->getDatabase()->getPool());
-                    if (account->putTransaction(sql, tx) != BitcoinLikeAccount::FLAG_TRANSACTION_IGNORED)
-                        account->emitEventsNow();
-                });
-            }
+            putTransactions({tx});
         }
 
-        void BitcoinLikeBlockchainObserver::putBlock(const BitcoinLikeBlockchainExplorer::Block& block) {
+        void BitcoinLikeBlockchainObserver::putTransactions(const std::vector<BitcoinLikeBlockchainExplorerTransaction> &transactions) {
             std::lock_guard<std::mutex> lock(_lock);
-            for (const auto& account : _accounts) {
-                account->run([account, block] () {
+            for (const auto &account : _accounts) {
+                account->run([account, transactions] () {
                     bool shouldEmitNow = false;
                     {
                         soci::session sql(account->getWallet()->getDatabase()->getPool());
-                        shouldEmitNow = account->putBlock(sql, block);
+                        soci::transaction tr(sql);
+                        for (const auto &tx : transactions) {
+                            if (account->putTransaction(sql, tx) != BitcoinLikeAccount::FLAG_TRANSACTION_IGNORED)
+                                shouldEmitNow = true;
+                        }
+                        tr.commit();
                     }
+                    account->persistPendingState();
                     if (shouldEmitNow)
                         account->emitEventsNow();
                 });
             }
         }
 
+        void BitcoinLikeBlockchainObserver::putBlock(const BitcoinLikeBlockchainExplorer::Block &block) {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_accounts.empty())
+                return;
+            // Explorers cache the current block for the accounts sharing them, refresh it before accounts ask for it
+            for (auto& observed : _accounts) {
+                observed->getExplorer()->onNewBlock(block);
+            }
+            // Blocks are stored per currency and all the observed accounts share the same database,
+            // so a single account writes the block (and emits the new block event).
+            auto account = _accounts.front();
+            account->run([account, block] () {
+                bool shouldEmitNow = false;
+                {
+                    soci::session sql(account->getWallet()->getDatabase()->getPool());
+                    shouldEmitNow = account->putBlock(sql, block);
+                }
+                if (shouldEmitNow)
+                    account->emitEventsNow();
+            });
+        }
+
     }
 }
\ No newline at end of file
@@ -54,6 +54,7 @@ namespace ledger {
 
         protected:
             void putTransaction(const BitcoinLikeBlockchainExplorerTransaction& tx) override ;
+            void putTransactions(const std::vector<BitcoinLikeBlockchainExplorerTransaction>& transactions) override ;
             void putBlock(const BitcoinLikeBlockchainExplorer::Block& block) override ;
 
             const api::Currency& getCurrency() const {
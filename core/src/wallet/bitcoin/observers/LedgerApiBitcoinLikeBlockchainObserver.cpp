@@ -92,15 +92,35 @@ namespace ledger {
 
 
         void LedgerApiBitcoinLikeBlockchainObserver::onMessage(const std::string &message) {
+            // Messages received while the previous ones are still waiting for the observer context
+            // are handled together, so that bursts of transactions are written in grouped DB writes.
+            if (!pushPendingMessage(message))
+                return;
             auto self = shared_from_this();
-            run([message, self] () {
-                auto result = JSONUtils::parse<WebSocketNotificationParser>(message);
-                result->block.currencyName = self->getCurrency().name;
-                if (result->type == "new-transaction") {
-                    self->putTransaction(result->transaction);
-                } else if (result->type == "new-block") {
-                    self->putBlock(result->block);
+            run([self] () {
+                std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions;
+                for (const auto &pendingMessage : self->takePendingMessages()) {
+                    // A malformed frame must not drop the rest of the burst
+                    std::shared_ptr<WebSocketNotificationParser::Result> result;
+                    try {
+                        result = JSONUtils::parse<WebSocketNotificationParser>(pendingMessage);
+                    } catch (const std::exception &ex) {
+                        self->logger()->error("Unable to parse {} observer message: {}", self->getCurrency().name, ex.what());
+                        continue;
+                    }
+                    result->block.currencyName = self->getCurrency().name;
+                    if (result->type == "new-transaction") {
+                        transactions.push_back(result->transaction);
+                    } else if (result->type == "new-block") {
+                        if (!transactions.empty()) {
+                            self->putTransactions(transactions);
+                            transactions.clear();
+                        }
+                        self->putBlock(result->block);
+                    }
                 }
+                if (!transactions.empty())
+                    self->putTransactions(transactions);
             });
         }
 
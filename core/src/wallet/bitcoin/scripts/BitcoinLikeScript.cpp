@@ -76,22 +76,23 @@ namespace ledger {
         }
 
         std::string BitcoinLikeScript::toString() const {
-            std::stringstream ss;
-            bool first = true;
+            std::string result;
             for (auto &chunk : _chunks) {
-                if (!first) {
-                    ss << " ";
-                } else {
-                    first = false;
+                if (!result.empty()) {
+                    result += ' ';
                 }
                 if (chunk.isBytes()) {
                     const auto &bytes = chunk.getBytes();
-                    ss << "PUSHDATA(" << bytes.size() << ")[" << hex::toString(bytes) << "]";
+                    result += "PUSHDATA(";
+                    result += std::to_string(bytes.size());
+                    result += ")[";
+                    result += hex::toString(bytes);
+                    result += ']';
                 } else {
-                    ss << btccore::GetOpName(chunk.getOpCode());
+                    result += btccore::GetOpName(chunk.getOpCode());
                 }
             }
-            return ss.str();
+            return result;
         }
 
         std::vector<uint8_t> BitcoinLikeScript::serialize() const {
@@ -113,7 +114,7 @@ namespace ledger {
                     writer.writeByte(chunk.getOpCode());
                 }
             }
-            return writer.toByteArray();
+            return std::move(writer).toByteArray();
         }
 
         const std::list<BitcoinLikeScriptChunk> &BitcoinLikeScript::toList() const {
@@ -160,7 +161,7 @@ namespace ledger {
                 return _configuration.keychainEngine == api::KeychainEngines::BIP49_P2SH;
             }
             return (size() >= 3 && (*this)[0].isEqualTo(btccore::OP_HASH160) && (*this)[1].sizeEqualsTo(20)
-                    && (*this)[22].isEqualTo(btccore::OP_EQUAL));
+                    && (*this)[2].isEqualTo(btccore::OP_EQUAL));
         }
 
         bool BitcoinLikeScript::isP2WPKH() const {
@@ -227,6 +228,54 @@ namespace ledger {
         }
 
 
+        BitcoinLikeStandardScript BitcoinLikeStandardScript::classify(const BytesView &script) {
+            const auto size = script.size();
+            // OP_DUP OP_HASH160 PUSHDATA(20) OP_EQUALVERIFY OP_CHECKSIG
+            if (size == 25 && script[0] == btccore::OP_DUP && script[1] == btccore::OP_HASH160 && script[2] == 20
+                && script[23] == btccore::OP_EQUALVERIFY && script[24] == btccore::OP_CHECKSIG) {
+                return BitcoinLikeStandardScript(BitcoinLikeScriptTemplate::P2PKH, script.subview(3, 20));
+            }
+            // OP_HASH160 PUSHDATA(20) OP_EQUAL
+            if (size == 23 && script[0] == btccore::OP_HASH160 && script[1] == 20 && script[22] == btccore::OP_EQUAL) {
+                return BitcoinLikeStandardScript(BitcoinLikeScriptTemplate::P2SH, script.subview(2, 20));
+            }
+            // OP_0 PUSHDATA(20)
+            if (size == 22 && script[0] == btccore::OP_0 && script[1] == 20) {
+                return BitcoinLikeStandardScript(BitcoinLikeScriptTemplate::P2WPKH, script.subview(2, 20));
+            }
+            // OP_0 PUSHDATA(32)
+            if (size == 34 && script[0] == btccore::OP_0 && script[1] == 32) {
+                return BitcoinLikeStandardScript(BitcoinLikeScriptTemplate::P2WSH, script.subview(2, 32));
+            }
+            return BitcoinLikeStandardScript();
+        }
+
+        Option<BitcoinLikeAddress> BitcoinLikeScript::parseAddress(const std::vector<uint8_t> &script,
+                                                                   const api::Currency &currency) {
+            auto standardScript = BitcoinLikeStandardScript::classify(script);
+            switch (standardScript.type) {
+                case BitcoinLikeScriptTemplate::P2PKH:
+                    return Option<BitcoinLikeAddress>(BitcoinLikeAddress(
+                            currency, standardScript.hash.toVector(), api::KeychainEngines::BIP32_P2PKH));
+                case BitcoinLikeScriptTemplate::P2SH:
+                    return Option<BitcoinLikeAddress>(BitcoinLikeAddress(
+                            currency, standardScript.hash.toVector(), api::KeychainEngines::BIP49_P2SH));
+                case BitcoinLikeScriptTemplate::P2WPKH:
+                    return Option<BitcoinLikeAddress>(BitcoinLikeAddress(
+                            currency, standardScript.hash.toVector(), api::KeychainEngines::BIP173_P2WPKH));
+                case BitcoinLikeScriptTemplate::P2WSH:
+                    return Option<BitcoinLikeAddress>(BitcoinLikeAddress(
+                            currency, standardScript.hash.toVector(), api::KeychainEngines::BIP173_P2WSH));
+                case BitcoinLikeScriptTemplate::NON_STANDARD:
+                    break;
+            }
+            auto parsedScript = parse(script);
+            if (parsedScript.isFailure()) {
+                return Option<BitcoinLikeAddress>();
+            }
+            return parsedScript.getValue().parseAddress(currency);
+        }
+
         BitcoinLikeScriptChunk::BitcoinLikeScriptChunk(BitcoinLikeScriptOpCode op) : _value(op) {
 
         }
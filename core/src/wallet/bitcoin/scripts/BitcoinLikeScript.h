@@ -38,6 +38,7 @@
 #include <list>
 #include <api/BitcoinLikeNetworkParameters.hpp>
 #include <bitcoin/BitcoinLikeAddress.hpp>
+#include <bytes/BytesView.h>
 
 namespace ledger {
     namespace core {
@@ -66,6 +67,39 @@ namespace ledger {
             Either<std::vector<uint8_t>, BitcoinLikeScriptOpCode> _value;
         };
 
+        enum class BitcoinLikeScriptTemplate {
+            P2PKH,
+            P2SH,
+            P2WPKH,
+            P2WSH,
+            NON_STANDARD
+        };
+
+        /**
+         * Result of the classification of a raw (unsigned) output script against the standard templates. Matching
+         * is done on the serialized bytes, without parsing the script into chunks: hash is a view on the script
+         * given to classify and is only valid as long as it is.
+         */
+        struct BitcoinLikeStandardScript {
+            BitcoinLikeScriptTemplate type;
+            BytesView hash;
+
+            BitcoinLikeStandardScript() : type(BitcoinLikeScriptTemplate::NON_STANDARD) {};
+
+            BitcoinLikeStandardScript(BitcoinLikeScriptTemplate type_, const BytesView &hash_) : type(type_),
+                                                                                                 hash(hash_) {};
+
+            bool isStandard() const {
+                return type != BitcoinLikeScriptTemplate::NON_STANDARD;
+            }
+
+            /**
+             * Recognizes exact P2PKH, P2SH, P2WPKH and P2WSH scripts. Anything else (including standard templates
+             * followed by additional operations, like BIP115 scripts) is reported as NON_STANDARD.
+             */
+            static BitcoinLikeStandardScript classify(const BytesView &script);
+        };
+
         struct BitcoinLikeScriptConfiguration {
             bool isSigned;
             std::string keychainEngine;
@@ -127,6 +161,13 @@ namespace ledger {
 
             static BitcoinLikeScript fromAddress(const std::string &address, const api::Currency &currency);
 
+            /**
+             * Gets the address paid by an unsigned script. Standard templates are matched on the raw bytes, only
+             * non-standard scripts go through a full parse.
+             */
+            static Option<BitcoinLikeAddress> parseAddress(const std::vector<uint8_t> &script,
+                                                           const api::Currency &currency);
+
         private:
             std::list<BitcoinLikeScriptChunk> _chunks;
             BitcoinLikeScriptConfiguration _configuration;
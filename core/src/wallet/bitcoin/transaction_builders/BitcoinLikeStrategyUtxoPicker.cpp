@@ -34,6 +34,7 @@
 #include <api/BitcoinLikeScriptChunk.hpp>
 #include <wallet/bitcoin/api_impl/BitcoinLikeScriptApi.h>
 #include <wallet/bitcoin/api_impl/BitcoinLikeTransactionApi.h>
+#include <async/algorithm.h>
 #include <random>
 namespace ledger {
     namespace core {
@@ -71,21 +72,15 @@ namespace ledger {
 
         Future<BigInt> BitcoinLikeStrategyUtxoPicker::computeAggregatedAmount(
                 const std::shared_ptr<BitcoinLikeUtxoPicker::Buddy> &buddy) {
-            using UDList = std::list<BitcoinLikeUtxoPicker::UTXODescriptor>;
-            static std::function<Future<BigInt> (std::shared_ptr<api::ExecutionContext>, UDList::const_iterator, BigInt, const std::shared_ptr<Buddy>& buddy)> go
-                    = [] (std::shared_ptr<api::ExecutionContext> context, const UDList::const_iterator it, BigInt v, const std::shared_ptr<Buddy>& buddy) mutable -> Future<BigInt> {
-                        if (it == buddy->request.inputs.end())
-                            return Future<BigInt>::successful(v);
-                        const auto& i = *it;
-                        const auto outputIndex = std::get<1>(i);
-                        buddy->logger->info("GET TX 1");
-                        return buddy->getTransaction(String(std::get<0>(i))).flatMap<BigInt>(context, [=] (const std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>& tx) -> Future<BigInt> {
-                            buddy->logger->info("GOT TX 1");
-                            auto newIt = it;
-                            return go(context, newIt++, v + tx->outputs[outputIndex].value, buddy);
-                        });
-            };
-            return go(getContext(), buddy->request.inputs.begin(), BigInt(), buddy);
+            std::vector<BitcoinLikeUtxoPicker::UTXODescriptor> inputs(buddy->request.inputs.begin(), buddy->request.inputs.end());
+            return core::async::foldLeft<BitcoinLikeUtxoPicker::UTXODescriptor, BigInt>(getContext(), inputs, BigInt(), [buddy] (const BigInt& v, const BitcoinLikeUtxoPicker::UTXODescriptor& input) -> Future<BigInt> {
+                const auto outputIndex = std::get<1>(input);
+                buddy->logger->info("GET TX 1");
+                return buddy->getTransaction(String(std::get<0>(input))).map<BigInt>(ImmediateExecutionContext::INSTANCE, [=] (const std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>& tx) -> BigInt {
+                    buddy->logger->info("GOT TX 1");
+                    return v + tx->outputs[outputIndex].value;
+                });
+            });
         }
 
         Future<BitcoinLikeUtxoPicker::UTXODescriptorList>
@@ -97,27 +92,19 @@ namespace ledger {
             using RichUTXOList = std::vector<RichUTXO>;
             std::shared_ptr<RichUTXOList> richutxo = std::make_shared<RichUTXOList>();
 
-            static Future<Unit> (*go)(std::shared_ptr<api::ExecutionContext> context, int index, const std::shared_ptr<Buddy>& buddy, const std::vector<std::shared_ptr<api::BitcoinLikeOutput>> &utxo, std::shared_ptr<RichUTXOList>)
-            = [] (std::shared_ptr<api::ExecutionContext> context, int index, const std::shared_ptr<Buddy>& buddy, const std::vector<std::shared_ptr<api::BitcoinLikeOutput>> &utxo, std::shared_ptr<RichUTXOList> richutxo) -> Future<Unit> {
-                if (index >= utxo.size()) {
-                    return Future<Unit>::successful(unit);
-                }
-                auto hash = utxo[index]->getTransactionHash();
+            return core::async::forEach<std::shared_ptr<api::BitcoinLikeOutput>>(getContext(), utxo, [buddy, richutxo] (const std::shared_ptr<api::BitcoinLikeOutput>& output) -> Future<Unit> {
+                auto hash = output->getTransactionHash();
                 buddy->logger->info("GET TX 2");
-                return buddy->getTransaction(hash).flatMap<Unit>(context, [=] (const std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>& tx) mutable -> Future<Unit> {
+                return buddy->getTransaction(hash).map<Unit>(ImmediateExecutionContext::INSTANCE, [=] (const std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>& tx) -> Unit {
                     buddy->logger->info("GOT TX 2");
                     uint64_t block_height = (tx->block.nonEmpty()) ? tx->block.getValue().height :
                                             std::numeric_limits<uint64_t>::max();
                     //Fix: use uniform initialization
-                    RichUTXO curr_richutxo{block_height, utxo[index]};
+                    RichUTXO curr_richutxo{block_height, output};
                     richutxo->emplace_back(std::move(curr_richutxo));
-
-                    buddy->logger->info("Go {} on {}", index + 1, utxo.size());
-                    return go(context, index + 1, buddy, utxo, richutxo);
+                    return unit;
                 });
-            };
-
-            return go(getContext(), 0, buddy, utxo, richutxo).map<UTXODescriptorList>(getContext(), [=] (const Unit& u) -> UTXODescriptorList {
+            }).map<UTXODescriptorList>(getContext(), [=] (const Unit& u) -> UTXODescriptorList {
                 // Sort the list by deep
                 std::sort(richutxo->begin(), richutxo->end(), [] (const RichUTXO& a, const RichUTXO& b) -> bool {
                     return std::get<0>(a) < std::get<0>(b);
@@ -31,6 +31,7 @@
 
 #include "BitcoinLikeUtxoPicker.h"
 #include <async/Promise.hpp>
+#include <async/algorithm.h>
 #include <api/BitcoinLikeScript.hpp>
 #include <api/BitcoinLikeScriptChunk.hpp>
 #include <wallet/bitcoin/api_impl/BitcoinLikeScriptApi.h>
@@ -167,22 +168,14 @@ namespace ledger {
                 return Future<UTXODescriptorList>::successful(std::move(UTXODescriptorList()));
             };
 
-            auto inputs = std::make_shared<UTXODescriptorList>();
-            static std::function<Future<Unit> (int, const std::shared_ptr<UTXODescriptorList>&, const std::shared_ptr<Buddy>&, const std::shared_ptr<BitcoinLikeUtxoPicker>&)> performFill
-            = [] (int index, const std::shared_ptr<UTXODescriptorList>& inputs, const std::shared_ptr<Buddy>& buddy, const std::shared_ptr<BitcoinLikeUtxoPicker>& self) mutable -> Future<Unit> {
-                if (index >= inputs->size())
-                    return Future<Unit>::successful(unit);
-                return self->fillInput(buddy, (*inputs)[index]).flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (const Unit&) {
-                    return performFill(index + 1, inputs, buddy, self);
-                });
+            auto fill = [self, buddy] (const UTXODescriptor& desc) -> Future<Unit> {
+                return self->fillInput(buddy, desc);
             };
-            inputs->insert(inputs->end(), buddy->request.inputs.begin(), buddy->request.inputs.end());
-            return performFill(0, inputs, buddy, self).flatMap<UTXODescriptorList>(ImmediateExecutionContext::INSTANCE, [=] (const Unit&) mutable -> Future<UTXODescriptorList> {
+            UTXODescriptorList inputs(buddy->request.inputs.begin(), buddy->request.inputs.end());
+            return core::async::forEach<UTXODescriptor>(getContext(), inputs, fill).flatMap<UTXODescriptorList>(ImmediateExecutionContext::INSTANCE, [=] (const Unit&) mutable -> Future<UTXODescriptorList> {
                 return pickUtxo();
             }).flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (const UTXODescriptorList& utxo) mutable -> Future<Unit> {
-                auto offset = static_cast<int>(inputs->size());
-                inputs->insert(inputs->end(), utxo.begin(), utxo.end());
-                return performFill(offset, inputs, buddy, self);
+                return core::async::forEach<UTXODescriptor>(self->getContext(), utxo, fill);
             });
         }
 
@@ -36,12 +36,14 @@
 #include <api/ErrorCode.hpp>
 #include <events/Event.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
+#include <wallet/pool/WalletPool.hpp>
 
 namespace ledger {
     namespace core {
 
         AbstractAccount::AbstractAccount(const std::shared_ptr<AbstractWallet> &wallet, int32_t index)
-                : DedicatedContext(wallet->getMainExecutionContext()) {
+                : DedicatedContext(wallet->getPool()->getAccountExecutionContext(
+                        AccountDatabaseHelper::createAccountUid(wallet->getWalletUid(), index))) {
             _uid = AccountDatabaseHelper::createAccountUid(wallet->getWalletUid(), index);
             _logger = wallet->logger();
             _index = index;
@@ -189,6 +191,9 @@ namespace ledger {
             pushEvent(event);
         }
 
+        void AbstractAccount::persistPendingState() {
+        }
+
         void AbstractAccount::emitEventsNow() {
             auto self = shared_from_this();
             run([self] () {
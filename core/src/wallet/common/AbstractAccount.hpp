@@ -99,6 +99,10 @@ namespace ledger {
 
             void emitEventsNow();
 
+            // Persist the state buffered in memory while transactions are put (e.g. the addresses
+            // discovered by a keychain). Called once the database transaction is committed.
+            virtual void persistPendingState();
+
             void eraseDataSince(const std::chrono::system_clock::time_point & date, const std::shared_ptr<api::ErrorCodeCallback> & callback) override ;
             virtual Future<api::ErrorCode> eraseDataSince(const std::chrono::system_clock::time_point & date) = 0;
 
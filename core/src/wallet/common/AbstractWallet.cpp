@@ -42,6 +42,8 @@
 #include <database/soci-date.h>
 #include <database/soci-option.h>
 #include <async/DedicatedContext.hpp>
+#include <events/Event.hpp>
+#include <events/LambdaEventReceiver.hpp>
 namespace ledger {
     namespace core {
         AbstractWallet::AbstractWallet(const std::string &walletName,
@@ -58,6 +60,7 @@ namespace ledger {
             _uid = WalletDatabaseEntry::createWalletUid(pool->getName(), _name);
             _currency = currency;
             _configuration = configuration;
+            _configSnapshot = WalletConfigSnapshot::fromConfiguration(configuration);
             _externalPreferences = pool->getExternalPreferences()->getSubPreferences(
                     fmt::format("wallet_{}", walletName));
             _internalPreferences = pool->getInternalPreferences()->getSubPreferences(
@@ -166,6 +169,10 @@ namespace ledger {
             return _configuration;
         }
 
+        const WalletConfigSnapshot &AbstractWallet::getConfigSnapshot() const {
+            return _configSnapshot;
+        }
+
         const DerivationScheme &AbstractWallet::getDerivationScheme() const {
             return _scheme;
         }
@@ -317,27 +324,19 @@ namespace ledger {
             auto uid = getWalletUid();
             //auto accounts = _accounts;
             _logger->debug("Start erasing data of wallet : {} since : {}", uid, DateUtils::toJSON(date));
-            static std::function<Future<api::ErrorCode> (int , const std::unordered_map<int32_t, std::shared_ptr<AbstractAccount>> &)> eraseAccount = [date] (int index, const std::unordered_map<int32_t, std::shared_ptr<AbstractAccount>> &accountsToErase) -> Future<api::ErrorCode> {
-
-                if (index == accountsToErase.size()) {
-                    return Future<api::ErrorCode>::successful(api::ErrorCode::FUTURE_WAS_SUCCESSFULL);
-                }
-
-                return accountsToErase.at(index)->eraseDataSince(date).flatMap<api::ErrorCode>(ImmediateExecutionContext::INSTANCE,[index, accountsToErase] (const api::ErrorCode &errorCode) -> Future<api::ErrorCode> {
-
+            std::vector<std::shared_ptr<AbstractAccount>> accounts;
+            for (const auto& account : _accounts) {
+                accounts.push_back(account.second);
+            }
+            auto pool = getPool();
+            return core::async::parallelForEach<std::shared_ptr<AbstractAccount>>(pool->getFanOutContext(), accounts, pool->getMaxConcurrentWalletOperations(), [date] (const std::shared_ptr<AbstractAccount> &account) {
+                return account->eraseDataSince(date).map<Unit>(ImmediateExecutionContext::INSTANCE, [] (const api::ErrorCode &errorCode) {
                     if (errorCode != api::ErrorCode::FUTURE_WAS_SUCCESSFULL) {
-                        return Future<api::ErrorCode>::failure(make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase accounts of wallet !"));
+                        throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase accounts of wallet !");
                     }
-
-                    return eraseAccount(index + 1, accountsToErase);
+                    return unit;
                 });
-            };
-            return eraseAccount(0, _accounts).flatMap<api::ErrorCode>(ImmediateExecutionContext::INSTANCE, [self, date, uid] (const api::ErrorCode &err) {
-
-                if (err != api::ErrorCode::FUTURE_WAS_SUCCESSFULL) {
-                    return Future<api::ErrorCode>::failure(make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase accounts of wallet {}", uid));
-                }
-
+            }).flatMap<api::ErrorCode>(ImmediateExecutionContext::INSTANCE, [self, date, uid] (const Unit &) {
                 soci::session sql(self->getDatabase()->getPool());
                 //Remove all accounts created after date
                 soci::rowset<soci::row> accounts = (sql.prepare << "SELECT idx FROM accounts "
@@ -360,5 +359,71 @@ namespace ledger {
             return getConfig();
         }
 
+        bool AbstractWallet::isSynchronizing() {
+            std::lock_guard<std::mutex> lock(_synchronizationLock);
+            return _currentSyncEventBus != nullptr;
+        }
+
+        std::shared_ptr<api::EventBus> AbstractWallet::synchronize() {
+            std::lock_guard<std::mutex> lock(_synchronizationLock);
+            if (_currentSyncEventBus)
+                return _currentSyncEventBus;
+            auto self = shared_from_this();
+            auto pool = getPool();
+            auto eventPublisher = std::make_shared<EventPublisher>(getContext());
+            _currentSyncEventBus = eventPublisher->getEventBus();
+            eventPublisher->postSticky(std::make_shared<Event>(api::EventCode::SYNCHRONIZATION_STARTED, api::DynamicObject::newInstance()), 0);
+
+            // Accounts are synchronized by at most getMaxConcurrentWalletOperations() workers. A failing account
+            // doesn't stop the others: the wallet only reports its status once every account is done.
+            auto failures = std::make_shared<std::atomic<int32_t>>(0);
+            getAccountCount().flatMap<std::vector<std::shared_ptr<api::Account>>>(getContext(), [self] (const int32_t &count) {
+                return self->getAccounts(0, count);
+            }).flatMap<Unit>(getContext(), [pool, failures] (const std::vector<std::shared_ptr<api::Account>> &accounts) {
+                return core::async::parallelForEach<std::shared_ptr<api::Account>>(pool->getFanOutContext(), accounts, pool->getMaxConcurrentWalletOperations(), [failures] (const std::shared_ptr<api::Account> &account) {
+                    auto promise = std::make_shared<Promise<Unit>>();
+                    auto eventBus = account->synchronize();
+                    auto receiver = make_receiver([promise, failures] (const std::shared_ptr<api::Event> &event) {
+                        switch (event->getCode()) {
+                            case api::EventCode::SYNCHRONIZATION_FAILED:
+                                if (promise->trySuccess(unit))
+                                    failures->fetch_add(1);
+                                break;
+                            case api::EventCode::SYNCHRONIZATION_SUCCEED:
+                            case api::EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT:
+                                promise->trySuccess(unit);
+                                break;
+                            default:
+                                break;
+                        }
+                    });
+                    eventBus->subscribe(ImmediateExecutionContext::INSTANCE, receiver);
+                    // The account's bus outlives this synchronization, don't leave a receiver on it for each call
+                    return promise->getFuture().map<Unit>(ImmediateExecutionContext::INSTANCE, [eventBus, receiver] (const Unit&) {
+                        eventBus->unsubscribe(receiver);
+                        return unit;
+                    });
+                });
+            }).onComplete(getContext(), [self, eventPublisher, failures] (const Try<Unit> &result) {
+                auto payload = std::make_shared<DynamicObject>();
+                api::EventCode code = api::EventCode::SYNCHRONIZATION_SUCCEED;
+                if (result.isFailure()) {
+                    code = api::EventCode::SYNCHRONIZATION_FAILED;
+                    payload->putString(api::Account::EV_SYNC_ERROR_CODE, api::to_string(result.getFailure().getErrorCode()));
+                    payload->putInt(api::Account::EV_SYNC_ERROR_CODE_INT, (int32_t)result.getFailure().getErrorCode());
+                    payload->putString(api::Account::EV_SYNC_ERROR_MESSAGE, result.getFailure().getMessage());
+                } else if (failures->load() > 0) {
+                    code = api::EventCode::SYNCHRONIZATION_FAILED;
+                    payload->putString(api::Account::EV_SYNC_ERROR_CODE, api::to_string(api::ErrorCode::RUNTIME_ERROR));
+                    payload->putInt(api::Account::EV_SYNC_ERROR_CODE_INT, (int32_t)api::ErrorCode::RUNTIME_ERROR);
+                    payload->putString(api::Account::EV_SYNC_ERROR_MESSAGE, fmt::format("{} account(s) of wallet {} failed to synchronize", failures->load(), self->getName()));
+                }
+                eventPublisher->postSticky(std::make_shared<Event>(code, payload), 0);
+                std::lock_guard<std::mutex> lock(self->_synchronizationLock);
+                self->_currentSyncEventBus = nullptr;
+            });
+            return eventPublisher->getEventBus();
+        }
+
     }
 }
\ No newline at end of file
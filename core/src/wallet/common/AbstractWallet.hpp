@@ -50,6 +50,8 @@
 #include <api/Block.hpp>
 #include <api/BlockCallback.hpp>
 #include <api/DynamicObject.hpp>
+#include <wallet/common/WalletConfigSnapshot.h>
+#include <mutex>
 
 namespace ledger {
     namespace core {
@@ -124,6 +126,9 @@ namespace ledger {
 
             std::shared_ptr<api::DynamicObject> getConfiguration() override;
 
+            bool isSynchronizing() override;
+            std::shared_ptr<api::EventBus> synchronize() override;
+
             virtual FuturePtr<api::Account> newAccountWithInfo(const api::AccountCreationInfo& info) = 0;
             virtual FuturePtr<api::Account> newAccountWithExtendedKeyInfo(const api::ExtendedKeyAccountCreationInfo& info) = 0;
             virtual Future<api::ExtendedKeyAccountCreationInfo> getExtendedKeyAccountCreationInfo(int32_t accountIndex) = 0;
@@ -141,6 +146,7 @@ namespace ledger {
             virtual std::shared_ptr<api::ExecutionContext> getMainExecutionContext() const;
             virtual std::string getWalletUid() const;
             virtual std::shared_ptr<DynamicObject> getConfig() const;
+            const WalletConfigSnapshot& getConfigSnapshot() const;
             virtual const DerivationScheme& getDerivationScheme() const;
 
         protected:
@@ -159,9 +165,12 @@ namespace ledger {
             api::Currency _currency;
             std::shared_ptr<api::ExecutionContext> _mainExecutionContext;
             std::shared_ptr<DynamicObject> _configuration;
+            WalletConfigSnapshot _configSnapshot;
             DerivationScheme _scheme;
             std::weak_ptr<WalletPool> _pool;
             std::unordered_map<int32_t, std::shared_ptr<AbstractAccount>> _accounts;
+            std::mutex _synchronizationLock;
+            std::shared_ptr<api::EventBus> _currentSyncEventBus;
 
         };
     }
@@ -66,6 +66,8 @@ namespace ledger {
             Option<BitcoinLikeBlockchainExplorerTransaction> bitcoinTransaction;
             Option<EthereumLikeBlockchainExplorerTransaction> ethereumTransaction;
             Option<RippleLikeBlockchainExplorerTransaction> rippleTransaction;
+            // Raw transaction rows are keyed by currency instead of account (see Configuration::SHARED_TRANSACTION_STORAGE)
+            bool sharedTransactionStorage = false;
             Operation() {};
             void refreshUid();
         private:
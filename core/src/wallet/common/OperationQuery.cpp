@@ -30,6 +30,8 @@
  */
 #include "OperationQuery.h"
 #include <api/OperationListCallback.hpp>
+#include <api/OperationRecordListCallback.hpp>
+#include <api/TrustLevel.hpp>
 #include "Operation.h"
 #include <database/soci-date.h>
 #include <database/soci-option.h>
@@ -37,10 +39,50 @@
 #include <wallet/bitcoin/database/BitcoinLikeTransactionDatabaseHelper.h>
 #include <wallet/ethereum/database/EthereumLikeTransactionDatabaseHelper.h>
 #include <wallet/ripple/database/RippleLikeTransactionDatabaseHelper.h>
+#include <collections/strings.hpp>
+#include <utils/hex.h>
 
 namespace ledger {
     namespace core {
 
+        namespace {
+            // A cursor is the hex encoding of "date|<asc or desc>|<date of the last operation>|<uid of the last operation>"
+            const std::string CURSOR_KEY = "date";
+            const std::string CURSOR_SEPARATOR = "|";
+
+            const std::string OPERATION_COLUMNS = "o.account_uid, o.uid, o.wallet_uid, o.type, o.date, o.senders, o.recipients,"
+                                                  "o.amount, o.fees, o.currency_name, o.trust, b.hash, b.height, b.time";
+            // Records only need plain values, the trust level is read from its own column instead of the serialized indicator
+            const std::string OPERATION_RECORD_COLUMNS = "o.account_uid, o.uid, o.type, o.date, o.senders, o.recipients,"
+                                                         "o.amount, o.fees, o.currency_name, o.trust_level, b.height";
+
+            struct OperationCursor {
+                bool descending;
+                std::string date;
+                std::string uid;
+            };
+
+            std::string encodeCursor(bool descending, const std::string &date, const std::string &uid) {
+                auto cursor = fmt::format("{1}{0}{2}{0}{3}{0}{4}", CURSOR_SEPARATOR, CURSOR_KEY,
+                                          descending ? "desc" : "asc", date, uid);
+                return hex::toString(std::vector<uint8_t>(cursor.begin(), cursor.end()));
+            }
+
+            OperationCursor decodeCursor(const std::string &encoded) {
+                std::vector<std::string> parts;
+                try {
+                    auto bytes = hex::toByteArray(encoded);
+                    parts = strings::split(std::string(bytes.begin(), bytes.end()), CURSOR_SEPARATOR);
+                } catch (...) {
+                    parts.clear();
+                }
+                if (parts.size() != 4 || parts[0] != CURSOR_KEY || (parts[1] != "asc" && parts[1] != "desc")) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Invalid operation cursor {}", encoded);
+                }
+                return OperationCursor {parts[1] == "desc", parts[2], parts[3]};
+            }
+        }
+
         OperationQuery::OperationQuery(const std::shared_ptr<api::QueryFilter>& headFilter,
                                        const std::shared_ptr<DatabaseSessionPool>& pool,
                                        const std::shared_ptr<api::ExecutionContext>& context,
@@ -50,12 +92,18 @@ namespace ledger {
             _fetchCompleteOperation = false;
             _pool = pool;
             _mainContext = mainContext;
+            _orderCount = 0;
+            _tieBreakerOrdered = false;
         }
 
         std::shared_ptr<api::OperationQuery> OperationQuery::addOrder(api::OperationOrderKey key, bool descending) {
+            if (_orderCount == 0 && key == api::OperationOrderKey::DATE) {
+                _dateDescending = descending;
+            }
+            _orderCount += 1;
             switch (key) {
                 case api::OperationOrderKey::AMOUNT:
-                    _builder.order("amount", std::move(descending));
+                    _builder.order("sortable_amount", std::move(descending));
                     break;
                 case api::OperationOrderKey::DATE:
                     _builder.order("date", std::move(descending));
@@ -73,7 +121,7 @@ namespace ledger {
                     _builder.order("currency_name", std::move(descending));
                     break;
                 case api::OperationOrderKey::FEES:
-                    _builder.order("fees", std::move(descending));
+                    _builder.order("sortable_fees", std::move(descending));
                     break;
                 case api::OperationOrderKey::BLOCK_HEIGHT:
                     _builder.order("block_height", std::move(descending));
@@ -93,9 +141,24 @@ namespace ledger {
 
         std::shared_ptr<api::OperationQuery> OperationQuery::limit(int64_t count) {
             _builder.limit((int32_t) count);
+            _limit = count;
             return shared_from_this();
         }
 
+        std::shared_ptr<api::OperationQuery> OperationQuery::after(const std::string &cursor) {
+            _cursor = cursor;
+            return shared_from_this();
+        }
+
+        optional<std::string> OperationQuery::getNextCursor() {
+            std::lock_guard<std::mutex> lock(_nextCursorLock);
+            return _nextCursor.toOptional();
+        }
+
+        bool OperationQuery::isPaginableByCursor() const {
+            return _orderCount == 1 && _dateDescending.nonEmpty();
+        }
+
         std::shared_ptr<api::OperationQuery> OperationQuery::complete() {
             _fetchCompleteOperation = true;
             return shared_from_this();
@@ -120,20 +183,65 @@ namespace ledger {
             });
         }
 
-        soci::rowset<soci::row> OperationQuery::performExecute(soci::session &sql) {
-            return _builder.select(
-                            "o.account_uid, o.uid, o.wallet_uid, o.type, o.date, o.senders, o.recipients,"
-                                    "o.amount, o.fees, o.currency_name, o.trust, b.hash, b.height, b.time"
-                    )
+        void OperationQuery::executeRecords(const std::shared_ptr<api::OperationRecordListCallback> &callback) {
+            executeRecords().callback(_mainContext, callback);
+        }
+
+        Future<std::vector<api::OperationRecord>> OperationQuery::executeRecords() {
+            auto self = shared_from_this();
+            return async<std::vector<api::OperationRecord>>([=] () {
+                std::vector<api::OperationRecord> out;
+                self->performExecuteRecords(out);
+                return out;
+            });
+        }
+
+        soci::rowset<soci::row> OperationQuery::performExecute(soci::session &sql, const std::string &columns) {
+            return _builder.select(columns)
                     .from("operations").to("o")
                     .outerJoin("blocks AS b", "o.block_uid = b.uid")
                     .execute(sql);
         }
 
+        bool OperationQuery::prepareExecute() {
+            auto paginable = isPaginableByCursor();
+            if (paginable && !_tieBreakerOrdered) {
+                // Operations sharing a date must be returned in a stable order for cursors to resume at the right place
+                _builder.order("o.uid", bool(_dateDescending.getValue()));
+                _tieBreakerOrdered = true;
+            }
+            if (_cursor.nonEmpty()) {
+                if (!paginable) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT,
+                                         "Operation cursors are only available on queries ordered by date only");
+                }
+                auto cursor = decodeCursor(_cursor.getValue());
+                if (cursor.descending != _dateDescending.getValue()) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT,
+                                         "Operation cursor was issued for a query in the opposite order");
+                }
+                _builder.seekAfter("o.date", "o.uid", cursor.descending, cursor.date, cursor.uid);
+            }
+            return paginable;
+        }
+
+        void OperationQuery::updateNextCursor(bool paginable, int64_t count, const std::string &lastDate,
+                                              const std::string &lastUid) {
+            std::lock_guard<std::mutex> lock(_nextCursorLock);
+            if (paginable && _limit.nonEmpty() && count > 0 && count == _limit.getValue()) {
+                _nextCursor = encodeCursor(_dateDescending.getValue(), lastDate, lastUid);
+            } else {
+                _nextCursor = Option<std::string>();
+            }
+        }
+
         void OperationQuery::performExecute(std::vector<std::shared_ptr<api::Operation>> &operations) {
-            soci::session sql(_pool->getPool());
-            soci::rowset<soci::row> rows = performExecute(sql);
+            auto paginable = prepareExecute();
+            soci::session sql(_pool->getReadonlyPool());
+            soci::rowset<soci::row> rows = performExecute(sql, OPERATION_COLUMNS);
 
+            std::string lastDate;
+            int64_t count = 0;
             for (auto& row : rows) {
                 auto accountUid = row.get<std::string>(0);
                 auto account = _accounts.find(accountUid);
@@ -168,10 +276,57 @@ namespace ledger {
 
                 // End of inflate
                 if (_fetchCompleteOperation) {
-                    inflateCompleteTransaction(sql, accountUid, *operationApi);
+                    inflateCompleteTransaction(sql, *operationApi);
+                }
+                if (paginable) {
+                    lastDate = row.get<std::string>(4);
                 }
+                count += 1;
                 operations.push_back(operationApi);
             }
+
+            updateNextCursor(paginable, count, lastDate, count > 0 ? operations.back()->getUid() : "");
+        }
+
+        void OperationQuery::performExecuteRecords(std::vector<api::OperationRecord> &records) {
+            auto paginable = prepareExecute();
+            soci::session sql(_pool->getReadonlyPool());
+            soci::rowset<soci::row> rows = performExecute(sql, OPERATION_RECORD_COLUMNS);
+
+            std::string lastDate;
+            for (auto& row : rows) {
+                auto accountUid = row.get<std::string>(0);
+                auto account = _accounts.find(accountUid);
+                if (account == _accounts.end())
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Account {} is not registered.", accountUid);
+                api::OperationRecord record;
+                record.uid = row.get<std::string>(1);
+                record.accountIndex = account->second->getIndex();
+                record.operationType = api::from_string<api::OperationType>(row.get<std::string>(2));
+                record.date = row.get<std::chrono::system_clock::time_point>(3);
+                record.senders = strings::split(row.get<std::string>(4), ",");
+                record.recipients = strings::split(row.get<std::string>(5), ",");
+                record.amount = BigInt::fromHex(row.get<std::string>(6)).toString();
+                if (row.get_indicator(7) != soci::i_null) {
+                    record.fees = BigInt::fromHex(row.get<std::string>(7)).toString();
+                }
+                record.currencyName = row.get<std::string>(8);
+                if (row.get_indicator(9) != soci::i_null) {
+                    record.trustLevel = api::from_string<api::TrustLevel>(row.get<std::string>(9));
+                } else {
+                    // Operations stored without a trust indicator: trust them once they are in a block
+                    record.trustLevel = row.get_indicator(10) != soci::i_null ? api::TrustLevel::TRUSTED : api::TrustLevel::PENDING;
+                }
+                if (row.get_indicator(10) != soci::i_null) {
+                    record.blockHeight = soci::get_number<int64_t>(row, 10);
+                }
+                record.walletType = account->second->getWalletType();
+                if (paginable) {
+                    lastDate = row.get<std::string>(3);
+                }
+                records.push_back(std::move(record));
+            }
+            updateNextCursor(paginable, records.size(), lastDate, records.empty() ? "" : records.back().uid);
         }
 
         std::shared_ptr<OperationQuery>
@@ -180,21 +335,21 @@ namespace ledger {
             return shared_from_this();
         }
 
-        void OperationQuery::inflateCompleteTransaction(soci::session &sql, const std::string &accountUid, OperationApi &operation) {
+        void OperationQuery::inflateCompleteTransaction(soci::session &sql, OperationApi &operation) {
             switch (operation.getAccount()->getWalletType()) {
-                case (api::WalletType::BITCOIN): return inflateBitcoinLikeTransaction(sql, accountUid, operation);
+                case (api::WalletType::BITCOIN): return inflateBitcoinLikeTransaction(sql, operation);
                 case (api::WalletType::ETHEREUM): return inflateEthereumLikeTransaction(sql, operation);
                 case (api::WalletType::RIPPLE): return inflateRippleLikeTransaction(sql, operation);
                 case (api::WalletType::MONERO): return inflateMoneroLikeTransaction(sql, operation);
             }
         }
 
-        void OperationQuery::inflateBitcoinLikeTransaction(soci::session &sql, const std::string &accountUid, OperationApi &operation) {
+        void OperationQuery::inflateBitcoinLikeTransaction(soci::session &sql, OperationApi &operation) {
             BitcoinLikeBlockchainExplorerTransaction tx;
             operation.getBackend().bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(tx);
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM bitcoin_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionHash);
-            BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, accountUid, operation.getBackend().bitcoinTransaction.getValue());
+            std::string transactionUid;
+            sql << "SELECT transaction_uid FROM bitcoin_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionUid);
+            BitcoinLikeTransactionDatabaseHelper::getTransactionByUid(sql, transactionUid, operation.getBackend().bitcoinTransaction.getValue());
         }
 
         void OperationQuery::inflateRippleLikeTransaction(soci::session &sql, OperationApi &operation) {
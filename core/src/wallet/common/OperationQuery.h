@@ -33,6 +33,7 @@
 
 #include <api/OperationQuery.hpp>
 #include <api/OperationOrderKey.hpp>
+#include <api/OperationRecord.hpp>
 #include <database/query/QueryBuilder.h>
 #include <database/DatabaseSessionPool.hpp>
 #include <async/DedicatedContext.hpp>
@@ -40,6 +41,7 @@
 #include "../common/api_impl/OperationApi.h"
 #include "AbstractAccount.hpp"
 #include <unordered_map>
+#include <mutex>
 #include "api_impl/OperationApi.h"
 
 namespace ledger {
@@ -57,30 +59,49 @@ namespace ledger {
             std::shared_ptr<api::QueryFilter> filter() override;
             std::shared_ptr<api::OperationQuery> offset(int64_t from) override;
             std::shared_ptr<api::OperationQuery> limit(int64_t count) override;
+            std::shared_ptr<api::OperationQuery> after(const std::string &cursor) override;
+            optional<std::string> getNextCursor() override;
             std::shared_ptr<api::OperationQuery> complete() override;
             std::shared_ptr<api::OperationQuery> partial() override;
 
             void execute(const std::shared_ptr<api::OperationListCallback> &callback) override;
             Future<std::vector<std::shared_ptr<api::Operation>>> execute();
+            void executeRecords(const std::shared_ptr<api::OperationRecordListCallback> &callback) override;
+            Future<std::vector<api::OperationRecord>> executeRecords();
 
             std::shared_ptr<OperationQuery> registerAccount(const  std::shared_ptr<AbstractAccount>& account);
 
         private:
             void performExecute(std::vector<std::shared_ptr<api::Operation>>& operations);
-            void inflateCompleteTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
-            void inflateBitcoinLikeTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
+            void performExecuteRecords(std::vector<api::OperationRecord>& records);
+            // Keyset pagination is only possible when operations are ordered by date only
+            bool isPaginableByCursor() const;
+            // Applies the tie breaker order and the cursor to the builder, returns true if the query is paginable
+            bool prepareExecute();
+            void updateNextCursor(bool paginable, int64_t count, const std::string &lastDate, const std::string &lastUid);
+            void inflateCompleteTransaction(soci::session& sql, OperationApi& operation);
+            void inflateBitcoinLikeTransaction(soci::session& sql, OperationApi& operation);
             void inflateRippleLikeTransaction(soci::session& sql, OperationApi& operation);
             void inflateEthereumLikeTransaction(soci::session& sql, OperationApi& operation);
             void inflateMoneroLikeTransaction(soci::session& sql, OperationApi& operation);
 
         protected:
-            virtual soci::rowset<soci::row> performExecute(soci::session &sql);
+            virtual soci::rowset<soci::row> performExecute(soci::session &sql, const std::string &columns);
             QueryBuilder _builder;
             std::shared_ptr<api::QueryFilter> _headFilter;
             bool _fetchCompleteOperation;
             std::shared_ptr<api::ExecutionContext> _mainContext;
             std::shared_ptr<DatabaseSessionPool> _pool;
             std::unordered_map<std::string, std::shared_ptr<AbstractAccount>> _accounts;
+
+        private:
+            int _orderCount;
+            Option<bool> _dateDescending;
+            Option<int64_t> _limit;
+            Option<std::string> _cursor;
+            bool _tieBreakerOrdered;
+            std::mutex _nextCursorLock;
+            Option<std::string> _nextCursor;
         };
     }
 }
@@ -0,0 +1,52 @@
+/*
+ *
+ * WalletConfigSnapshot
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "WalletConfigSnapshot.h"
+#include <api/Configuration.hpp>
+#include <api/ConfigurationDefaults.hpp>
+
+namespace ledger {
+    namespace core {
+        WalletConfigSnapshot WalletConfigSnapshot::fromConfiguration(const std::shared_ptr<api::DynamicObject> &configuration) {
+            WalletConfigSnapshot snapshot;
+            snapshot.keychainEngine = configuration->getString(api::Configuration::KEYCHAIN_ENGINE)
+                    .value_or(api::ConfigurationDefaults::DEFAULT_KEYCHAIN);
+            auto observableRange = configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE);
+            if (observableRange) {
+                snapshot.keychainObservableRange = Option<uint32_t>((uint32_t) observableRange.value());
+            }
+            snapshot.synchronizationHalfBatchSize = (uint32_t) configuration
+                    ->getInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE).value_or(10);
+            snapshot.sharedTransactionStorage = configuration
+                    ->getBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE).value_or(false);
+            return snapshot;
+        }
+    }
+}
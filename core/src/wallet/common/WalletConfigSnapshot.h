@@ -0,0 +1,57 @@
+/*
+ *
+ * WalletConfigSnapshot
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_WALLETCONFIGSNAPSHOT_H
+#define LEDGER_CORE_WALLETCONFIGSNAPSHOT_H
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <api/DynamicObject.hpp>
+#include <utils/Option.hpp>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Typed copy of the wallet configuration entries read on hot paths (derivation, synchronization).
+         * It is built once when the wallet is built, which also happens when its configuration is updated.
+         */
+        struct WalletConfigSnapshot {
+            std::string keychainEngine;
+            Option<uint32_t> keychainObservableRange;
+            uint32_t synchronizationHalfBatchSize;
+            bool sharedTransactionStorage;
+
+            static WalletConfigSnapshot fromConfiguration(const std::shared_ptr<api::DynamicObject> &configuration);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_WALLETCONFIGSNAPSHOT_H
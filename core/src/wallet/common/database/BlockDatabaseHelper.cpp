@@ -33,6 +33,7 @@
 #include <fmt/format.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/Upsert.hpp>
 
 using namespace soci;
 
@@ -40,13 +41,11 @@ namespace ledger {
     namespace core {
 
         bool BlockDatabaseHelper::putBlock(soci::session &sql, const Block &block) {
-            if (!blockExists(sql, block.hash, block.currencyName)) {
-                auto uid = createBlockUid(block);
-                sql << "INSERT INTO blocks VALUES(:uid, :hash, :height, :time, :currency_name)",
-                        use(uid), use(block.hash), use(block.height), use(block.time), use(block.currencyName);
-                return true;
-            }
-            return false;
+            auto uid = createBlockUid(block);
+            soci::statement insertion = (sql.prepare << insertOrIgnore(sql, "blocks", "VALUES(:uid, :hash, :height, :time, :currency_name)", "uid"),
+                    use(uid), use(block.hash), use(block.height), use(block.time), use(block.currencyName));
+            insertion.execute(true);
+            return insertion.get_affected_rows() > 0;
         }
 
 
@@ -37,11 +37,14 @@
 #include <database/soci-number.h>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
+#include <database/BulkInsert.hpp>
+#include <database/Upsert.hpp>
 #include <wallet/ethereum/database/EthereumLikeTransactionDatabaseHelper.h>
 #include <wallet/ripple/database/RippleLikeTransactionDatabaseHelper.h>
 #include <bytes/serialization.hpp>
 #include <collections/strings.hpp>
 #include <wallet/common/TrustIndicator.h>
+#include <unordered_set>
 
 using namespace soci;
 
@@ -54,56 +57,81 @@ namespace ledger {
         }
 
         bool OperationDatabaseHelper::putOperation(soci::session &sql, const Operation &operation) {
-            auto count = 0;
             std::string serializedTrust;
             serialization::saveBase64<TrustIndicator>(*operation.trust, serializedTrust);
+            auto trustLevel = api::to_string(operation.trust->getTrustLevel());
             if (operation.block.nonEmpty()) {
                 BlockDatabaseHelper::putBlock(sql, operation.block.getValue());
             }
             auto blockUid = operation.block.map<std::string>([] (const Block& block) {
                 return block.getUid();
             });
-            sql << "SELECT COUNT(*) FROM operations WHERE uid = :uid", use(operation.uid), into(count);
-            auto newOperation = count == 0;
-            if (!newOperation) {
-                sql << "UPDATE operations SET block_uid = :block_uid, trust = :trust WHERE uid = :uid"
+            auto type = api::to_string(operation.type);
+            std::stringstream senders;
+            std::stringstream recipients;
+            std::string separator(",");
+            strings::join(operation.senders, senders, separator);
+            strings::join(operation.recipients, recipients, separator);
+            auto sndrs = senders.str();
+            auto rcvrs = recipients.str();
+            auto hexAmount = operation.amount.toHexString();
+            auto hexFees = operation.fees.getValueOr(BigInt::ZERO).toHexString();
+            auto sortableAmount = soci_number::toSortableHex(operation.amount);
+            auto sortableFees = soci_number::toSortableHex(operation.fees.getValueOr(BigInt::ZERO));
+
+            // Try to insert first, the operation is only updated when the insertion hit an existing row
+            soci::statement insertion = (sql.prepare << insertOrIgnore(sql, "operations", "VALUES("
+                        ":uid, :accout_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
+                        ":fees, :block_uid, :currency_name, :trust, :trust_level, :sortable_amount, :sortable_fees"
+                    ")", "uid")
+                    , use(operation.uid), use(operation.accountUid), use(operation.walletUid), use(type), use(operation.date)
+                    , use(sndrs), use(rcvrs), use(hexAmount)
+                    , use(hexFees), use(blockUid)
+                    , use(operation.currencyName), use(serializedTrust)
+                    , use(trustLevel), use(sortableAmount), use(sortableFees));
+            insertion.execute(true);
+            auto newOperation = insertion.get_affected_rows() > 0;
+            if (newOperation) {
+                putOperationAddresses(sql, operation);
+            } else {
+                sql << "UPDATE operations SET block_uid = :block_uid, trust = :trust, trust_level = :trust_level WHERE uid = :uid"
                         , use(blockUid)
                         , use(serializedTrust)
+                        , use(trustLevel)
                         , use(operation.uid);
-                updateCurrencyOperation(sql, operation, newOperation);
-                return false;
-            } else {
-                auto type = api::to_string(operation.type);
-                std::stringstream senders;
-                std::stringstream recipients;
-                std::string separator(",");
-                strings::join(operation.senders, senders, separator);
-                strings::join(operation.recipients, recipients, separator);
-                auto sndrs = senders.str();
-                auto rcvrs = recipients.str();
-                auto hexAmount = operation.amount.toHexString();
-                auto hexFees = operation.fees.getValueOr(BigInt::ZERO).toHexString();
-                sql << "INSERT INTO operations VALUES("
-                            ":uid, :accout_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
-                            ":fees, :block_uid, :currency_name, :trust"
-                        ")"
-                        , use(operation.uid), use(operation.accountUid), use(operation.walletUid), use(type), use(operation.date)
-                        , use(sndrs), use(rcvrs), use(hexAmount)
-                        , use(hexFees), use(blockUid)
-                        , use(operation.currencyName), use(serializedTrust);
-
-                updateCurrencyOperation(sql, operation, newOperation);
-                return true;
             }
-
+            updateCurrencyOperation(sql, operation, newOperation);
+            return newOperation;
         }
 
+        void OperationDatabaseHelper::putOperationAddresses(soci::session &sql, const Operation &operation) {
+            static const std::string senderRole = "SENDER";
+            static const std::string recipientRole = "RECIPIENT";
+            std::vector<std::pair<std::string, const std::string *>> addresses;
+            auto collect = [&] (const std::vector<std::string>& list, const std::string& role) {
+                std::unordered_set<std::string> seen;
+                for (auto& address : list) {
+                    if (!address.empty() && seen.insert(address).second) {
+                        addresses.emplace_back(address, &role);
+                    }
+                }
+            };
+            collect(operation.senders, senderRole);
+            collect(operation.recipients, recipientRole);
+            bulkInsert(sql, "operation_addresses", 3, addresses,
+                       [&] (soci::statement& statement, const std::pair<std::string, const std::string *>& address) {
+                statement.exchange(use(operation.uid));
+                statement.exchange(use(address.first));
+                statement.exchange(use(*address.second));
+            });
+        }
 
         void
         OperationDatabaseHelper::updateCurrencyOperation(soci::session &sql, const Operation &operation, bool insert) {
             if (operation.bitcoinTransaction.nonEmpty()) {
                 auto operationValue = operation.bitcoinTransaction.getValue();
-                auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::putTransaction(sql, operation.accountUid, operationValue);
+                auto owner = operation.sharedTransactionStorage ? operation.currencyName : operation.accountUid;
+                auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::putTransaction(sql, owner, operationValue);
                 if (insert)
                     sql << "INSERT INTO bitcoin_operations VALUES(:uid, :tx_uid, :tx_hash)", use(operation.uid), use(btcTxUid), use(operationValue.hash);
             } else if (operation.ethereumTransaction.nonEmpty()) {
@@ -131,28 +159,23 @@ namespace ledger {
                                                  const std::string &accountUid,
                                                  std::vector<Operation> &operations,
                                                  std::function<bool(const std::string &address)> filter) {
+            // Only senders of sent operations and recipients of received ones are relevant, one row per address
             rowset<row> rows = (sql.prepare <<
-                                            "SELECT op.amount, op.fees, op.type, op.date, op.senders, op.recipients"
+                                            "SELECT op.amount, op.fees, op.type, op.date, op.uid, a.address"
                                                     " FROM operations AS op "
-                                                    " WHERE op.account_uid = :uid ORDER BY op.date",
+                                                    " JOIN operation_addresses AS a ON a.operation_uid = op.uid"
+                                                    " AND ((op.type = 'SEND' AND a.role = 'SENDER') OR"
+                                                    " (op.type = 'RECEIVE' AND a.role = 'RECIPIENT'))"
+                                                    " WHERE op.account_uid = :uid ORDER BY op.date, op.uid",
                                                     use(accountUid));
 
-            auto filterList = [&] (const std::vector<std::string> &list) -> bool {
-                for (auto& elem : list) {
-                    if (filter(elem)) {
-                        return true;
-                    }
-                }
-                return false;
-            };
-
             std::size_t c = 0;
+            std::string lastMatchedUid;
             for (auto& row : rows) {
-                auto type = api::from_string<api::OperationType>(row.get<std::string>(2));
-                auto senders = strings::split(row.get<std::string>(4), ",");
-                auto recipients = strings::split(row.get<std::string>(5), ",");
-                if ((type == api::OperationType::SEND && row.get_indicator(4) != i_null && filterList(senders)) ||
-                    (type == api::OperationType::RECEIVE && row.get_indicator(5) != i_null && filterList(recipients))) {
+                auto uid = row.get<std::string>(4);
+                if (uid != lastMatchedUid && filter(row.get<std::string>(5))) {
+                    lastMatchedUid = uid;
+                    auto type = api::from_string<api::OperationType>(row.get<std::string>(2));
                     operations.resize(operations.size() + 1);
                     auto& operation = operations[operations.size() - 1];
                     operation.amount = BigInt::fromHex(row.get<std::string>(0));
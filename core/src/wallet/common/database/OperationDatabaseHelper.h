@@ -52,6 +52,7 @@ namespace ledger {
                                                std::vector<Operation>& out,
                                                std::function<bool (const std::string& address)> filter);
         private:
+            static void putOperationAddresses(soci::session& sql, const Operation& operation);
             static void updateCurrencyOperation(soci::session& sql, const Operation& operation, bool insert);
         };
     }
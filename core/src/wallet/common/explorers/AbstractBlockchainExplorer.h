@@ -37,6 +37,7 @@
 #include <vector>
 
 #include <async/Future.hpp>
+#include <async/ExpiringCache.hpp>
 #include <collections/collections.hpp>
 #include <utils/optional.hpp>
 #include <utils/Option.hpp>
@@ -63,6 +64,15 @@ namespace ledger {
             virtual FuturePtr<Transaction> getTransactionByHash(const String& transactionHash) const = 0;
             virtual Future<String> pushTransaction(const std::vector<uint8_t>& transaction) = 0;
             virtual Future<int64_t> getTimestamp() const = 0;
+
+            // Explorers are shared by all the accounts of a pool using the same currency and configuration, observers
+            // push the blocks they are notified of so that synchronizations don't need to ask for the current block.
+            virtual void onNewBlock(const Block& block) {
+                _currentBlockCache.put(std::make_shared<Block>(block));
+            };
+
+        protected:
+            mutable ExpiringCache<std::shared_ptr<Block>> _currentBlockCache {std::chrono::seconds(10)};
         };
     }
 }
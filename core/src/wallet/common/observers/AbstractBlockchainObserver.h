@@ -38,6 +38,9 @@
 #include <api/DynamicObject.hpp>
 #include <debug/logger.hpp>
 #include <soci.h>
+#include <list>
+#include <mutex>
+#include <vector>
 
 namespace ledger {
     namespace core {
@@ -89,6 +92,14 @@ namespace ledger {
             virtual void putTransaction(const BlockchainExplorerTransaction& tx) = 0;
             virtual void putBlock(const BlockchainExplorerBlock& block) = 0;
 
+            // Put transactions received together (e.g. a burst of websocket notifications).
+            // Implementations should store them with a single database transaction per account.
+            virtual void putTransactions(const std::vector<BlockchainExplorerTransaction>& transactions) {
+                for (const auto& tx : transactions) {
+                    putTransaction(tx);
+                }
+            };
+
 
             void setLogger(const std::shared_ptr<spdlog::logger>& logger) {
                 _logger = logger;
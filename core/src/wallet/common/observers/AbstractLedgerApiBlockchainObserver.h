@@ -35,6 +35,8 @@
 #include "AbstractBlockchainObserver.h"
 #include <net/WebSocketClient.h>
 #include <net/WebSocketConnection.h>
+#include <mutex>
+#include <vector>
 namespace ledger {
     namespace core {
         class AbstractLedgerApiBlockchainObserver {
@@ -71,9 +73,30 @@ namespace ledger {
                         break;
                 }
             };
+
+            // Buffer a received message. Returns true when the buffer was empty, in which case the
+            // caller must schedule a call to takePendingMessages on the observer context: messages
+            // received until then are handled together by that call.
+            bool pushPendingMessage(const std::string& message) {
+                std::lock_guard<std::mutex> lock(_pendingMessagesLock);
+                _pendingMessages.push_back(message);
+                return _pendingMessages.size() == 1;
+            };
+
+            std::vector<std::string> takePendingMessages() {
+                std::lock_guard<std::mutex> lock(_pendingMessagesLock);
+                std::vector<std::string> messages;
+                std::swap(messages, _pendingMessages);
+                return messages;
+            };
+
             std::shared_ptr<WebSocketConnection> _socket;
             int32_t _attempt;
             std::string _url;
+
+        private:
+            std::mutex _pendingMessagesLock;
+            std::vector<std::string> _pendingMessages;
         };
     }
 }
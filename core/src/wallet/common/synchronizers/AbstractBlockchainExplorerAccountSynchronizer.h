@@ -38,6 +38,7 @@
 
 #include <api/Configuration.hpp>
 #include <async/Future.hpp>
+#include <async/algorithm.h>
 #include <async/wait.h>
 #include <collections/DynamicObject.hpp>
 #include <debug/Benchmarker.h>
@@ -118,6 +119,7 @@ namespace ledger {
                 std::shared_ptr<AbstractWallet> wallet;
                 std::shared_ptr<DynamicObject> configuration;
                 uint32_t halfBatchSize;
+                uint32_t lastDiscoverableAddress;
                 std::shared_ptr<Keychain> keychain;
                 Option<BlockchainExplorerAccountSynchronizationSavedState> savedState;
                 Option<void *> token;
@@ -176,9 +178,9 @@ namespace ledger {
                 buddy->startDate = DateUtils::now();
                 buddy->wallet = account->getWallet();
                 buddy->configuration = std::static_pointer_cast<AbstractAccount>(account)->getWallet()->getConfig();
-                buddy->halfBatchSize = (uint32_t) buddy->configuration
-                        ->getInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE)
-                        .value_or(10);
+                auto& configSnapshot = buddy->wallet->getConfigSnapshot();
+                buddy->halfBatchSize = configSnapshot.synchronizationHalfBatchSize;
+                buddy->lastDiscoverableAddress = configSnapshot.keychainObservableRange.getValueOr(buddy->halfBatchSize);
                 buddy->keychain = account->getKeychain();
                 buddy->savedState = buddy->preferences
                         ->template getObject<BlockchainExplorerAccountSynchronizationSavedState>("state");
@@ -274,6 +276,21 @@ namespace ledger {
             Future<Unit> synchronizeBatches(uint32_t currentBatchIndex,
                                             std::shared_ptr<SynchronizationBuddy> buddy) {
                 buddy->logger->info("SYNC BATCHES");
+                auto self = getSharedFromThis();
+                auto batchIndex = std::make_shared<uint32_t>(currentBatchIndex);
+                return async::doWhile(buddy->account->getContext(), [self, batchIndex, buddy] () {
+                    return self->synchronizeNextBatch(batchIndex, buddy);
+                });
+            };
+
+            // Synchronize a single batch of synchronizeBatches.
+            //
+            // The future is resolved with true when another batch must be synchronized, in which case
+            // batchIndex has been moved to it (it is left untouched when the same batch has to be
+            // synchronized again after recovering from a reorganization).
+            Future<bool> synchronizeNextBatch(std::shared_ptr<uint32_t> batchIndex,
+                                              std::shared_ptr<SynchronizationBuddy> buddy) {
+                auto currentBatchIndex = *batchIndex;
                 //For ETH and XRP like wallets, one account corresponds to one ETH address,
                 //so ne need to discover other batches
                 auto hasMultipleAddresses = buddy->wallet->getWalletType() == api::WalletType::BITCOIN;
@@ -287,7 +304,7 @@ namespace ledger {
 
                 auto benchmark = std::make_shared<Benchmarker>(fmt::format("Synchronize batch {}", currentBatchIndex), buddy->logger);
                 benchmark->start();
-                return synchronizeBatch(currentBatchIndex, buddy).template flatMap<Unit>(buddy->account->getContext(), [=] (const bool& hadTransactions) -> Future<Unit> {
+                return synchronizeBatch(currentBatchIndex, buddy).template map<bool>(buddy->account->getContext(), [=] (const bool& hadTransactions) -> bool {
                     benchmark->stop();
 
                     buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
@@ -295,13 +312,13 @@ namespace ledger {
                     //Sync stops if there are no more batches in savedState and last batch has no transactions
                     //But we may want to force sync of accounts within KEYCHAIN_OBSERVABLE_RANGE
                     auto discoveredAddresses = currentBatchIndex * buddy->halfBatchSize;
-                    auto lastDiscoverableAddress = buddy->configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE).value_or(buddy->halfBatchSize);
-                    if (hasMultipleAddresses && (!done || (done && hadTransactions) || lastDiscoverableAddress > discoveredAddresses)) {
-                        return self->synchronizeBatches(currentBatchIndex + 1, buddy);
+                    if (hasMultipleAddresses && (!done || (done && hadTransactions) || buddy->lastDiscoverableAddress > discoveredAddresses)) {
+                        *batchIndex = currentBatchIndex + 1;
+                        return true;
                     }
 
-                    return Future<Unit>::successful(unit);
-                }).recoverWith(ImmediateExecutionContext::INSTANCE, [=] (const Exception &exception) -> Future<Unit> {
+                    return false;
+                }).recoverWith(ImmediateExecutionContext::INSTANCE, [=] (const Exception &exception) -> Future<bool> {
                     buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
 
                     //A block reorganization happened
@@ -345,30 +362,45 @@ namespace ledger {
                                     "state", buddy->savedState.getValue())->commit();
 
                             //Synchronize same batch now with an existing block (of hash lastBlockHash)
-                            //if failedBatch was not the deepest block part of that reorg, this recursive call
+                            //if failedBatch was not the deepest block part of that reorg, the next iteration
                             //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
                             buddy->logger->info("Relaunch synchronization after recovering from reorganization");
 
-                            return self->synchronizeBatches(currentBatchIndex, buddy);
+                            return Future<bool>::successful(true);
                         }
                     } else {
-                        return Future<Unit>::failure(exception);
+                        return Future<bool>::failure(exception);
                     }
 
-                    return Future<Unit>::successful(unit);
+                    return Future<bool>::successful(false);
                 });
             };
 
             // Synchronize a transactions batch.
             //
             // The currentBatchIndex is the currently synchronized batch. buddy is the
-            // synchronization object used to accumulate a state. hadTransactions is used to check
-            // whether more data is needed. If a block doesn’t have any transaction, it means that
-            // we must stop.
+            // synchronization object used to accumulate a state. The future is resolved with whether
+            // the batch had transactions, which is used to check whether more data is needed. If a
+            // block doesn’t have any transaction, it means that we must stop.
             Future<bool> synchronizeBatch(uint32_t currentBatchIndex,
-                                          std::shared_ptr<SynchronizationBuddy> buddy,
-                                          bool hadTransactions = false) {
+                                          std::shared_ptr<SynchronizationBuddy> buddy) {
                 buddy->logger->info("SYNC BATCH {}", currentBatchIndex);
+                auto self = getSharedFromThis();
+                auto hadTransactions = std::make_shared<bool>(false);
+                return async::doWhile(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions] () {
+                    return self->synchronizeBulk(currentBatchIndex, buddy, hadTransactions);
+                }).template map<bool>(ImmediateExecutionContext::INSTANCE, [hadTransactions] (const Unit&) {
+                    return *hadTransactions;
+                });
+            };
+
+            // Synchronize the next transactions bulk of a batch.
+            //
+            // The future is resolved with true when the explorer has more bulks for this batch.
+            // hadTransactions is set as soon as one of the bulks contains a transaction.
+            Future<bool> synchronizeBulk(uint32_t currentBatchIndex,
+                                         std::shared_ptr<SynchronizationBuddy> buddy,
+                                         std::shared_ptr<bool> hadTransactions) {
 
                 Option<std::string> blockHash;
                 auto self = getSharedFromThis();
@@ -395,7 +427,7 @@ namespace ledger {
                 benchmark->start();
                 return _explorer
                     ->getTransactions(batch, blockHash, buddy->token)
-                    .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions, benchmark] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> Future<bool> {
+                    .template map<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions, benchmark] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> bool {
                         benchmark->stop();
 
                         auto insertionBenchmark = std::make_shared<Benchmarker>("Transaction computation", buddy->logger);
@@ -424,6 +456,7 @@ namespace ledger {
                         }
 
                         tr.commit();
+                        buddy->account->persistPendingState();
                         buddy->account->emitEventsNow();
 
                         // Get the last block
@@ -438,12 +471,8 @@ namespace ledger {
 
                         insertionBenchmark->stop();
 
-                        auto hadTX = hadTransactions || bulk->transactions.size() > 0;
-                        if (bulk->hasNext) {
-                            return self->synchronizeBatch(currentBatchIndex, buddy, hadTX);
-                        } else {
-                            return Future<bool>::successful(hadTX);
-                        }
+                        *hadTransactions = *hadTransactions || bulk->transactions.size() > 0;
+                        return bulk->hasNext;
                     });
             };
 
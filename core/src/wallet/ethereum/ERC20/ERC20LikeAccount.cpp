@@ -45,6 +45,7 @@
 #include <wallet/common/BalanceHistory.hpp>
 #include <soci.h>
 #include <database/soci-date.h>
+#include <database/Upsert.hpp>
 #include <database/query/ConditionQueryFilter.h>
 
 using namespace soci;
@@ -237,39 +238,37 @@ namespace ledger {
             getTransferToAddressData(amount, address).callback(context, data);
         }
 
-        void ERC20LikeAccount::putOperation(soci::session &sql, const std::shared_ptr<ERC20LikeOperation> &operation, bool newOperation) {
+        void ERC20LikeAccount::putOperation(soci::session &sql, const std::shared_ptr<ERC20LikeOperation> &operation) {
             auto status = operation->getStatus();
             auto erc20OpUid = operation->getOperationUid();
             auto gasUsed = operation->getUsedGas()->toString(16);
-            if (newOperation) {
-                auto ethOpUid = operation->getETHOperationUid();
-                auto hash = operation->getHash();
-                auto receiver = operation->getReceiver();
-                auto sender = operation->getSender();
-                auto data = hex::toString(operation->getData());
-                auto operationType = api::to_string(operation->getOperationType());
-                auto nonce = operation->getNonce()->toString(16);
-                auto value = operation->getValue()->toString(16);
-                auto time = operation->getTime();
-                auto gasPrice = operation->getGasPrice()->toString(16);
-                auto gasLimit = operation->getGasLimit()->toString(16);
-                auto blockHeight = operation->getBlockHeight().value_or(0);
-                sql << "INSERT INTO erc20_operations VALUES("
-                        ":uid, :eth_op_uid, :accout_uid, :op_type, :hash, :nonce, :value, :date, :sender,"
-                        ":receiver, :data, :gas_price, :gas_limit, :gas_used, :status, :block_height"
-                        ")"
-                        , use(erc20OpUid), use(ethOpUid)
-                        , use(_accountUid), use(operationType), use(hash)
-                        , use(nonce), use(value), use(time)
-                        , use(sender), use(receiver), use(data)
-                        , use(gasPrice), use(gasLimit), use(gasUsed)
-                        , use(status), use(blockHeight);
-            } else {
-                // Update
-                sql << "UPDATE erc20_operations SET status = :code , gas_used = :gas WHERE uid = :uid"
-                        , use(status)
-                        , use(gasUsed)
-                        , use(erc20OpUid);
+            auto ethOpUid = operation->getETHOperationUid();
+            auto hash = operation->getHash();
+            auto receiver = operation->getReceiver();
+            auto sender = operation->getSender();
+            auto data = hex::toString(operation->getData());
+            auto operationType = api::to_string(operation->getOperationType());
+            auto nonce = operation->getNonce()->toString(16);
+            auto value = operation->getValue()->toString(16);
+            auto time = operation->getTime();
+            auto gasPrice = operation->getGasPrice()->toString(16);
+            auto gasLimit = operation->getGasLimit()->toString(16);
+            auto blockHeight = operation->getBlockHeight().value_or(0);
+            // Known operations only get their status and used gas updated
+            soci::statement insertion = (sql.prepare << insertOrIgnore(sql, "erc20_operations", "VALUES("
+                    ":uid, :eth_op_uid, :accout_uid, :op_type, :hash, :nonce, :value, :date, :sender,"
+                    ":receiver, :data, :gas_price, :gas_limit, :gas_used, :status, :block_height"
+                    ")", "uid")
+                    , use(erc20OpUid), use(ethOpUid)
+                    , use(_accountUid), use(operationType), use(hash)
+                    , use(nonce), use(value), use(time)
+                    , use(sender), use(receiver), use(data)
+                    , use(gasPrice), use(gasLimit), use(gasUsed)
+                    , use(status), use(blockHeight));
+            insertion.execute(true);
+            if (insertion.get_affected_rows() == 0) {
+                sql << "UPDATE erc20_operations SET status = :status, gas_used = :gas_used WHERE uid = :uid"
+                        , use(status), use(gasUsed), use(erc20OpUid);
             }
         }
 
@@ -283,7 +282,7 @@ namespace ledger {
             auto query = std::make_shared<ERC20OperationQuery>(
                     filter,
                     localAccount->getWallet()->getDatabase(),
-                    localAccount->getWallet()->getContext(),
+                    localAccount->getContext(),
                     localAccount->getWallet()->getMainExecutionContext()
             );
             query->registerAccount(localAccount);
@@ -55,10 +55,8 @@ namespace ledger {
 
             };
         protected:
-            virtual soci::rowset<soci::row> performExecute(soci::session &sql) {
-                return _builder.select("o.account_uid, o.uid, o.wallet_uid, o.type, o.date, o.senders, o.recipients,"
-                                                "o.amount, o.fees, o.currency_name, o.trust, b.hash, b.height, b.time, e.uid"
-                                )
+            virtual soci::rowset<soci::row> performExecute(soci::session &sql, const std::string &columns) {
+                return _builder.select(columns)
                                 .from("operations").to("o")
                                 .outerJoin("blocks AS b", "o.block_uid = b.uid")
                                 .outerJoin("erc20_operations AS e", "o.uid = e.ethereum_operation_uid")
@@ -100,7 +98,7 @@ namespace ledger {
                                           const std::shared_ptr<api::BinaryCallback> &data) override;
 
             std::shared_ptr<api::OperationQuery> queryOperations() override ;
-            void putOperation(soci::session &sql, const std::shared_ptr<ERC20LikeOperation> &operation, bool newOperation = false);
+            void putOperation(soci::session &sql, const std::shared_ptr<ERC20LikeOperation> &operation);
         private:
             std::shared_ptr<api::ExecutionContext> getContext();
 
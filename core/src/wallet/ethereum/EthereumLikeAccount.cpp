@@ -178,9 +178,6 @@ namespace ledger {
             auto erc20Operation = std::make_shared<ERC20LikeOperation>(_accountAddress, erc20OperationUid, operation, erc20Tx, getWallet()->getCurrency());
             auto erc20AccountUid = AccountDatabaseHelper::createERC20AccountUid(getAccountUid(), erc20ContractAddress);
 
-            auto erc20OpCount = 0;
-            sql << "SELECT COUNT(*) FROM erc20_operations WHERE uid = :uid", soci::use(erc20OperationUid), soci::into(erc20OpCount);
-            auto newOperation = erc20OpCount == 0;
             //Check if account already exists
             auto needNewAccount = true;
             for (auto& account : _erc20LikeAccounts) {
@@ -188,7 +185,7 @@ namespace ledger {
                 if (erc20Account->getToken().contractAddress == erc20ContractAddress &&
                     erc20Account->getAddress() == _accountAddress) {
                     //Update account
-                    erc20Account->putOperation(sql, erc20Operation, newOperation);
+                    erc20Account->putOperation(sql, erc20Operation);
                     needNewAccount = false;
                 }
             }
@@ -203,12 +200,8 @@ namespace ledger {
                                                                      std::dynamic_pointer_cast<EthereumLikeAccount>(shared_from_this()));
                 _erc20LikeAccounts.push_back(newAccount);
                 //Persist erc20 account
-                int erc20AccountCount = 0;
-                sql << "SELECT COUNT(*) FROM erc20_accounts WHERE uid = :uid", soci::use(erc20AccountUid), soci::into(erc20AccountCount);
-                if (erc20AccountCount == 0) {
-                    EthereumLikeAccountDatabaseHelper::createERC20Account(sql, getAccountUid(), erc20AccountUid, erc20Token.contractAddress);
-                }
-                newAccount->putOperation(sql, erc20Operation, newOperation);
+                EthereumLikeAccountDatabaseHelper::createERC20Account(sql, getAccountUid(), erc20AccountUid, erc20Token.contractAddress);
+                newAccount->putOperation(sql, erc20Operation);
             }
         }
 
@@ -242,7 +235,7 @@ namespace ledger {
             auto query = std::make_shared<OperationQuery>(
                     api::QueryFilter::accountEq(getAccountUid()),
                     getWallet()->getDatabase(),
-                    getWallet()->getContext(),
+                    getContext(),
                     getWallet()->getMainExecutionContext()
             );
             query->registerAccount(shared_from_this());
@@ -272,7 +265,7 @@ namespace ledger {
                     }
 
                     const auto &uid = self->getAccountUid();
-                    soci::session sql(self->getWallet()->getDatabase()->getPool());
+                    soci::session sql(self->getWallet()->getDatabase()->getReadonlyPool());
                     std::vector<Operation> operations;
 
                     auto keychain = self->getKeychain();
@@ -491,6 +484,10 @@ namespace ledger {
                 return _erc20LikeAccounts;
         }
 
+        const std::shared_ptr<EthereumLikeBlockchainExplorer> &EthereumLikeAccount::getExplorer() const {
+            return _explorer;
+        }
+
         void EthereumLikeAccount::getGasPrice(const std::shared_ptr<api::BigIntCallback> & callback) {
             _explorer->getGasPrice().mapPtr<api::BigInt>(getContext(), [] (const std::shared_ptr<BigInt> &gasPrice) -> std::shared_ptr<api::BigInt> {
                 return std::make_shared<api::BigIntImpl>(*gasPrice);
@@ -118,6 +118,8 @@ namespace ledger {
 
             void addERC20Accounts(soci::session &sql,
                                   const std::vector<ERC20LikeAccountDatabaseEntry> &erc20Entries);
+
+            const std::shared_ptr<EthereumLikeBlockchainExplorer>& getExplorer() const;
         private:
             std::shared_ptr<EthereumLikeAccount> getSelf();
             std::shared_ptr<EthereumLikeKeychain> _keychain;
@@ -67,14 +67,6 @@ namespace ledger {
             _coinType = scheme.getCoinType() ? scheme.getCoinType() : network.bip44CoinType;
         }
 
-        bool EthereumLikeWallet::isSynchronizing() {
-            return false;
-        }
-
-        std::shared_ptr<api::EventBus> EthereumLikeWallet::synchronize() {
-            return nullptr;
-        }
-
         FuturePtr<ledger::core::api::Account>
         EthereumLikeWallet::newAccountWithInfo(const api::AccountCreationInfo &info) {
             if (info.chainCodes.size() != 1 || info.publicKeys.size() != 1 || info.owners.size() != 1)
@@ -174,7 +166,7 @@ namespace ledger {
                 info.index = accountIndex;
                 auto scheme = self->getDerivationScheme();
                 scheme.setCoinType(self->_coinType).setAccountIndex(accountIndex);
-                auto keychainEngine = self->getConfiguration()->getString(api::Configuration::KEYCHAIN_ENGINE).value_or(api::ConfigurationDefaults::DEFAULT_KEYCHAIN);
+                auto& keychainEngine = self->getConfigSnapshot().keychainEngine;
                 if (keychainEngine == api::KeychainEngines::BIP32_P2PKH ||
                     keychainEngine == api::KeychainEngines::BIP49_P2SH) {
                     info.derivations.push_back(getAccountScheme(scheme).getPath().toString());
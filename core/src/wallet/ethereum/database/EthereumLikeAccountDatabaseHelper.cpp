@@ -31,6 +31,7 @@
 
 #include "EthereumLikeAccountDatabaseHelper.h"
 #include <wallet/common/database/AccountDatabaseHelper.h>
+#include <database/Upsert.hpp>
 
 using namespace soci;
 
@@ -47,7 +48,8 @@ namespace ledger {
                                                                    const std::string &ethAccountUid,
                                                                    const std::string &erc20AccountUid,
                                                                    const std::string &contractAddress) {
-            sql << "INSERT INTO erc20_accounts VALUES(:uid, :ethereum_account_uid, :contract_address)",use(erc20AccountUid), use(ethAccountUid), use(contractAddress);
+            sql << insertOrIgnore(sql, "erc20_accounts", "VALUES(:uid, :ethereum_account_uid, :contract_address)", "uid"),
+                   use(erc20AccountUid), use(ethAccountUid), use(contractAddress);
         }
 
         bool EthereumLikeAccountDatabaseHelper::queryAccount(soci::session &sql,
@@ -35,6 +35,7 @@
 #include <database/soci-option.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/Upsert.hpp>
 #include <crypto/SHA256.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 
@@ -120,43 +121,40 @@ namespace ledger {
 
             auto ethTxUid = createEthereumTransactionUid(accountUid, tx.hash);
 
-            if (transactionExists(sql, ethTxUid)) {
-                // UPDATE
-                if (tx.block.nonEmpty()) {
-                    auto gasUsed = tx.gasUsed.getValueOr(BigInt::ZERO).toHexString();
-                    sql << "UPDATE ethereum_transactions SET block_uid = :uid, status = :code, gas_used = :gas WHERE hash = :tx_hash",
-                            use(blockUid), use(tx.status), use(gasUsed), use(tx.hash);
-                }
-                return ethTxUid;
-            } else {
-                // Insert
-                if (tx.block.nonEmpty()) {
-                    BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
-                }
-
-                auto txInputData = hex::toString(tx.inputData);
-                auto hexTxValue = tx.value.toHexString();
-                auto hexGasPrice = tx.gasPrice.toHexString();
-                auto hexGasLimit = tx.gasLimit.toHexString();
-                auto hexGasUsed = tx.gasUsed.getValueOr(BigInt::ZERO).toHexString();
-                sql << "INSERT INTO ethereum_transactions VALUES(:tx_uid, :hash, :nonce, :value, :block_uid, :time, :sender, :receiver, :input_data, :gasPrice, :gasLimit, :gasUsed, :confirmations, :status)",
-                        use(ethTxUid),
-                        use(tx.hash),
-                        use(tx.nonce),
-                        use(hexTxValue),
-                        use(blockUid),
-                        use(tx.receivedAt),
-                        use(tx.sender),
-                        use(tx.receiver),
-                        use(txInputData),
-                        use(hexGasPrice),
-                        use(hexGasLimit),
-                        use(hexGasUsed),
-                        use(tx.confirmations),
-                        use(tx.status);
-
-                return ethTxUid;
+            if (tx.block.nonEmpty()) {
+                BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
             }
+
+            auto txInputData = hex::toString(tx.inputData);
+            auto hexTxValue = tx.value.toHexString();
+            auto hexGasPrice = tx.gasPrice.toHexString();
+            auto hexGasLimit = tx.gasLimit.toHexString();
+            auto hexGasUsed = tx.gasUsed.getValueOr(BigInt::ZERO).toHexString();
+            // Known transactions only get their block, status and used gas updated, once they are mined
+            soci::statement insertion = (sql.prepare << insertOrIgnore(sql, "ethereum_transactions",
+                    "VALUES(:tx_uid, :hash, :nonce, :value, :block_uid, :time, :sender, :receiver, :input_data, :gasPrice, :gasLimit, :gasUsed, :confirmations, :status)",
+                    "transaction_uid"),
+                    use(ethTxUid),
+                    use(tx.hash),
+                    use(tx.nonce),
+                    use(hexTxValue),
+                    use(blockUid),
+                    use(tx.receivedAt),
+                    use(tx.sender),
+                    use(tx.receiver),
+                    use(txInputData),
+                    use(hexGasPrice),
+                    use(hexGasLimit),
+                    use(hexGasUsed),
+                    use(tx.confirmations),
+                    use(tx.status));
+            insertion.execute(true);
+            if (insertion.get_affected_rows() == 0 && blockUid.nonEmpty()) {
+                sql << "UPDATE ethereum_transactions SET block_uid = :block_uid, status = :status, gas_used = :gas_used "
+                       "WHERE transaction_uid = :tx_uid",
+                        use(blockUid), use(tx.status), use(hexGasUsed), use(ethTxUid);
+            }
+            return ethTxUid;
         }
     }
 }
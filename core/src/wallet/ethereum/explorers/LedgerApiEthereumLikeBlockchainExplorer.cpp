@@ -100,7 +100,9 @@ namespace ledger {
         }
 
         Future<std::shared_ptr<BigInt>> LedgerApiEthereumLikeBlockchainExplorer::getGasPrice() {
-            return getHelper(fmt::format("/blockchain/{}/{}/fees", getExplorerVersion(), getNetworkParameters().Identifier), "gas_price");
+            return _gasPriceCache.get([this] () {
+                return getHelper(fmt::format("/blockchain/{}/{}/fees", getExplorerVersion(), getNetworkParameters().Identifier), "gas_price");
+            });
         }
 
         Future<std::shared_ptr<BigInt>> LedgerApiEthereumLikeBlockchainExplorer::getEstimatedGasLimit(const std::string &address) {
@@ -176,7 +178,9 @@ namespace ledger {
         }
 
         FuturePtr<Block> LedgerApiEthereumLikeBlockchainExplorer::getCurrentBlock() const {
-            return getLedgerApiCurrentBlock();
+            return _currentBlockCache.get([this] () {
+                return getLedgerApiCurrentBlock();
+            });
         }
 
         FuturePtr<EthereumLikeBlockchainExplorerTransaction>
@@ -199,5 +203,10 @@ namespace ledger {
         std::string LedgerApiEthereumLikeBlockchainExplorer::getExplorerVersion() const {
             return _explorerVersion;
         }
+
+        void LedgerApiEthereumLikeBlockchainExplorer::onNewBlock(const Block &block) {
+            EthereumLikeBlockchainExplorer::onNewBlock(block);
+            _gasPriceCache.invalidate();
+        }
     }
 }
@@ -75,11 +75,14 @@ namespace ledger {
             api::EthereumLikeNetworkParameters getNetworkParameters() const override;
             std::string getExplorerVersion() const override;
 
+            void onNewBlock(const Block& block) override;
+
         private:
             Future<std::shared_ptr<BigInt>> getHelper(const std::string &url,
                                                       const std::string &field);
             api::EthereumLikeNetworkParameters _parameters;
             std::string _explorerVersion;
+            ExpiringCache<std::shared_ptr<BigInt>> _gasPriceCache {std::chrono::seconds(30)};
         };
     }
 }
@@ -52,24 +52,22 @@ namespace ledger {
 
 
         void EthereumLikeBlockchainObserver::putTransaction(const EthereumLikeBlockchainExplorerTransaction &tx) {
-            std::lock_guard<std::mutex> lock(_lock);
-            for (const auto& account : _accounts) {
-                account->run([account, tx] () {
-                    soci::session sql(account->getWallet()->getDatabase()->getPool());
-                    if (account->putTransaction(sql, tx) != EthereumLikeAccount::FLAG_TRANSACTION_IGNORED)
-                        account->emitEventsNow();
-                });
-            }
+            putTransactions({tx});
         }
 
-        void EthereumLikeBlockchainObserver::putBlock(const EthereumLikeBlockchainExplorer::Block &block) {
+        void EthereumLikeBlockchainObserver::putTransactions(const std::vector<EthereumLikeBlockchainExplorerTransaction> &transactions) {
             std::lock_guard<std::mutex> lock(_lock);
-            for (const auto& account : _accounts) {
-                account->run([account, block] () {
+            for (const auto &account : _accounts) {
+                account->run([account, transactions] () {
                     bool shouldEmitNow = false;
                     {
                         soci::session sql(account->getWallet()->getDatabase()->getPool());
-                        shouldEmitNow = account->putBlock(sql, block);
+                        soci::transaction tr(sql);
+                        for (const auto &tx : transactions) {
+                            if (account->putTransaction(sql, tx) != EthereumLikeAccount::FLAG_TRANSACTION_IGNORED)
+                                shouldEmitNow = true;
+                        }
+                        tr.commit();
                     }
                     if (shouldEmitNow)
                         account->emitEventsNow();
@@ -77,6 +75,28 @@ namespace ledger {
             }
         }
 
+        void EthereumLikeBlockchainObserver::putBlock(const EthereumLikeBlockchainExplorer::Block &block) {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_accounts.empty())
+                return;
+            // Explorers cache the current block for the accounts sharing them, refresh it before accounts ask for it
+            for (auto& observed : _accounts) {
+                observed->getExplorer()->onNewBlock(block);
+            }
+            // Blocks are stored per currency and all the observed accounts share the same database,
+            // so a single account writes the block (and emits the new block event).
+            auto account = _accounts.front();
+            account->run([account, block] () {
+                bool shouldEmitNow = false;
+                {
+                    soci::session sql(account->getWallet()->getDatabase()->getPool());
+                    shouldEmitNow = account->putBlock(sql, block);
+                }
+                if (shouldEmitNow)
+                    account->emitEventsNow();
+            });
+        }
+
 
     }
 }
\ No newline at end of file
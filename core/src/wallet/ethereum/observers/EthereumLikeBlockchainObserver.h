@@ -67,6 +67,8 @@ namespace ledger {
         protected:
             void putTransaction(const EthereumLikeBlockchainExplorerTransaction &tx) override;
 
+            void putTransactions(const std::vector<EthereumLikeBlockchainExplorerTransaction> &transactions) override;
+
             void putBlock(const EthereumLikeBlockchainExplorer::Block &block) override;
 
             const api::Currency &getCurrency() const {
@@ -30,13 +30,17 @@
  */
 #include "WalletPool.hpp"
 #include <api/PoolConfiguration.hpp>
+#include <api/Configuration.hpp>
 #include <wallet/currencies.hpp>
 #include <wallet/ethereum/ERC20/erc20Tokens.h>
 #include <wallet/pool/database/CurrenciesDatabaseHelper.hpp>
 #include <wallet/pool/database/PoolDatabaseHelper.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <database/soci-date.h>
+#include <async/algorithm.h>
 #include <bitcoin/bech32/Bech32Parameters.h>
+#include <events/Event.hpp>
+#include <api/WalletPool.hpp>
 
 namespace ledger {
     namespace core {
@@ -79,12 +83,11 @@ namespace ledger {
             );
 
             _rng = rng;
-            // Encrypt the preferences, if needed
+            // Encrypt the preferences, if needed; this also recovers from an interrupted password
+            // change, which may have been to or from an empty password
             _password = password;
-            if (!_password.empty()) {
-                _externalPreferencesBackend->setEncryption(_rng, _password);
-                _internalPreferencesBackend->setEncryption(_rng, _password);
-            }
+            _externalPreferencesBackend->setEncryption(_rng, _password);
+            _internalPreferencesBackend->setEncryption(_rng, _password);
 
             // Logger management
             _logPrinter = logPrinter;
@@ -104,11 +107,17 @@ namespace ledger {
                pathResolver,
                _logger,
                Option<std::string>(configuration->getString(api::PoolConfiguration::DATABASE_NAME)).getValueOr(name),
-               password
+               password,
+               std::max(configuration->getInt(api::PoolConfiguration::DATABASE_READ_CONNECTIONS).value_or(2), 0)
             );
 
             // Threading management
             _threadDispatcher = dispatcher;
+            _fanOutContext = dispatcher->getThreadPoolExecutionContext("pool_fan_out");
+            _maxConcurrentWalletOperations = (size_t) std::max(
+                    _configuration->getInt(api::PoolConfiguration::MAX_CONCURRENT_WALLET_OPERATIONS).value_or(4), 1);
+            _accountExecutionContexts = (size_t) std::max(
+                    _configuration->getInt(api::PoolConfiguration::ACCOUNT_EXECUTION_CONTEXTS).value_or(8), 1);
 
             _publisher = std::make_shared<EventPublisher>(getContext());
         }
@@ -222,6 +231,22 @@ namespace ledger {
             return _threadDispatcher;
         }
 
+        std::shared_ptr<api::ExecutionContext> WalletPool::getFanOutContext() const {
+            return _fanOutContext;
+        }
+
+        size_t WalletPool::getMaxConcurrentWalletOperations() const {
+            return _maxConcurrentWalletOperations;
+        }
+
+        std::shared_ptr<api::ExecutionContext> WalletPool::getAccountExecutionContext(const std::string& accountUid) const {
+            // Accounts are spread over a fixed set of serial contexts so that a given account
+            // always runs on the same one. Dispatchers return the same context for the same name,
+            // the pool name keeps the sets of different pools apart.
+            auto shard = std::hash<std::string>()(accountUid) % _accountExecutionContexts;
+            return _threadDispatcher->getSerialExecutionContext(fmt::format("account_{}_{}", _poolName, shard));
+        }
+
         std::shared_ptr<HttpClient> WalletPool::getHttpClient(const std::string &baseUrl) {
             auto it = _httpClients.find(baseUrl);
             if (it == _httpClients.end() || !it->second.lock()) {
@@ -309,7 +334,11 @@ namespace ledger {
                 }
                 // Wallet exists, let's update its configuration
                 auto walletEntry = entry.getValue();
+                // The transaction storage layout is chosen once at creation, switching it would mix both layouts
+                auto sharedTransactionStorage = walletEntry.configuration
+                        ->getBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE).value_or(false);
                 walletEntry.configuration->updateWithConfiguration(std::static_pointer_cast<ledger::core::DynamicObject>(configuration));
+                walletEntry.configuration->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE, sharedTransactionStorage);
                 soci::session sql(self->getDatabaseSessionPool()->getPool());
                 PoolDatabaseHelper::putWallet(sql, walletEntry);
                 // No need to check if currency supported (factory non null), because we are supposed to fetch
@@ -423,6 +452,9 @@ namespace ledger {
                 WalletDatabaseEntry entry;
                 entry.name = name;
                 entry.configuration = std::static_pointer_cast<ledger::core::DynamicObject>(configuration);
+                // Persist the transaction storage layout, it cannot be changed afterwards
+                entry.configuration->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE,
+                        entry.configuration->getBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE).value_or(false));
                 entry.currencyName = currencyName;
                 entry.poolName = self->getName();
                 entry.uid = WalletDatabaseEntry::createWalletUid(self->getName(), name);
@@ -470,31 +502,16 @@ namespace ledger {
 
             return getWalletCount().flatMap<std::vector<std::shared_ptr<AbstractWallet>>>(getContext(), [self] (int64_t count) {
                 return self->getWallets(0, count);
-            }).flatMap<api::ErrorCode>(getContext(), [self, date] (const std::vector<std::shared_ptr<AbstractWallet>> &wallets) -> Future<api::ErrorCode>{
-
-                static std::function<Future<api::ErrorCode> (int, const std::vector<std::shared_ptr<AbstractWallet>> &)>  eraseWallet = [date] (int index, const std::vector<std::shared_ptr<AbstractWallet>> &walletsToErase) -> Future<api::ErrorCode> {
-
-                    if (index == walletsToErase.size()) {
-                        return Future<api::ErrorCode>::successful(api::ErrorCode::FUTURE_WAS_SUCCESSFULL);
-                    }
-
-                    return walletsToErase[index]->eraseDataSince(date).flatMap<api::ErrorCode>(ImmediateExecutionContext::INSTANCE,[date, index, walletsToErase] (const api::ErrorCode &errorCode) -> Future<api::ErrorCode> {
-
+            }).flatMap<Unit>(getContext(), [self, date] (const std::vector<std::shared_ptr<AbstractWallet>> &wallets) {
+                return core::async::parallelForEach<std::shared_ptr<AbstractWallet>>(self->getFanOutContext(), wallets, self->getMaxConcurrentWalletOperations(), [date] (const std::shared_ptr<AbstractWallet> &wallet) {
+                    return wallet->eraseDataSince(date).map<Unit>(ImmediateExecutionContext::INSTANCE, [] (const api::ErrorCode &errorCode) {
                         if (errorCode != api::ErrorCode::FUTURE_WAS_SUCCESSFULL) {
-                            return Future<api::ErrorCode>::failure(make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase wallets of WalletPool !"));
+                            throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase wallets of WalletPool !");
                         }
-
-                        return eraseWallet(index + 1, walletsToErase);
+                        return unit;
                     });
-                };
-                return eraseWallet(0, wallets);
-
-            }).flatMap<api::ErrorCode>(getContext(), [self, name, date] (const api::ErrorCode &err) {
-
-                if (err != api::ErrorCode::FUTURE_WAS_SUCCESSFULL) {
-                    return Future<api::ErrorCode>::failure(make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to erase wallets of WalletPool !"));
-                }
-
+                });
+            }).flatMap<api::ErrorCode>(getContext(), [self, name, date] (const Unit &) {
                 //Erase wallets created after date
                 soci::session sql(self->getDatabaseSessionPool()->getPool());
                 soci::rowset<soci::row> wallets = (sql.prepare << "SELECT uid FROM wallets "
@@ -518,13 +535,42 @@ namespace ledger {
             auto self = shared_from_this();
 
             return async<api::ErrorCode>([=]() {
-                self->getDatabaseSessionPool()->performChangePassword(oldPassword, newPassword);
-                self->_externalPreferencesBackend->resetEncryption(_rng, oldPassword, newPassword);
-                self->_internalPreferencesBackend->resetEncryption(_rng, oldPassword, newPassword);
+                // Preferences are re-encrypted by chunks next to the current entries, which only get
+                // replaced once the database is re-keyed. If the change is interrupted, reopening the
+                // pool with the password the database accepts finishes it or rolls it back.
+                try {
+                    int64_t externalProcessed = 0;
+                    auto prepared = self->_externalPreferencesBackend->prepareEncryptionReset(_rng, oldPassword, newPassword, [&] (size_t processed) {
+                        externalProcessed = processed;
+                        self->emitPasswordChangeProgress("preferences", externalProcessed);
+                    }) && self->_internalPreferencesBackend->prepareEncryptionReset(_rng, oldPassword, newPassword, [&] (size_t processed) {
+                        self->emitPasswordChangeProgress("preferences", externalProcessed + processed);
+                    });
+                    // the database must not be re-keyed if the preferences can't follow
+                    if (!prepared) {
+                        throw make_exception(api::ErrorCode::ILLEGAL_STATE, "Unable to re-encrypt the preferences with the new password.");
+                    }
+                    self->getDatabaseSessionPool()->performChangePassword(oldPassword, newPassword);
+                } catch (...) {
+                    self->_externalPreferencesBackend->abortEncryptionReset();
+                    self->_internalPreferencesBackend->abortEncryptionReset();
+                    throw;
+                }
+                self->emitPasswordChangeProgress("database", 0);
+
+                self->_externalPreferencesBackend->commitEncryptionReset();
+                self->_internalPreferencesBackend->commitEncryptionReset();
                 return api::ErrorCode::FUTURE_WAS_SUCCESSFULL;
             });
         }
 
+        void WalletPool::emitPasswordChangeProgress(const std::string &storage, int64_t processedEntries) {
+            auto payload = DynamicObject::newInstance();
+            payload->putString(api::WalletPool::EV_PASSWORD_CHANGE_STORAGE, storage);
+            payload->putLong(api::WalletPool::EV_PASSWORD_CHANGE_PROCESSED_ENTRIES, processedEntries);
+            _publisher->post(Event::newInstance(api::EventCode::PASSWORD_CHANGE_PROGRESS, payload));
+        }
+
         Future<api::ErrorCode> WalletPool::freshResetAll() {
             auto self = shared_from_this();
 
@@ -69,6 +69,9 @@ namespace ledger {
             std::shared_ptr<api::PathResolver> getPathResolver() const;
             std::shared_ptr<api::RandomNumberGenerator> rng() const;
             std::shared_ptr<api::ThreadDispatcher> getDispatcher() const;
+            std::shared_ptr<api::ExecutionContext> getFanOutContext() const;
+            size_t getMaxConcurrentWalletOperations() const;
+            std::shared_ptr<api::ExecutionContext> getAccountExecutionContext(const std::string& accountUid) const;
             std::shared_ptr<spdlog::logger> logger() const;
             std::shared_ptr<DatabaseSessionPool> getDatabaseSessionPool() const;
             std::shared_ptr<DynamicObject> getConfiguration() const;
@@ -161,6 +164,8 @@ namespace ledger {
             void initializeFactories();
             std::shared_ptr<AbstractWallet> buildWallet(const WalletDatabaseEntry& entry);
 
+            void emitPasswordChangeProgress(const std::string& storage, int64_t processedEntries);
+
             static Option<WalletDatabaseEntry> getWalletEntryFromDatabase(const std::shared_ptr<WalletPool> &walletPool,
                                                                           const std::string &name);
 
@@ -192,6 +197,9 @@ namespace ledger {
 
             // Threading management
             std::shared_ptr<api::ThreadDispatcher> _threadDispatcher;
+            std::shared_ptr<api::ExecutionContext> _fanOutContext;
+            size_t _maxConcurrentWalletOperations;
+            size_t _accountExecutionContexts;
 
             // RNG management
             std::shared_ptr<api::RandomNumberGenerator> _rng;
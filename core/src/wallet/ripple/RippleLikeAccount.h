@@ -116,6 +116,8 @@ namespace ledger {
 
             void getBaseReserve(const std::shared_ptr<api::AmountCallback> & callback) override;
             FuturePtr<api::Amount> getBaseReserve();
+
+            const std::shared_ptr<RippleLikeBlockchainExplorer>& getExplorer() const;
         private:
             std::shared_ptr<RippleLikeAccount> getSelf();
 
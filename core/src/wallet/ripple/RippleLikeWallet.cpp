@@ -68,14 +68,6 @@ namespace ledger {
             _synchronizerFactory = synchronizer;
         }
 
-        bool RippleLikeWallet::isSynchronizing() {
-            return false;
-        }
-
-        std::shared_ptr<api::EventBus> RippleLikeWallet::synchronize() {
-            return nullptr;
-        }
-
         FuturePtr<ledger::core::api::Account>
         RippleLikeWallet::newAccountWithInfo(const api::AccountCreationInfo &info) {
             if (info.chainCodes.size() != 1 || info.publicKeys.size() != 1 || info.owners.size() != 1)
@@ -167,9 +159,7 @@ namespace ledger {
                         info.index = accountIndex;
                         auto scheme = self->getDerivationScheme();
                         scheme.setCoinType(self->getCurrency().bip44CoinType).setAccountIndex(accountIndex);;
-                        auto keychainEngine = self->getConfiguration()->getString(
-                                api::Configuration::KEYCHAIN_ENGINE).value_or(
-                                api::ConfigurationDefaults::DEFAULT_KEYCHAIN);
+                        auto& keychainEngine = self->getConfigSnapshot().keychainEngine;
                         if (keychainEngine == api::KeychainEngines::BIP32_P2PKH ||
                             keychainEngine == api::KeychainEngines::BIP49_P2SH) {
                             auto xpubPath = scheme.getSchemeTo(DerivationSchemeLevel::ACCOUNT_INDEX).getPath();
@@ -35,6 +35,9 @@
 #include <database/soci-number.h>
 #include <crypto/SHA256.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
+#include <database/BulkInsert.hpp>
+#include <database/Upsert.hpp>
+#include <numeric>
 
 using namespace soci;
 
@@ -118,46 +121,41 @@ namespace ledger {
 
             auto rippleTxUid = createRippleTransactionUid(accountUid, tx.hash);
 
-            if (transactionExists(sql, rippleTxUid)) {
+            if (tx.block.nonEmpty()) {
+                BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
+            }
+            auto hexValue = tx.value.toHexString();
+            auto hexFees = tx.fees.toHexString();
+            soci::statement insertion = (sql.prepare
+                    << insertOrIgnore(sql, "ripple_transactions", "VALUES(:tx_uid, :hash, :value, :block_uid, :time, :sender, :receiver, :fees, :confirmations)", "transaction_uid"),
+                    use(rippleTxUid),
+                    use(tx.hash),
+                    use(hexValue),
+                    use(blockUid),
+                    use(tx.receivedAt),
+                    use(tx.sender),
+                    use(tx.receiver),
+                    use(hexFees),
+                    use(tx.confirmations));
+            insertion.execute(true);
+
+            if (insertion.get_affected_rows() > 0) {
+                std::vector<int> fieldIndexes(tx.memos.size());
+                std::iota(fieldIndexes.begin(), fieldIndexes.end(), 0);
+                bulkInsert(sql, "ripple_memos", 5, fieldIndexes, [&] (soci::statement& statement, const int& fieldIndex) {
+                    auto& memo = tx.memos[fieldIndex];
+                    statement.exchange(use(rippleTxUid));
+                    statement.exchange(use(memo.data));
+                    statement.exchange(use(memo.fmt));
+                    statement.exchange(use(memo.ty));
+                    statement.exchange(use(fieldIndex));
+                });
+            } else if (tx.block.nonEmpty()) {
                 // UPDATE (we only update block information)
-                if (tx.block.nonEmpty()) {
-                    sql << "UPDATE ripple_transactions SET block_uid = :uid WHERE hash = :tx_hash",
-                            use(blockUid), use(tx.hash);
-                }
-                return rippleTxUid;
-            } else {
-                // Insert
-                if (tx.block.nonEmpty()) {
-                    BlockDatabaseHelper::putBlock(sql, tx.block.getValue());
-                }
-                auto hexValue = tx.value.toHexString();
-                auto hexFees = tx.fees.toHexString();
-                sql
-                        << "INSERT INTO ripple_transactions VALUES(:tx_uid, :hash, :value, :block_uid, :time, :sender, :receiver, :fees, :confirmations)",
-                        use(rippleTxUid),
-                        use(tx.hash),
-                        use(hexValue),
-                        use(blockUid),
-                        use(tx.receivedAt),
-                        use(tx.sender),
-                        use(tx.receiver),
-                        use(hexFees),
-                        use(tx.confirmations);
-
-                int fieldIndex = 0;
-                for (auto& memo : tx.memos) {
-                    sql << "INSERT INTO ripple_memos VALUES (:tx_uid, :data, :fmt, :ty, :i)",
-                           use(rippleTxUid),
-                           use(memo.data),
-                           use(memo.fmt),
-                           use(memo.ty),
-                           use(fieldIndex);
-
-                    ++fieldIndex;
-                }
-
-                return rippleTxUid;
+                sql << "UPDATE ripple_transactions SET block_uid = :uid WHERE hash = :tx_hash",
+                        use(blockUid), use(tx.hash);
             }
+            return rippleTxUid;
         }
     }
 }
@@ -145,15 +145,17 @@ namespace ledger {
         }
 
         FuturePtr<Block> ApiRippleLikeBlockchainExplorer::getCurrentBlock() const {
-            return _http->GET(fmt::format("/{}/ledgers", getExplorerVersion()))
-                    .template json<Block, Exception>(LedgerApiParser<Block, RippleLikeBlockParser>())
-                    .template mapPtr<Block>(getExplorerContext(), [] (const Either<Exception, std::shared_ptr<Block>>& result) {
-                        if (result.isLeft()) {
-                            throw result.getLeft();
-                        } else {
-                            return result.getRight();
-                        }
-                    });
+            return _currentBlockCache.get([this] () {
+                return _http->GET(fmt::format("/{}/ledgers", getExplorerVersion()))
+                        .template json<Block, Exception>(LedgerApiParser<Block, RippleLikeBlockParser>())
+                        .template mapPtr<Block>(getExplorerContext(), [] (const Either<Exception, std::shared_ptr<Block>>& result) {
+                            if (result.isLeft()) {
+                                throw result.getLeft();
+                            } else {
+                                return result.getRight();
+                            }
+                        });
+            });
         }
 
         FuturePtr<RippleLikeBlockchainExplorerTransaction>
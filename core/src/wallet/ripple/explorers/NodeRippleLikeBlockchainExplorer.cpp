@@ -43,9 +43,11 @@ namespace ledger {
                 const api::RippleLikeNetworkParameters &parameters,
                 const std::shared_ptr<api::DynamicObject> &configuration) :
                 DedicatedContext(context),
-                RippleLikeBlockchainExplorer(configuration, {api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT}) {
+                RippleLikeBlockchainExplorer(configuration, {api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT,
+                                                             api::Configuration::BLOCKCHAIN_EXPLORER_PORT}) {
             _http = http;
             _parameters = parameters;
+            _batcher = std::make_shared<NodeRippleLikeRequestBatcher>(http, context);
         }
 
 
@@ -67,12 +69,16 @@ namespace ledger {
 
         Future<std::shared_ptr<BigInt>>
         NodeRippleLikeBlockchainExplorer::getFees() {
-            return getServerInfo("base_fee_xrp", FieldTypes::NumberType);
+            return _feesCache.get([this] () {
+                return getServerInfo("base_fee_xrp", FieldTypes::NumberType);
+            });
         }
 
         Future<std::shared_ptr<BigInt>>
         NodeRippleLikeBlockchainExplorer::getBaseReserve() {
-            return getServerInfo("reserve_base_xrp", FieldTypes::StringType);
+            return _baseReserveCache.get([this] () {
+                return getServerInfo("reserve_base_xrp", FieldTypes::StringType);
+            });
         }
 
         Future<std::shared_ptr<BigInt>>
@@ -81,9 +87,9 @@ namespace ledger {
             bodyRequest.setMethod("server_info");
             auto requestBody = bodyRequest.getString();
             bool parseNumberAsString = type == FieldTypes::StringType;
-            return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
-                    .json(parseNumberAsString).mapPtr<BigInt>(getContext(), [field, type](const HttpRequest::JsonResult &result) {
-                        auto &json = *std::get<1>(result);
+            return _batcher->request(requestBody, parseNumberAsString)
+                    .mapPtr<BigInt>(getContext(), [field, type](const std::shared_ptr<rapidjson::Document> &result) {
+                        auto &json = *result;
                         //Is there a result field ?
                         if (!json.IsObject() || !json.HasMember("result") ||
                             !json["result"].IsObject()) {
@@ -140,9 +146,9 @@ namespace ledger {
             bodyRequest.setMethod("submit");
             bodyRequest.pushParameter("tx_blob", hex::toString(transaction));
             auto requestBody = bodyRequest.getString();
-            return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
-                    .json().template map<String>(getExplorerContext(), [](const HttpRequest::JsonResult &result) -> String {
-                        auto &json = *std::get<1>(result);
+            return _batcher->request(requestBody)
+                    .template map<String>(getExplorerContext(), [](const std::shared_ptr<rapidjson::Document> &result) -> String {
+                        auto &json = *result;
                         if (!json.IsObject() || !json.HasMember("result") ||
                             !json["result"].IsObject()) {
                             throw make_exception(api::ErrorCode::HTTP_ERROR, "Failed to broadcast transaction, no (or malformed) field \"result\" in response");
@@ -161,18 +167,20 @@ namespace ledger {
         }
 
         Future<Unit> NodeRippleLikeBlockchainExplorer::killSession(void *session) {
+            // The session holds the pagination marker of the account_tx calls
+            delete reinterpret_cast<std::string *>(session);
             return Future<Unit>::successful(unit);
         }
 
         Future<Bytes> NodeRippleLikeBlockchainExplorer::getRawTransaction(const String &transactionHash) {
             NodeRippleLikeBodyRequest bodyRequest;
             bodyRequest.setMethod("tx");
-            bodyRequest.pushParameter("trasnaction", transactionHash);
+            bodyRequest.pushParameter("transaction", transactionHash);
             bodyRequest.pushParameter("binary", "true");
             auto requestBody = bodyRequest.getString();
-            return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
-                    .json().template map<Bytes>(getExplorerContext(), [](const HttpRequest::JsonResult &result) -> Bytes {
-                        auto &json = *std::get<1>(result);
+            return _batcher->request(requestBody)
+                    .template map<Bytes>(getExplorerContext(), [](const std::shared_ptr<rapidjson::Document> &result) -> Bytes {
+                        auto &json = *result;
                         if (!json.IsObject() || !json.HasMember("result") ||
                             !json["result"].IsObject()) {
                             throw make_exception(api::ErrorCode::HTTP_ERROR, "Failed to get raw transaction, no (or malformed) field \"result\" in response");
@@ -201,13 +209,23 @@ namespace ledger {
             NodeRippleLikeBodyRequest bodyRequest;
             bodyRequest.setMethod("account_tx");
             bodyRequest.pushParameter("account", addresses[0]);
+            // Resume from the marker returned by the previous page of this session
+            auto marker = session.isEmpty() ? nullptr : reinterpret_cast<std::string *>(session.getValue());
+            if (marker != nullptr && !marker->empty()) {
+                bodyRequest.pushRawParameter("marker", *marker);
+            }
             auto requestBody = bodyRequest.getString();
             return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
                     .template json<TransactionsBulk, Exception>(
                             LedgerApiParser<TransactionsBulk, RippleLikeTransactionsBulkParser>())
-                    .template mapPtr<TransactionsBulk>(getExplorerContext(), [fromBlockHash](
+                    .template mapPtr<TransactionsBulk>(getExplorerContext(), [fromBlockHash, marker](
                             const Either<Exception, std::shared_ptr<TransactionsBulk>> &result) {
                         if (result.isLeft()) {
+                            // The synchronizer recovers from a failure (e.g. a reorganization) by restarting
+                            // from an older block, the marker of the failed page must not be reused then
+                            if (marker != nullptr) {
+                                marker->clear();
+                            }
                             if (fromBlockHash.isEmpty()) {
                                 throw result.getLeft();
                             } else {
@@ -215,26 +233,38 @@ namespace ledger {
                                                      "Unable to find block with hash {}", fromBlockHash.getValue());
                             }
                         } else {
-                            return result.getRight();
+                            auto bulk = result.getRight();
+                            bulk->hasNext = !bulk->marker.empty();
+                            if (marker != nullptr) {
+                                *marker = bulk->marker;
+                            }
+                            return bulk;
+                        }
+                    }).recover(getExplorerContext(), [marker] (const Exception &exception) -> std::shared_ptr<TransactionsBulk> {
+                        if (marker != nullptr) {
+                            marker->clear();
                         }
+                        throw exception;
                     });
         }
 
         FuturePtr<Block> NodeRippleLikeBlockchainExplorer::getCurrentBlock() const {
-            NodeRippleLikeBodyRequest bodyRequest;
-            bodyRequest.setMethod("ledger");
-            bodyRequest.pushParameter("ledger_index", std::string("validated"));
-            auto requestBody = bodyRequest.getString();
-            return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
-                    .template json<Block, Exception>(LedgerApiParser<Block, RippleLikeBlockParser>())
-                    .template mapPtr<Block>(getExplorerContext(),
-                                                   [](const Either<Exception, std::shared_ptr<Block>> &result) {
-                                                       if (result.isLeft()) {
-                                                           throw result.getLeft();
-                                                       } else {
-                                                           return result.getRight();
-                                                       }
-                                                   });
+            return _currentBlockCache.get([this] () {
+                NodeRippleLikeBodyRequest bodyRequest;
+                bodyRequest.setMethod("ledger");
+                bodyRequest.pushParameter("ledger_index", std::string("validated"));
+                auto requestBody = bodyRequest.getString();
+                return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
+                        .template json<Block, Exception>(LedgerApiParser<Block, RippleLikeBlockParser>())
+                        .template mapPtr<Block>(getExplorerContext(),
+                                                       [](const Either<Exception, std::shared_ptr<Block>> &result) {
+                                                           if (result.isLeft()) {
+                                                               throw result.getLeft();
+                                                           } else {
+                                                               return result.getRight();
+                                                           }
+                                                       });
+            });
         }
 
         FuturePtr<RippleLikeBlockchainExplorerTransaction>
@@ -258,6 +288,11 @@ namespace ledger {
             return "";
         }
 
+        void NodeRippleLikeBlockchainExplorer::onNewBlock(const Block &block) {
+            RippleLikeBlockchainExplorer::onNewBlock(block);
+            _feesCache.invalidate();
+        }
+
 
         Future<std::shared_ptr<BigInt>>
         NodeRippleLikeBlockchainExplorer::getAccountInfo(const std::string &address,
@@ -268,9 +303,9 @@ namespace ledger {
             bodyRequest.pushParameter("account", address);
             bodyRequest.pushParameter("ledger_index", std::string("validated"));
             auto requestBody = bodyRequest.getString();
-            return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()))
-                    .json().mapPtr<BigInt>(getContext(), [address, key, type](const HttpRequest::JsonResult &result) {
-                        auto &json = *std::get<1>(result);
+            return _batcher->request(requestBody)
+                    .mapPtr<BigInt>(getContext(), [address, key, type](const std::shared_ptr<rapidjson::Document> &result) {
+                        auto &json = *result;
                         //Is there a result field ?
                         if (!json.IsObject() || !json.HasMember("result") ||
                             !json["result"].IsObject()) {
@@ -38,6 +38,7 @@
 #include <wallet/ripple/explorers/api/RippleLikeTransactionsParser.h>
 #include <wallet/ripple/explorers/api/RippleLikeTransactionsBulkParser.h>
 #include <wallet/ripple/explorers/api/RippleLikeBlockParser.h>
+#include <wallet/ripple/explorers/NodeRippleLikeRequestBatcher.h>
 #include <api/RippleLikeNetworkParameters.hpp>
 
 namespace ledger {
@@ -89,6 +90,20 @@ namespace ledger {
                 return *this;
             };
 
+            // Push a parameter whose value is already serialized as JSON (e.g. a pagination marker)
+            NodeRippleLikeBodyRequest &pushRawParameter(const std::string &key, const std::string &json) {
+                rapidjson::Document::AllocatorType &allocator = _document.GetAllocator();
+                rapidjson::Value vKeyParam(rapidjson::kStringType);
+                vKeyParam.SetString(key.c_str(), static_cast<rapidjson::SizeType>(key.length()), allocator);
+                rapidjson::Document vParam(&allocator);
+                vParam.Parse(json.c_str(), json.length());
+                if (vParam.HasParseError()) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Invalid JSON value for parameter {}", key);
+                }
+                _params.AddMember(vKeyParam, vParam.Move(), allocator);
+                return *this;
+            };
+
             std::string getString() {
                 rapidjson::Document::AllocatorType &allocator = _document.GetAllocator();
                 rapidjson::Value container(rapidjson::kArrayType);
@@ -159,6 +174,8 @@ namespace ledger {
 
             std::string getExplorerVersion() const override;
 
+            void onNewBlock(const Block &block) override;
+
         private:
             Future<std::shared_ptr<BigInt>>
             getAccountInfo(const std::string &address,
@@ -166,6 +183,10 @@ namespace ledger {
                            FieldTypes);
 
             api::RippleLikeNetworkParameters _parameters;
+            std::shared_ptr<NodeRippleLikeRequestBatcher> _batcher;
+            ExpiringCache<std::shared_ptr<BigInt>> _feesCache {std::chrono::seconds(30)};
+            // The base reserve only changes through amendments, it is not invalidated by new ledgers
+            ExpiringCache<std::shared_ptr<BigInt>> _baseReserveCache {std::chrono::seconds(30)};
         };
     }
 }
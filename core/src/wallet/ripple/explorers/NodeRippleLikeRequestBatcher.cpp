@@ -0,0 +1,154 @@
+/*
+ *
+ * NodeRippleLikeRequestBatcher
+ *
+ * Created by Ledger on 21/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include "NodeRippleLikeRequestBatcher.h"
+#include <utils/Exception.hpp>
+#include <utils/LambdaRunnable.hpp>
+
+namespace ledger {
+    namespace core {
+
+        const size_t NodeRippleLikeRequestBatcher::MAX_BATCH_SIZE;
+
+        NodeRippleLikeRequestBatcher::NodeRippleLikeRequestBatcher(const std::shared_ptr<HttpClient> &http,
+                                                                   const std::shared_ptr<api::ExecutionContext> &context) :
+                _http(http), _context(context) {
+        }
+
+        Future<std::shared_ptr<rapidjson::Document>>
+        NodeRippleLikeRequestBatcher::request(const std::string &body, bool parseNumbersAsString) {
+            auto key = fmt::format("{}{}", parseNumbersAsString ? 's' : 'n', body);
+            auto request = std::make_shared<PendingRequest>();
+            bool needsFlush = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _inFlight.find(key);
+                if (it != _inFlight.end()) {
+                    return it->second;
+                }
+                request->key = key;
+                request->body = body;
+                _inFlight.emplace(key, request->promise.getFuture());
+                auto &pending = _pending[parseNumbersAsString ? 1 : 0];
+                pending.push_back(request);
+                needsFlush = pending.size() == 1;
+            }
+            if (needsFlush) {
+                auto self = shared_from_this();
+                _context->execute(make_runnable([self, parseNumbersAsString] () {
+                    self->flush(parseNumbersAsString);
+                }));
+            }
+            return request->promise.getFuture();
+        }
+
+        void NodeRippleLikeRequestBatcher::flush(bool parseNumbersAsString) {
+            std::vector<std::shared_ptr<PendingRequest>> requests;
+            bool needsFlush = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto &pending = _pending[parseNumbersAsString ? 1 : 0];
+                auto count = std::min(pending.size(), MAX_BATCH_SIZE);
+                requests.assign(pending.begin(), pending.begin() + count);
+                pending.erase(pending.begin(), pending.begin() + count);
+                needsFlush = !pending.empty();
+            }
+            if (needsFlush) {
+                auto self = shared_from_this();
+                _context->execute(make_runnable([self, parseNumbersAsString] () {
+                    self->flush(parseNumbersAsString);
+                }));
+            }
+            if (requests.empty()) {
+                return;
+            }
+
+            std::string body;
+            if (requests.size() == 1) {
+                body = requests.front()->body;
+            } else {
+                body = "{\"method\":\"batch\",\"params\":[";
+                for (size_t index = 0; index < requests.size(); index++) {
+                    if (index > 0) {
+                        body += ",";
+                    }
+                    body += requests[index]->body;
+                }
+                body += "]}";
+            }
+
+            auto self = shared_from_this();
+            _http->POST("", std::vector<uint8_t>(body.begin(), body.end()))
+                    .json(parseNumbersAsString)
+                    .onComplete(_context, [self, requests] (const Try<HttpRequest::JsonResult> &result) {
+                        self->complete(requests, result);
+                    });
+        }
+
+        void NodeRippleLikeRequestBatcher::complete(const std::vector<std::shared_ptr<PendingRequest>> &requests,
+                                                    const Try<HttpRequest::JsonResult> &result) {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                for (const auto &request : requests) {
+                    _inFlight.erase(request->key);
+                }
+            }
+
+            if (result.isFailure()) {
+                for (const auto &request : requests) {
+                    request->promise.failure(result.getFailure());
+                }
+                return;
+            }
+
+            auto &json = *std::get<1>(result.getValue());
+            if (requests.size() == 1) {
+                requests.front()->promise.success(std::get<1>(result.getValue()));
+                return;
+            }
+
+            // A batch is answered with an array holding the response of each request, in order
+            if (!json.IsArray() || json.Size() != requests.size()) {
+                auto error = make_exception(api::ErrorCode::HTTP_ERROR,
+                                            "Malformed response to a batch of {} requests", requests.size());
+                for (const auto &request : requests) {
+                    request->promise.failure(error);
+                }
+                return;
+            }
+            for (rapidjson::SizeType index = 0; index < json.Size(); index++) {
+                auto document = std::make_shared<rapidjson::Document>();
+                document->CopyFrom(json[index], document->GetAllocator());
+                requests[index]->promise.success(document);
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ *
+ * NodeRippleLikeRequestBatcher
+ *
+ * Created by Ledger on 21/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#ifndef LEDGER_CORE_NODERIPPLELIKEREQUESTBATCHER_H
+#define LEDGER_CORE_NODERIPPLELIKEREQUESTBATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <rapidjson/document.h>
+#include <api/ExecutionContext.hpp>
+#include <async/Future.hpp>
+#include <async/Promise.hpp>
+#include <net/HttpClient.hpp>
+
+namespace ledger {
+    namespace core {
+
+        // Combine JSON-RPC calls sent to a Ripple node.
+        //
+        // Requests issued while a previous call is waiting to be sent are grouped in a single
+        // "batch" call (see rippled JSON-RPC batch method), and identical requests that are
+        // already in flight share the same response.
+        class NodeRippleLikeRequestBatcher : public std::enable_shared_from_this<NodeRippleLikeRequestBatcher> {
+        public:
+            static const size_t MAX_BATCH_SIZE = 50;
+
+            NodeRippleLikeRequestBatcher(const std::shared_ptr<HttpClient> &http,
+                                         const std::shared_ptr<api::ExecutionContext> &context);
+
+            // Send a JSON-RPC request ({"method": ..., "params": [...]}). The future is resolved
+            // with the node response to that request ({"result": ...}).
+            Future<std::shared_ptr<rapidjson::Document>> request(const std::string &body,
+                                                                 bool parseNumbersAsString = false);
+
+        private:
+            struct PendingRequest {
+                std::string key;
+                std::string body;
+                Promise<std::shared_ptr<rapidjson::Document>> promise;
+            };
+
+            void flush(bool parseNumbersAsString);
+            void complete(const std::vector<std::shared_ptr<PendingRequest>> &requests,
+                          const Try<HttpRequest::JsonResult> &result);
+
+            std::shared_ptr<HttpClient> _http;
+            std::shared_ptr<api::ExecutionContext> _context;
+            std::mutex _lock;
+            // Pending requests, indexed by number parsing mode
+            std::vector<std::shared_ptr<PendingRequest>> _pending[2];
+            std::unordered_map<std::string, Future<std::shared_ptr<rapidjson::Document>>> _inFlight;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_NODERIPPLELIKEREQUESTBATCHER_H
@@ -35,6 +35,7 @@
 #include "../RippleLikeBlockchainExplorer.h"
 #include "RippleLikeTransactionsParser.h"
 #include <wallet/common/explorers/api/AbstractTransactionsBulkParser.h>
+#include <fmt/format.h>
 
 namespace ledger {
     namespace core {
@@ -46,8 +47,41 @@ namespace ledger {
             RippleLikeTransactionsBulkParser(std::string &lastKey) : _lastKey(lastKey),
                                                                      _transactionsParser(lastKey) {
                 _depth = 0;
+                _inMarker = false;
             };
 
+            // Nodes return the pagination marker as an object ({"ledger": ..., "seq": ...}), it is
+            // kept as its JSON representation so that it can be sent back as is in the next request.
+            bool StartObject() {
+                if (_depth == 0 && getLastKey() == "marker") {
+                    _inMarker = true;
+                    _markerLedger.clear();
+                    _markerSeq.clear();
+                }
+                PROXY_PARSE_TXS(StartObject)
+            }
+
+            bool EndObject(rapidjson::SizeType memberCount) {
+                if (_depth == 0 && _inMarker) {
+                    _inMarker = false;
+                    if (!_markerLedger.empty() && !_markerSeq.empty()) {
+                        _bulk->marker = fmt::format("{{\"ledger\":{},\"seq\":{}}}", _markerLedger, _markerSeq);
+                    }
+                }
+                PROXY_PARSE_TXS(EndObject, memberCount)
+            }
+
+            bool RawNumber(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
+                if (_depth == 0 && _inMarker) {
+                    if (getLastKey() == "ledger") {
+                        _markerLedger = std::string(str, length);
+                    } else if (getLastKey() == "seq") {
+                        _markerSeq = std::string(str, length);
+                    }
+                }
+                PROXY_PARSE_TXS(RawNumber, str, length, copy)
+            }
+
             bool StartArray() {
                 if (_depth >= 1 || getLastKey() == "transactions") {
                     _depth += 1;
@@ -63,7 +97,7 @@ namespace ledger {
             bool String(const rapidjson::Reader::Ch *str, rapidjson::SizeType length, bool copy) {
                 std::string value = std::string(str, length);
                 if (_depth == 0 && getLastKey() == "marker") {
-                    _bulk->marker = value;
+                    _bulk->marker = fmt::format("\"{}\"", value);
                 }
                 PROXY_PARSE_TXS(String, str, length, copy)
             }
@@ -85,6 +119,9 @@ namespace ledger {
         private:
             RippleLikeTransactionsParser _transactionsParser;
             std::string &_lastKey;
+            bool _inMarker;
+            std::string _markerLedger;
+            std::string _markerSeq;
         };
     }
 }
@@ -135,7 +135,7 @@ namespace ledger {
                     api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT
             ).value_or(api::RippleConfigurationDefaults::RIPPLE_OBSERVER_NODE_ENDPOINT_S2),
                     configuration->getString(
-                            api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT
+                            api::Configuration::BLOCKCHAIN_EXPLORER_PORT
                     ).value_or(api::RippleConfigurationDefaults::RIPPLE_DEFAULT_PORT))
                 );
                 auto context = pool->getDispatcher()->getSerialExecutionContext(api::BlockchainObserverEngines::RIPPLE_NODE);
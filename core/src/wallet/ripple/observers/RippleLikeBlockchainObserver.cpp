@@ -70,24 +70,22 @@ namespace ledger {
         }
 
         void RippleLikeBlockchainObserver::putTransaction(const RippleLikeBlockchainExplorerTransaction &tx) {
-            std::lock_guard<std::mutex> lock(_lock);
-            for (const auto &account : _accounts) {
-                account->run([account, tx]() {
-                    soci::session sql(account->getWallet()->getDatabase()->getPool());
-                    if (account->putTransaction(sql, tx) != RippleLikeAccount::FLAG_TRANSACTION_IGNORED)
-                        account->emitEventsNow();
-                });
-            }
+            putTransactions({tx});
         }
 
-        void RippleLikeBlockchainObserver::putBlock(const RippleLikeBlockchainExplorer::Block &block) {
+        void RippleLikeBlockchainObserver::putTransactions(const std::vector<RippleLikeBlockchainExplorerTransaction> &transactions) {
             std::lock_guard<std::mutex> lock(_lock);
             for (const auto &account : _accounts) {
-                account->run([account, block]() {
+                account->run([account, transactions]() {
                     bool shouldEmitNow = false;
                     {
                         soci::session sql(account->getWallet()->getDatabase()->getPool());
-                        shouldEmitNow = account->putBlock(sql, block);
+                        soci::transaction tr(sql);
+                        for (const auto &tx : transactions) {
+                            if (account->putTransaction(sql, tx) != RippleLikeAccount::FLAG_TRANSACTION_IGNORED)
+                                shouldEmitNow = true;
+                        }
+                        tr.commit();
                     }
                     if (shouldEmitNow)
                         account->emitEventsNow();
@@ -95,6 +93,28 @@ namespace ledger {
             }
         }
 
+        void RippleLikeBlockchainObserver::putBlock(const RippleLikeBlockchainExplorer::Block &block) {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_accounts.empty())
+                return;
+            // Explorers cache the current block for the accounts sharing them, refresh it before accounts ask for it
+            for (auto& observed : _accounts) {
+                observed->getExplorer()->onNewBlock(block);
+            }
+            // Blocks are stored per currency and all the observed accounts share the same database,
+            // so a single account writes the block (and emits the new block event).
+            auto account = _accounts.front();
+            account->run([account, block]() {
+                bool shouldEmitNow = false;
+                {
+                    soci::session sql(account->getWallet()->getDatabase()->getPool());
+                    shouldEmitNow = account->putBlock(sql, block);
+                }
+                if (shouldEmitNow)
+                    account->emitEventsNow();
+            });
+        }
+
 
         void RippleLikeBlockchainObserver::onStart() {
             connect();
@@ -136,15 +156,35 @@ namespace ledger {
 
 
         void RippleLikeBlockchainObserver::onMessage(const std::string &message) {
+            // Messages received while the previous ones are still waiting for the observer context
+            // are handled together, so that bursts of transactions are written in grouped DB writes.
+            if (!pushPendingMessage(message))
+                return;
             auto self = shared_from_this();
-            run([message, self]() {
-                auto result = JSONUtils::parse<RippleLikeWebSocketNotificationParser>(message);
-                result->block.currencyName = self->getCurrency().name;
-                if (result->type == "transaction") {
-                    self->putTransaction(result->transaction);
-                } else if (result->type == "ledgerClosed") {
-                    self->putBlock(result->block);
+            run([self]() {
+                std::vector<RippleLikeBlockchainExplorerTransaction> transactions;
+                for (const auto &pendingMessage : self->takePendingMessages()) {
+                    // A malformed frame must not drop the rest of the burst
+                    std::shared_ptr<RippleLikeWebSocketNotificationParser::Result> result;
+                    try {
+                        result = JSONUtils::parse<RippleLikeWebSocketNotificationParser>(pendingMessage);
+                    } catch (const std::exception &ex) {
+                        self->logger()->error("Unable to parse {} observer message: {}", self->getCurrency().name, ex.what());
+                        continue;
+                    }
+                    result->block.currencyName = self->getCurrency().name;
+                    if (result->type == "transaction") {
+                        transactions.push_back(result->transaction);
+                    } else if (result->type == "ledgerClosed") {
+                        if (!transactions.empty()) {
+                            self->putTransactions(transactions);
+                            transactions.clear();
+                        }
+                        self->putBlock(result->block);
+                    }
                 }
+                if (!transactions.empty())
+                    self->putTransactions(transactions);
             });
         }
 
@@ -80,6 +80,8 @@ namespace ledger {
         protected:
             void putTransaction(const RippleLikeBlockchainExplorerTransaction &tx) override;
 
+            void putTransactions(const std::vector<RippleLikeBlockchainExplorerTransaction> &transactions) override;
+
             void putBlock(const RippleLikeBlockchainExplorer::Block &block) override;
 
             const api::Currency &getCurrency() const {
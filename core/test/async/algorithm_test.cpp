@@ -0,0 +1,174 @@
+/*
+ *
+ * algorithm_test
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <src/async/algorithm.h>
+#include <async/QtThreadDispatcher.hpp>
+#include <atomic>
+#include <thread>
+
+#undef foreach
+
+using namespace ledger::core;
+using namespace ledger::qt;
+
+TEST(Algorithm, DoWhileRunsManyIterations) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto queue = dispatcher->getSerialExecutionContext("queue");
+    auto counter = std::make_shared<int>(0);
+    async::doWhile(queue, [counter] () {
+        *counter += 1;
+        return Future<bool>::successful(*counter < 100000);
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher, counter] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        EXPECT_EQ(100000, *counter);
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, DoWhileStopsOnFailure) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto queue = dispatcher->getSerialExecutionContext("queue");
+    auto counter = std::make_shared<int>(0);
+    async::doWhile(queue, [counter, queue] () {
+        return Future<bool>::async(queue, [counter] () -> bool {
+            if (++(*counter) == 5)
+                throw Exception(api::ErrorCode::RUNTIME_ERROR, "Failed on 5");
+            return true;
+        });
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher, counter] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isFailure());
+        EXPECT_EQ(5, *counter);
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, ForEachIsSequential) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto queue = dispatcher->getThreadPoolExecutionContext("queue");
+    auto visited = std::make_shared<std::vector<int>>();
+    async::forEach<int>(queue, {1, 2, 3, 4, 5}, [queue, visited] (const int& value) {
+        return Future<Unit>::async(queue, [visited, value] () {
+            visited->push_back(value);
+            return unit;
+        });
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher, visited] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        EXPECT_EQ(std::vector<int>({1, 2, 3, 4, 5}), *visited);
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, FoldLeft) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto queue = dispatcher->getSerialExecutionContext("queue");
+    std::vector<std::string> words({"Hello", " ", "world"});
+    async::foldLeft<std::string, std::string>(queue, words, "", [] (const std::string& acc, const std::string& word) {
+        return Future<std::string>::successful(acc + word);
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher] (const Try<std::string>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isSuccess()) {
+            EXPECT_EQ("Hello world", result.getValue());
+        }
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, ParallelForEachIsBounded) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto pool = dispatcher->getThreadPoolExecutionContext("pool");
+    auto running = std::make_shared<std::atomic<int>>(0);
+    auto maxRunning = std::make_shared<std::atomic<int>>(0);
+    auto visited = std::make_shared<std::atomic<int>>(0);
+    std::vector<int> items(50);
+    async::parallelForEach<int>(pool, items, 3, [pool, running, maxRunning, visited] (const int&) {
+        auto current = ++(*running);
+        auto max = maxRunning->load();
+        while (current > max && !maxRunning->compare_exchange_weak(max, current));
+        return Future<Unit>::async(pool, [running, visited] () {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++(*visited);
+            --(*running);
+            return unit;
+        });
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher, maxRunning, visited] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        EXPECT_EQ(50, visited->load());
+        EXPECT_LE(maxRunning->load(), 3);
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, ParallelForEachFailure) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto pool = dispatcher->getThreadPoolExecutionContext("pool");
+    async::parallelForEach<int>(pool, {1, 2, 3, 4, 5, 6}, 2, [] (const int& value) {
+        if (value == 4)
+            return Future<Unit>::failure(Exception(api::ErrorCode::RUNTIME_ERROR, "Failed on 4"));
+        return Future<Unit>::successful(unit);
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isFailure());
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
+
+TEST(Algorithm, ParallelForEachFailureWaitsForRunningWorkers) {
+    auto dispatcher = std::make_shared<ledger::qt::QtThreadDispatcher>(nullptr);
+    auto pool = dispatcher->getThreadPoolExecutionContext("pool");
+    auto started = std::make_shared<Promise<Unit>>();
+    auto done = std::make_shared<std::atomic<bool>>(false);
+    async::parallelForEach<int>(pool, {1, 2}, 2, [pool, started, done] (const int& value) {
+        if (value == 1) {
+            // Fail once the other element is being processed
+            return started->getFuture().map<Unit>(pool, [] (const Unit&) -> Unit {
+                throw Exception(api::ErrorCode::RUNTIME_ERROR, "Failed on 1");
+            });
+        }
+        started->success(unit);
+        return Future<Unit>::async(pool, [done] () {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            *done = true;
+            return unit;
+        });
+    }).onComplete(dispatcher->getMainExecutionContext(), [dispatcher, done] (const Try<Unit>& result) {
+        EXPECT_TRUE(result.isFailure());
+        EXPECT_EQ(result.getFailure().getErrorCode(), api::ErrorCode::RUNTIME_ERROR);
+        EXPECT_TRUE(done->load());
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+}
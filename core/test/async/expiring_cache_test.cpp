@@ -0,0 +1,98 @@
+/*
+ *
+ * expiring_cache_test
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <src/async/ExpiringCache.hpp>
+
+using namespace ledger::core;
+
+TEST(ExpiringCache, SharesRunningFetch) {
+    ExpiringCache<int> cache(std::chrono::minutes(1));
+    Promise<int> promise;
+    auto fetches = 0;
+    auto fetch = [&] () {
+        fetches += 1;
+        return promise.getFuture();
+    };
+    auto first = cache.get(fetch);
+    auto second = cache.get(fetch);
+    EXPECT_FALSE(first.isCompleted());
+    promise.success(42);
+    EXPECT_EQ(first.getValue().getValue().getValue(), 42);
+    EXPECT_EQ(second.getValue().getValue().getValue(), 42);
+    EXPECT_EQ(cache.get(fetch).getValue().getValue().getValue(), 42);
+    EXPECT_EQ(fetches, 1);
+}
+
+TEST(ExpiringCache, RefetchesExpiredValues) {
+    ExpiringCache<int> cache(std::chrono::milliseconds(0));
+    auto fetches = 0;
+    auto fetch = [&] () {
+        fetches += 1;
+        return Future<int>::successful(fetches);
+    };
+    EXPECT_EQ(cache.get(fetch).getValue().getValue().getValue(), 1);
+    EXPECT_EQ(cache.get(fetch).getValue().getValue().getValue(), 2);
+}
+
+TEST(ExpiringCache, DoesNotCacheFailures) {
+    ExpiringCache<int> cache(std::chrono::minutes(1));
+    auto fetches = 0;
+    auto fetch = [&] () {
+        fetches += 1;
+        if (fetches == 1) {
+            return Future<int>::failure(Exception(api::ErrorCode::HTTP_ERROR, "Unreachable"));
+        }
+        return Future<int>::successful(fetches);
+    };
+    EXPECT_TRUE(cache.get(fetch).getValue().getValue().isFailure());
+    EXPECT_EQ(cache.get(fetch).getValue().getValue().getValue(), 2);
+    EXPECT_EQ(cache.get(fetch).getValue().getValue().getValue(), 2);
+}
+
+TEST(ExpiringCache, PutReplacesRunningFetch) {
+    ExpiringCache<int> cache(std::chrono::minutes(1));
+    Promise<int> promise;
+    auto running = cache.get([&] () {
+        return promise.getFuture();
+    });
+    cache.put(2);
+    promise.success(1);
+    EXPECT_EQ(running.getValue().getValue().getValue(), 1);
+    EXPECT_EQ(cache.get([] () {
+        return Future<int>::successful(3);
+    }).getValue().getValue().getValue(), 2);
+
+    cache.invalidate();
+    EXPECT_EQ(cache.get([] () {
+        return Future<int>::successful(3);
+    }).getValue().getValue().getValue(), 3);
+}
@@ -0,0 +1,98 @@
+/*
+ *
+ * thread_dispatcher_test
+ * ledger-core
+ *
+ * Created by Ledger on 23/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <ledger/core/async/WorkStealingThreadDispatcher.hpp>
+#include <ledger/core/utils/LambdaRunnable.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ledger::core;
+
+TEST(WorkStealingThreadDispatcher, SerialContextKeepsOrder) {
+    auto dispatcher = std::make_shared<WorkStealingThreadDispatcher>(4);
+    auto queue = dispatcher->getSerialExecutionContext("queue");
+    auto visited = std::make_shared<std::vector<int>>();
+    for (auto i = 0; i < 10000; i++) {
+        queue->execute(make_runnable([visited, i] () {
+            visited->push_back(i);
+        }));
+    }
+    queue->execute(make_runnable([dispatcher] () {
+        dispatcher->stop();
+    }));
+    dispatcher->waitUntilStopped();
+    ASSERT_EQ(visited->size(), 10000);
+    for (auto i = 0; i < 10000; i++) {
+        EXPECT_EQ((*visited)[i], i);
+    }
+}
+
+TEST(WorkStealingThreadDispatcher, ThreadPoolRunsEveryTask) {
+    auto dispatcher = std::make_shared<WorkStealingThreadDispatcher>(4);
+    auto pool = dispatcher->getThreadPoolExecutionContext("synchronizers");
+    auto counter = std::make_shared<std::atomic<int>>(0);
+    std::vector<std::thread> producers;
+    for (auto t = 0; t < 4; t++) {
+        producers.emplace_back([=] () {
+            for (auto i = 0; i < 10000; i++) {
+                pool->execute(make_runnable([=] () {
+                    if (counter->fetch_add(1) + 1 == 40000) {
+                        dispatcher->stop();
+                    }
+                }));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    dispatcher->waitUntilStopped();
+    EXPECT_EQ(counter->load(), 40000);
+}
+
+TEST(WorkStealingThreadDispatcher, DelayedTasksRunInDueOrder) {
+    auto dispatcher = std::make_shared<WorkStealingThreadDispatcher>(2);
+    auto queue = dispatcher->getSerialExecutionContext("queue");
+    auto fired = std::make_shared<std::vector<int>>();
+    for (auto i = 5; i > 0; i--) {
+        queue->delay(make_runnable([fired, i] () {
+            fired->push_back(i);
+        }), i * 20);
+    }
+    queue->delay(make_runnable([dispatcher] () {
+        dispatcher->stop();
+    }), 200);
+    dispatcher->waitUntilStopped();
+    EXPECT_EQ(*fired, std::vector<int>({1, 2, 3, 4, 5}));
+}
@@ -0,0 +1,247 @@
+/*
+ *
+ * ExplorerStandIn.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "ExplorerStandIn.hpp"
+#include <bitcoin/BitcoinLikeAddress.hpp>
+#include <wallet/currencies.hpp>
+#include <utils/DateUtils.hpp>
+#include <utils/hex.h>
+#include <rapidjson/document.h>
+#include <fmt/format.h>
+#include <algorithm>
+
+using namespace ledger::core;
+
+namespace {
+    const uint64_t FIRST_HEIGHT = 500000;
+    const std::time_t FIRST_TIME = 1571356800;
+    const std::string BITCOIN_SENDER = "1KMbwcH1sGpHetLwwQVNMt4cEZB5u8Uk4b";
+    const std::string ETHEREUM_SENDER = "0x8e1b4c4b9b2a4e2b6f3e3e7f8d8c9b4a0b2c3d4e";
+    const std::string RIPPLE_SENDER = "rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh";
+
+    std::string getBlockHash(SyntheticChain chain, uint64_t height) {
+        return fmt::format(chain == SyntheticChain::ETHEREUM ? "0x{:064x}" : "{:064x}", height);
+    }
+
+    std::string getDate(uint32_t index) {
+        return DateUtils::toJSON(std::chrono::system_clock::from_time_t(FIRST_TIME + index * 60));
+    }
+
+    std::string getQueryParameter(const RestRequest &request, const char *name) {
+        char value[256];
+        auto length = mg_get_http_var(&request.message->query_string, name, value, sizeof(value));
+        return length > 0 ? std::string(value, length) : std::string();
+    }
+
+    RestResponse ok(const std::string &body) {
+        return RestResponse(200, "OK", body);
+    }
+}
+
+const uint32_t ExplorerStandIn::BULK_SIZE = 500;
+
+ExplorerStandIn::ExplorerStandIn(const std::shared_ptr<api::ExecutionContext> &context, SyntheticChain chain)
+        : _server(std::make_shared<MongooseSimpleRestServer>(context)), _chain(chain), _count(0), _servedRequests(0) {
+    _server->GET("/blockchain/:version/:network/addresses/:addresses/transactions", [this] (const RestRequest &request) {
+        return getTransactions(request);
+    });
+    _server->GET("/blockchain/:version/:network/blocks/current", [this] (const RestRequest &request) {
+        return getCurrentBlock();
+    });
+    _server->GET("/blockchain/:version/:network/syncToken", [] (const RestRequest &request) {
+        return ok("{\"token\":\"sync_benchmark\"}");
+    });
+    _server->DEL("/blockchain/:version/:network/syncToken", [] (const RestRequest &request) {
+        return ok("{\"result\":\"ok\"}");
+    });
+    _server->POST("/", [this] (const RestRequest &request) {
+        return rpc(request);
+    });
+}
+
+void ExplorerStandIn::start(short port) {
+    _server->start(port);
+}
+
+void ExplorerStandIn::stop() {
+    _server->stop();
+}
+
+void ExplorerStandIn::reset(uint32_t count) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _count = count;
+    _servedRequests = 0;
+    _fundedAddresses.clear();
+    _fundedAddress.clear();
+    _fundedScript.clear();
+}
+
+void ExplorerStandIn::forEachBulk(const std::function<void (const std::string &)> &f) const {
+    for (uint32_t from = 0; from < _count; from += BULK_SIZE) {
+        f(getBulk(from));
+    }
+}
+
+uint32_t ExplorerStandIn::getServedRequests() const {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _servedRequests;
+}
+
+RestResponse ExplorerStandIn::getTransactions(const RestRequest &request) {
+    auto addresses = request.match.get("addresses");
+    std::lock_guard<std::mutex> lock(_lock);
+    _servedRequests += 1;
+    if (_fundedAddresses.empty()) {
+        _fundedAddresses = addresses;
+        _fundedAddress = addresses.substr(0, addresses.find(','));
+        if (_chain == SyntheticChain::BITCOIN) {
+            auto hash160 = BitcoinLikeAddress::fromBase58(_fundedAddress, currencies::BITCOIN)->getHash160();
+            _fundedScript = fmt::format("76a914{}88ac", hex::toString(hash160));
+        } else {
+            std::transform(_fundedAddress.begin(), _fundedAddress.end(), _fundedAddress.begin(), ::tolower);
+        }
+    }
+    if (addresses != _fundedAddresses) {
+        return ok("{\"truncated\":false,\"txs\":[]}");
+    }
+    auto blockHash = getQueryParameter(request, "blockHash");
+    if (blockHash.empty()) {
+        blockHash = getQueryParameter(request, "block_hash");
+    }
+    return ok(getBulk(blockHash.empty() ? 0 : getNextIndex(blockHash)));
+}
+
+RestResponse ExplorerStandIn::getCurrentBlock() const {
+    std::lock_guard<std::mutex> lock(_lock);
+    auto height = getTipHeight();
+    return ok(fmt::format("{{\"hash\":\"{}\",\"height\":{},\"time\":\"{}\"}}",
+                          getBlockHash(_chain, height), height, getDate(_count)));
+}
+
+RestResponse ExplorerStandIn::rpc(const RestRequest &request) {
+    rapidjson::Document document;
+    auto body = request.getBody();
+    document.Parse(body.c_str());
+    if (!document.IsObject() || !document.HasMember("method") || !document["method"].IsString()) {
+        return RestResponse(400, "Bad Request", "{\"result\":{\"status\":\"error\"}}");
+    }
+    std::string method = document["method"].GetString();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _servedRequests += 1;
+    if (method == "ledger") {
+        auto height = getTipHeight();
+        return ok(fmt::format("{{\"result\":{{\"ledger\":{{\"close_time_human\":\"{0}\",\"ledger_hash\":\"{1}\","
+                              "\"ledger_index\":{2}}},\"ledger_hash\":\"{1}\",\"ledger_index\":{2},"
+                              "\"status\":\"success\",\"validated\":true}}}}",
+                              getDate(_count), getBlockHash(_chain, height), height));
+    } else if (method == "account_tx") {
+        auto &params = document["params"][0];
+        if (_fundedAddress.empty()) {
+            _fundedAddress = params["account"].GetString();
+        }
+        uint32_t from = 0;
+        if (params.HasMember("marker") && params["marker"].IsObject()) {
+            from = params["marker"]["seq"].GetUint();
+        }
+        return ok(getBulk(from));
+    }
+    return ok("{\"result\":{\"status\":\"error\",\"error\":\"unknownCmd\"}}");
+}
+
+std::string ExplorerStandIn::getBulk(uint32_t from) const {
+    auto to = std::min(from + BULK_SIZE, _count);
+    std::string transactions;
+    for (auto index = from; index < to; index++) {
+        if (index > from) {
+            transactions += ",";
+        }
+        switch (_chain) {
+            case SyntheticChain::BITCOIN: transactions += getBitcoinTransaction(index); break;
+            case SyntheticChain::ETHEREUM: transactions += getEthereumTransaction(index); break;
+            case SyntheticChain::RIPPLE: transactions += getRippleTransaction(index); break;
+        }
+    }
+    if (_chain == SyntheticChain::RIPPLE) {
+        // rippled paginates with an opaque marker, which is resent as is in the next call
+        auto marker = to < _count ? fmt::format(",\"marker\":{{\"ledger\":{},\"seq\":{}}}", FIRST_HEIGHT + to, to) : "";
+        return fmt::format("{{\"result\":{{\"account\":\"{}\",\"limit\":{}{},\"transactions\":[{}],\"status\":\"success\"}}}}",
+                           _fundedAddress, BULK_SIZE, marker, transactions);
+    }
+    return fmt::format("{{\"truncated\":{},\"txs\":[{}]}}", to < _count ? "true" : "false", transactions);
+}
+
+std::string ExplorerStandIn::getBitcoinTransaction(uint32_t index) const {
+    auto height = FIRST_HEIGHT + index;
+    auto value = 10000 + index;
+    return fmt::format("{{\"hash\":\"{:064x}\",\"received_at\":\"{}\",\"lock_time\":0,"
+                       "\"block\":{{\"hash\":\"{}\",\"height\":{},\"time\":\"{}\"}},"
+                       "\"inputs\":[{{\"input_index\":0,\"output_hash\":\"{:064x}\",\"output_index\":0,\"value\":{},"
+                       "\"address\":\"{}\",\"script_signature\":\"\"}}],"
+                       "\"outputs\":[{{\"output_index\":0,\"value\":{},\"address\":\"{}\",\"script_hex\":\"{}\"}}],"
+                       "\"fees\":1000,\"amount\":{},\"confirmations\":{}}}",
+                       0xb7c0000000000000ULL + index, getDate(index),
+                       getBlockHash(_chain, height), height, getDate(index),
+                       0xa1e0000000000000ULL + index, value + 1000, BITCOIN_SENDER,
+                       value, _fundedAddress, _fundedScript,
+                       value, getTipHeight() - height + 1);
+}
+
+std::string ExplorerStandIn::getEthereumTransaction(uint32_t index) const {
+    auto height = FIRST_HEIGHT + index;
+    return fmt::format("{{\"hash\":\"0x{:064x}\",\"status\":1,\"received_at\":\"{}\",\"nonce\":\"0x00\",\"value\":{},"
+                       "\"gas\":21000,\"gas_price\":1000000000,\"from\":\"{}\",\"to\":\"{}\",\"input\":\"0x\","
+                       "\"gas_used\":21000,\"cumulative_gas_used\":21000,\"confirmations\":{},"
+                       "\"block\":{{\"hash\":\"{}\",\"height\":{},\"time\":\"{}\"}},\"actions\":[]}}",
+                       0xe7c0000000000000ULL + index, getDate(index), 1000000000000ULL + index,
+                       ETHEREUM_SENDER, _fundedAddress, getTipHeight() - height + 1,
+                       getBlockHash(_chain, height), height, getDate(index));
+}
+
+std::string ExplorerStandIn::getRippleTransaction(uint32_t index) const {
+    return fmt::format("{{\"meta\":{{\"TransactionIndex\":0,\"TransactionResult\":\"tesSUCCESS\"}},"
+                       "\"tx\":{{\"Account\":\"{}\",\"Amount\":\"{}\",\"Destination\":\"{}\",\"Fee\":\"10\",\"Flags\":0,"
+                       "\"Sequence\":{},\"TransactionType\":\"Payment\",\"date\":\"{}\",\"hash\":\"{:064X}\","
+                       "\"ledger_index\":{}}},\"validated\":true}}",
+                       RIPPLE_SENDER, 20000000 + index, _fundedAddress,
+                       index + 1, getDate(index), 0x8c90000000000000ULL + index,
+                       FIRST_HEIGHT + index);
+}
+
+uint32_t ExplorerStandIn::getNextIndex(const std::string &blockHash) const {
+    auto hash = blockHash.compare(0, 2, "0x") == 0 ? blockHash.substr(2) : blockHash;
+    auto height = std::stoull(hash, nullptr, 16);
+    return static_cast<uint32_t>(height - FIRST_HEIGHT + 1);
+}
+
+uint64_t ExplorerStandIn::getTipHeight() const {
+    return FIRST_HEIGHT + _count;
+}
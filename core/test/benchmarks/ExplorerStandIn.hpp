@@ -0,0 +1,91 @@
+/*
+ *
+ * ExplorerStandIn.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_EXPLORERSTANDIN_HPP
+#define LEDGER_CORE_EXPLORERSTANDIN_HPP
+
+#include <MongooseSimpleRestServer.hpp>
+#include <functional>
+#include <mutex>
+#include <string>
+
+enum class SyntheticChain {
+    BITCOIN,
+    ETHEREUM,
+    RIPPLE
+};
+
+// Local stand-in for the Ledger explorers (and for a rippled node) serving a synthetic history. Every
+// transaction pays the first address(es) the synchronizer asks for, so that the whole history is
+// fetched, parsed and stored by a regular synchronization.
+class ExplorerStandIn {
+public:
+    // Number of transactions per bulk, close to what the explorers return.
+    static const uint32_t BULK_SIZE;
+
+    ExplorerStandIn(const std::shared_ptr<ledger::core::api::ExecutionContext>& context, SyntheticChain chain);
+    void start(short port);
+    void stop();
+
+    // Serve a fresh history of count transactions to the next synchronization.
+    void reset(uint32_t count);
+
+    // Regenerate, in order, every non empty bulk of the history (bulks are not kept in memory).
+    void forEachBulk(const std::function<void (const std::string&)>& f) const;
+    uint32_t getServedRequests() const;
+
+private:
+    RestResponse getTransactions(const RestRequest& request);
+    RestResponse getCurrentBlock() const;
+    RestResponse rpc(const RestRequest& request);
+
+    std::string getBulk(uint32_t from) const;
+    std::string getBitcoinTransaction(uint32_t index) const;
+    std::string getEthereumTransaction(uint32_t index) const;
+    std::string getRippleTransaction(uint32_t index) const;
+
+    // Index of the first transaction following the one included in the given block.
+    uint32_t getNextIndex(const std::string& blockHash) const;
+    uint64_t getTipHeight() const;
+
+private:
+    std::shared_ptr<MongooseSimpleRestServer> _server;
+    SyntheticChain _chain;
+    mutable std::mutex _lock;
+    uint32_t _count;
+    uint32_t _servedRequests;
+    // Addresses (as joined in the request) the history is attached to, with their scriptPubKey on Bitcoin
+    std::string _fundedAddresses;
+    std::string _fundedAddress;
+    std::string _fundedScript;
+};
+
+#endif //LEDGER_CORE_EXPLORERSTANDIN_HPP
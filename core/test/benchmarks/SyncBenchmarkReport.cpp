@@ -0,0 +1,168 @@
+/*
+ *
+ * SyncBenchmarkReport.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "SyncBenchmarkReport.hpp"
+#include <utils/ImmediateExecutionContext.hpp>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <fmt/format.h>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+SyncBenchmarkReport& SyncBenchmarkReport::getInstance() {
+    static SyncBenchmarkReport instance;
+    return instance;
+}
+
+void SyncBenchmarkReport::add(const SyncBenchmarkResult &result) {
+    std::lock_guard<std::mutex> lock(_lock);
+    _results.push_back(result);
+}
+
+std::string SyncBenchmarkReport::toJSON() const {
+    std::lock_guard<std::mutex> lock(_lock);
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("results");
+    writer.StartArray();
+    for (const auto& result : _results) {
+        writer.StartObject();
+        writer.Key("currency");
+        writer.String(result.currency.c_str());
+        writer.Key("transactions");
+        writer.Uint(result.transactions);
+        writer.Key("requests");
+        writer.Uint(result.requests);
+        writer.Key("succeed");
+        writer.Bool(result.succeed);
+        writer.Key("wall_time_ms");
+        writer.Int64(result.wallTime.count());
+        writer.Key("db_time_ms");
+        writer.Int64(result.databaseTime.count());
+        writer.Key("fetch_time_ms");
+        writer.Int64(result.fetchTime.count());
+        writer.Key("parse_time_ms");
+        writer.Int64(result.parseTime.count());
+        writer.Key("peak_rss_kb");
+        writer.Uint64(result.peakResidentSetSize);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+void SyncBenchmarkReport::write() const {
+    auto path = std::getenv("LEDGER_SYNC_BENCHMARK_REPORT");
+    std::ofstream file(path != nullptr ? path : "sync_benchmark_report.json");
+    file << toJSON() << std::endl;
+}
+
+std::vector<uint32_t> SyncBenchmarkReport::getSizes() {
+    auto sizes = std::getenv("LEDGER_SYNC_BENCHMARK_SIZES");
+    std::stringstream ss(sizes != nullptr ? sizes : "10,100,1000,10000,100000");
+    std::vector<uint32_t> result;
+    std::string size;
+    while (std::getline(ss, size, ',')) {
+        result.push_back(static_cast<uint32_t>(std::stoul(size)));
+    }
+    return result;
+}
+
+uint64_t SyncBenchmarkReport::getPeakResidentSetSize() {
+#if defined(_WIN32) || defined(_WIN64)
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+void SyncBenchmarkLogPrinter::reset() {
+    std::lock_guard<std::mutex> lock(_lock);
+    _durations.clear();
+}
+
+std::chrono::milliseconds SyncBenchmarkLogPrinter::getDuration(const std::string &name) const {
+    std::lock_guard<std::mutex> lock(_lock);
+    auto it = _durations.find(name);
+    return it != _durations.end() ? it->second : std::chrono::milliseconds(0);
+}
+
+void SyncBenchmarkLogPrinter::printInfo(const std::string &message) {
+    // Benchmarker logs "<name> took <hours>:<minutes>:<seconds>.<milliseconds>."
+    static const std::regex duration("([^:]+) took ([0-9]+):([0-9]+):([0-9]+)\\.([0-9]+)\\.\\s*$");
+    std::smatch what;
+    if (!std::regex_search(message, what, duration)) {
+        return;
+    }
+    auto name = what[1].str();
+    name.erase(0, name.find_first_not_of(' '));
+    auto elapsed = std::chrono::hours(std::stoi(what[2].str())) + std::chrono::minutes(std::stoi(what[3].str())) +
+                   std::chrono::seconds(std::stoi(what[4].str())) + std::chrono::milliseconds(std::stoi(what[5].str()));
+    std::lock_guard<std::mutex> lock(_lock);
+    _durations[name] += std::chrono::duration_cast<std::chrono::milliseconds>(elapsed);
+}
+
+void SyncBenchmarkLogPrinter::printError(const std::string &message) {
+    fmt::print("{}\n", message);
+}
+
+void SyncBenchmarkLogPrinter::printCriticalError(const std::string &message) {
+    fmt::print("{}\n", message);
+}
+
+void SyncBenchmarkLogPrinter::printDebug(const std::string &message) {}
+
+void SyncBenchmarkLogPrinter::printWarning(const std::string &message) {}
+
+void SyncBenchmarkLogPrinter::printApdu(const std::string &message) {}
+
+std::shared_ptr<ledger::core::api::ExecutionContext> SyncBenchmarkLogPrinter::getContext() {
+    // Durations must be collected by the time the synchronization completes
+    return ledger::core::ImmediateExecutionContext::INSTANCE;
+}
@@ -0,0 +1,96 @@
+/*
+ *
+ * SyncBenchmarkReport.hpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_SYNCBENCHMARKREPORT_HPP
+#define LEDGER_CORE_SYNCBENCHMARKREPORT_HPP
+
+#include <api/LogPrinter.hpp>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct SyncBenchmarkResult {
+    std::string currency;
+    uint32_t transactions;
+    uint32_t requests;
+    bool succeed;
+    // Whole synchronization, as seen by the client
+    std::chrono::milliseconds wallTime;
+    // Bulk insertions, as measured by the synchronizer ("Transaction computation")
+    std::chrono::milliseconds databaseTime;
+    // Bulk requests including their parsing, as measured by the synchronizer ("Get batch")
+    std::chrono::milliseconds fetchTime;
+    // Parsing of every served bulk, measured apart from the synchronization
+    std::chrono::milliseconds parseTime;
+    // Peak resident set size of the process so far (sizes run in increasing order)
+    uint64_t peakResidentSetSize;
+};
+
+class SyncBenchmarkReport {
+public:
+    static SyncBenchmarkReport& getInstance();
+    void add(const SyncBenchmarkResult& result);
+    std::string toJSON() const;
+    // Write the report to $LEDGER_SYNC_BENCHMARK_REPORT (sync_benchmark_report.json by default)
+    void write() const;
+
+    // Sizes of the synthetic histories, from $LEDGER_SYNC_BENCHMARK_SIZES (e.g. "10,100,1000")
+    static std::vector<uint32_t> getSizes();
+    // In kilobytes
+    static uint64_t getPeakResidentSetSize();
+
+private:
+    mutable std::mutex _lock;
+    std::vector<SyncBenchmarkResult> _results;
+};
+
+// Log printer collecting the durations reported by the synchronizer benchmarkers.
+class SyncBenchmarkLogPrinter : public ledger::core::api::LogPrinter {
+public:
+    void reset();
+    std::chrono::milliseconds getDuration(const std::string& name) const;
+
+    void printError(const std::string &message) override;
+    void printInfo(const std::string &message) override;
+    void printDebug(const std::string &message) override;
+    void printWarning(const std::string &message) override;
+    void printApdu(const std::string &message) override;
+    void printCriticalError(const std::string &message) override;
+    std::shared_ptr<ledger::core::api::ExecutionContext> getContext() override;
+
+private:
+    mutable std::mutex _lock;
+    std::map<std::string, std::chrono::milliseconds> _durations;
+};
+
+#endif //LEDGER_CORE_SYNCBENCHMARKREPORT_HPP
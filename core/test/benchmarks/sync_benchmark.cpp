@@ -0,0 +1,158 @@
+/*
+ *
+ * sync_benchmark.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include "ExplorerStandIn.hpp"
+#include "SyncBenchmarkReport.hpp"
+#include "../integration/BaseFixture.h"
+#include <wallet/bitcoin/explorers/api/TransactionsBulkParser.hpp>
+#include <wallet/ethereum/explorers/api/EthereumLikeTransactionsBulkParser.h>
+#include <wallet/ripple/explorers/api/RippleLikeTransactionsBulkParser.h>
+#include <wallet/common/explorers/LedgerApiParser.hpp>
+#include <rapidjson/reader.h>
+
+namespace {
+    const short STAND_IN_PORT = 18421;
+    const std::string STAND_IN_ENDPOINT = "http://127.0.0.1";
+
+    template <typename Bulk, typename Parser>
+    void parseBulk(const std::string &body) {
+        LedgerApiParser<Bulk, Parser> parser;
+        parser.attach("", 200);
+        rapidjson::Reader reader;
+        rapidjson::StringStream is(body.c_str());
+        reader.Parse<rapidjson::ParseFlag::kParseNumbersAsStringsFlag>(is, parser);
+        auto result = parser.build();
+        if (result.isLeft()) {
+            throw result.getLeft();
+        }
+    }
+}
+
+class SyncBenchmark : public BaseFixture {
+public:
+    void SetUp() override {
+        BaseFixture::SetUp();
+        logPrinter = std::make_shared<SyncBenchmarkLogPrinter>();
+    }
+
+    std::shared_ptr<WalletPool> newBenchmarkPool(const std::string &poolName) {
+        return WalletPool::newInstance(poolName, "test", http, ws, resolver, logPrinter, dispatcher, rng, backend,
+                                       api::DynamicObject::newInstance());
+    }
+
+    // Synchronize a fresh account against histories of every benchmarked size.
+    void benchmark(const std::string &currencyName,
+                   SyntheticChain chain,
+                   const std::shared_ptr<api::DynamicObject> &configuration,
+                   const std::function<std::shared_ptr<AbstractAccount> (const std::shared_ptr<AbstractWallet>&)> &newAccount,
+                   const std::function<void (const std::string&)> &parse) {
+        auto standIn = std::make_shared<ExplorerStandIn>(dispatcher->getSerialExecutionContext("explorer_stand_in"), chain);
+        standIn->start(STAND_IN_PORT);
+
+        for (auto size : SyncBenchmarkReport::getSizes()) {
+            standIn->reset(size);
+            logPrinter->reset();
+            auto pool = newBenchmarkPool(fmt::format("sync_benchmark_{}_{}", currencyName, size));
+            auto wallet = wait(pool->createWallet(fmt::format("{}_{}", currencyName, size), currencyName, configuration));
+            auto account = newAccount(wallet);
+
+            auto code = api::EventCode::UNDEFINED;
+            auto start = std::chrono::steady_clock::now();
+            auto receiver = make_receiver([&] (const std::shared_ptr<api::Event> &event) {
+                if (event->getCode() == api::EventCode::SYNCHRONIZATION_STARTED)
+                    return;
+                code = event->getCode();
+                dispatcher->stop();
+            });
+            account->synchronize()->subscribe(dispatcher->getMainExecutionContext(), receiver);
+            dispatcher->waitUntilStopped();
+
+            SyncBenchmarkResult result;
+            result.currency = currencyName;
+            result.transactions = size;
+            result.requests = standIn->getServedRequests();
+            result.succeed = code != api::EventCode::SYNCHRONIZATION_FAILED;
+            result.wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            result.peakResidentSetSize = SyncBenchmarkReport::getPeakResidentSetSize();
+            result.databaseTime = logPrinter->getDuration("Transaction computation");
+            result.fetchTime = logPrinter->getDuration("Get batch");
+
+            auto parseStart = std::chrono::steady_clock::now();
+            standIn->forEachBulk(parse);
+            result.parseTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - parseStart);
+
+            EXPECT_TRUE(result.succeed);
+            int32_t operations = 0;
+            {
+                soci::session sql(pool->getDatabaseSessionPool()->getPool());
+                sql << "SELECT COUNT(*) FROM operations", soci::into(operations);
+            }
+            EXPECT_EQ(operations, size);
+
+            fmt::print("{} transactions of {} synchronized in {} ms\n", size, currencyName, result.wallTime.count());
+            SyncBenchmarkReport::getInstance().add(result);
+        }
+
+        standIn->stop();
+    }
+
+    std::shared_ptr<SyncBenchmarkLogPrinter> logPrinter;
+};
+
+TEST_F(SyncBenchmark, Bitcoin) {
+    auto configuration = DynamicObject::newInstance();
+    configuration->putString(api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT,
+                             fmt::format("{}:{}", STAND_IN_ENDPOINT, STAND_IN_PORT));
+    benchmark("bitcoin", SyntheticChain::BITCOIN, configuration, [&] (const std::shared_ptr<AbstractWallet> &wallet) {
+        return createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+    }, parseBulk<BitcoinLikeBlockchainExplorer::TransactionsBulk, TransactionsBulkParser>);
+}
+
+TEST_F(SyncBenchmark, Ethereum) {
+    auto configuration = DynamicObject::newInstance();
+    configuration->putString(api::Configuration::KEYCHAIN_DERIVATION_SCHEME, "44'/60'/0'/0/<account>'");
+    configuration->putString(api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT,
+                             fmt::format("{}:{}", STAND_IN_ENDPOINT, STAND_IN_PORT));
+    benchmark("ethereum", SyntheticChain::ETHEREUM, configuration, [&] (const std::shared_ptr<AbstractWallet> &wallet) {
+        return createEthereumLikeAccount(wallet, 0, ETH_KEYS_INFO_LIVE);
+    }, parseBulk<EthereumLikeBlockchainExplorer::TransactionsBulk, EthereumLikeTransactionsBulkParser>);
+}
+
+TEST_F(SyncBenchmark, Ripple) {
+    auto configuration = DynamicObject::newInstance();
+    configuration->putString(api::Configuration::KEYCHAIN_DERIVATION_SCHEME, "44'/<coin_type>'/<account>'/<node>/<address>");
+    configuration->putString(api::Configuration::BLOCKCHAIN_EXPLORER_API_ENDPOINT, STAND_IN_ENDPOINT);
+    configuration->putString(api::Configuration::BLOCKCHAIN_EXPLORER_PORT, std::to_string(STAND_IN_PORT));
+    benchmark("ripple", SyntheticChain::RIPPLE, configuration, [&] (const std::shared_ptr<AbstractWallet> &wallet) {
+        return createRippleLikeAccount(wallet, 0, XRP_KEYS_INFO);
+    }, parseBulk<RippleLikeBlockchainExplorer::TransactionsBulk, RippleLikeTransactionsBulkParser>);
+}
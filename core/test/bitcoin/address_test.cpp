@@ -43,6 +43,8 @@
 #include <bitcoin/BitcoinLikeExtendedPublicKey.hpp>
 #include <api/Configuration.hpp>
 #include <api/KeychainEngines.hpp>
+#include <bitcoin/bech32/Bech32Factory.h>
+#include <utils/Exception.hpp>
 
 
 std::vector<std::vector<std::string>> fixtures = {
@@ -117,4 +119,49 @@ TEST(Address, FromBech32Address) {
         auto address = ledger::core::BitcoinLikeAddress::fromBech32(test.first, test.second);
         EXPECT_EQ(address->toBech32(), test.first);
     }
-}
\ No newline at end of file
+}
+TEST(Address, FromDerivedPublicKey) {
+    const Currency currency = currencies::BITCOIN;
+    auto xpubStr = "xpub6Cc939fyHvfB9pPLWd3bSyyQFvgKbwhidca49jGCM5Hz5ypEPGf9JVXB4NBuUfPgoHnMjN6oNgdC9KRqM11RZtL8QLW6rFKziNwHDYhZ6Kx";
+    std::vector<std::string> keychainEngines = {
+            api::KeychainEngines::BIP32_P2PKH,
+            api::KeychainEngines::BIP49_P2SH,
+            api::KeychainEngines::BIP173_P2WPKH,
+            api::KeychainEngines::BIP173_P2WSH
+    };
+    for (auto& keychainEngine : keychainEngines) {
+        auto config = std::make_shared<ledger::core::DynamicObject>();
+        config->putString(api::Configuration::KEYCHAIN_ENGINE, keychainEngine);
+        auto xpub = ledger::core::BitcoinLikeExtendedPublicKey::fromBase58(currency, xpubStr, optional<std::string>("44'/0'/0'"), config);
+        auto address = ledger::core::BitcoinLikeAddress::fromPublicKey(xpub->deriveKey(DerivationPath("0/1")), currency, keychainEngine);
+        auto expected = ledger::core::BitcoinLikeAddress::fromPublicKey(xpub, currency, "0/1", keychainEngine);
+        EXPECT_EQ(address->toString(), expected);
+        // Second call is served by the encoded form cache
+        EXPECT_EQ(address->toString(), expected);
+        auto parsed = std::dynamic_pointer_cast<ledger::core::BitcoinLikeAddress>(ledger::core::BitcoinLikeAddress::parse(expected, currency));
+        EXPECT_EQ(address->getHash160(), parsed->getHash160());
+        if (keychainEngine == api::KeychainEngines::BIP32_P2PKH) {
+            EXPECT_EQ(expected, "1Pn6i3cvdGhqbdgNjXHfbaYfiuviPiymXj");
+        }
+    }
+}
+
+TEST(Address, Bech32BatchEncode) {
+    auto bech32 = ledger::core::Bech32Factory::newBech32Instance("btc").getValue();
+    std::vector<std::vector<uint8_t>> hashes;
+    for (auto& item : fixtures) {
+        hashes.push_back(hex::toByteArray(item[0]));
+    }
+    auto encoded = bech32->encodeBatch(hashes, bech32->getBech32Params().P2WPKHVersion);
+    ASSERT_EQ(encoded.size(), fixtures.size());
+    for (auto i = 0; i < fixtures.size(); i++) {
+        EXPECT_EQ(encoded[i], fixtures[i][2]);
+        auto decoded = bech32->decode(encoded[i]);
+        EXPECT_EQ(decoded.second, hashes[i]);
+    }
+}
+
+TEST(Address, Bech32RejectsTooLongHash) {
+    auto bech32 = ledger::core::Bech32Factory::newBech32Instance("btc").getValue();
+    EXPECT_THROW(bech32->encode(std::vector<uint8_t>(64, 0x42), bech32->getBech32Params().P2WSHVersion), ledger::core::Exception);
+}
@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 #include <wallet/bitcoin/scripts/BitcoinLikeScript.h>
 #include <utils/hex.h>
+#include <wallet/currencies.hpp>
 
 using namespace ledger::core;
 using namespace btccore;
@@ -58,4 +59,45 @@ TEST(Script, ParseP2WSHScript) {
     auto script = BitcoinLikeScript::parse(hex::toByteArray("00205d1b56b63d714eebe542309525f484b7e9d6f686b3781b6f61ef925d66d6f6a0"));
     EXPECT_TRUE(script.isSuccess());
     EXPECT_EQ(script.getValue().toString(), "OP_0 PUSHDATA(32)[5d1b56b63d714eebe542309525f484b7e9d6f686b3781b6f61ef925d66d6f6a0]");
-}
\ No newline at end of file
+}
+
+TEST(Script, ClassifyStandardScripts) {
+    auto p2pkh = hex::toByteArray("76a9148829b0621743cde58974064e1e872d67eb4ea0c588ac");
+    auto result = BitcoinLikeStandardScript::classify(p2pkh);
+    EXPECT_EQ(result.type, BitcoinLikeScriptTemplate::P2PKH);
+    EXPECT_EQ(hex::toString(result.hash.toVector()), "8829b0621743cde58974064e1e872d67eb4ea0c5");
+
+    auto p2sh = hex::toByteArray("a914e8b9ebac8d7f4ec0e3b3a0e3e0a0b8e5dfa0a9c887");
+    result = BitcoinLikeStandardScript::classify(p2sh);
+    EXPECT_EQ(result.type, BitcoinLikeScriptTemplate::P2SH);
+    EXPECT_EQ(hex::toString(result.hash.toVector()), "e8b9ebac8d7f4ec0e3b3a0e3e0a0b8e5dfa0a9c8");
+
+    auto p2wpkh = hex::toByteArray("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    EXPECT_EQ(BitcoinLikeStandardScript::classify(p2wpkh).type, BitcoinLikeScriptTemplate::P2WPKH);
+
+    auto p2wsh = hex::toByteArray("00205d1b56b63d714eebe542309525f484b7e9d6f686b3781b6f61ef925d66d6f6a0");
+    EXPECT_EQ(BitcoinLikeStandardScript::classify(p2wsh).type, BitcoinLikeScriptTemplate::P2WSH);
+
+    // OP_RETURN and templates followed by extra operations must go through a full parse
+    EXPECT_FALSE(BitcoinLikeStandardScript::classify(hex::toByteArray("6a0401020304")).isStandard());
+    EXPECT_FALSE(BitcoinLikeStandardScript::classify(hex::toByteArray("76a9148829b0621743cde58974064e1e872d67eb4ea0c588acb4")).isStandard());
+    EXPECT_FALSE(BitcoinLikeStandardScript::classify(std::vector<uint8_t>()).isStandard());
+}
+
+TEST(Script, ParseAddressMatchesFullParse) {
+    const auto currency = currencies::BITCOIN;
+    for (auto &script : {
+        "76a9148829b0621743cde58974064e1e872d67eb4ea0c588ac",
+        "a914e8b9ebac8d7f4ec0e3b3a0e3e0a0b8e5dfa0a9c887",
+        "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1",
+        "00205d1b56b63d714eebe542309525f484b7e9d6f686b3781b6f61ef925d66d6f6a0"
+    }) {
+        auto bytes = hex::toByteArray(script);
+        auto fast = BitcoinLikeScript::parseAddress(bytes, currency);
+        auto full = BitcoinLikeScript::parse(bytes).getValue().parseAddress(currency);
+        ASSERT_TRUE(fast.hasValue());
+        ASSERT_TRUE(full.hasValue());
+        EXPECT_EQ(fast.getValue().toString(), full.getValue().toString());
+    }
+    EXPECT_FALSE(BitcoinLikeScript::parseAddress(hex::toByteArray("6a0401020304"), currency).hasValue());
+}
@@ -107,3 +107,43 @@ TEST(BytesReader, ReadNextVarString) {
     ledger::core::BytesReader reader(data);
     EXPECT_EQ(reader.readNextVarString(), "Hello world");
 }
+
+TEST(BytesReader, ReadView) {
+    std::vector<uint8_t> data({0x05, 'H', 'e', 'l', 'l', 'o', 0x2A});
+    ledger::core::BytesReader reader(data);
+    auto view = reader.readNextVarView();
+    EXPECT_EQ(view.size(), 5);
+    EXPECT_EQ(view.data(), data.data() + 1);
+    EXPECT_EQ(view.toString(), "Hello");
+    EXPECT_EQ(reader.readNextByte(), 0x2A);
+    EXPECT_THROW(reader.readView(1), std::out_of_range);
+}
+
+TEST(BytesReader, ReadOutOfBounds) {
+    std::vector<uint8_t> data({0xFF, 0x01, 0x10, 42});
+    ledger::core::BytesReader reader(data, 1, 2);
+    EXPECT_THROW(reader.read(3), std::out_of_range);
+    EXPECT_EQ(reader.getCursor(), 0);
+    EXPECT_EQ(reader.read(2), std::vector<uint8_t>({0x01, 0x10}));
+    EXPECT_THROW(reader.readNextByte(), std::out_of_range);
+}
+
+TEST(BytesReader, ReadNextVarIntSequence) {
+    ledger::core::BytesReader reader(std::vector<uint8_t>({0xA0, 0xFD, 0xB0, 0xA0, 0xFE, 0xD0, 0xC0, 0xB0, 0xA0,
+                                                           0xFF, 0x11, 0x10, 0xF0, 0xE0, 0xD0, 0xC0, 0xB0, 0xA0}));
+    EXPECT_EQ(reader.readNextVarInt(), 0xA0);
+    EXPECT_EQ(reader.readNextVarInt(), 0xA0B0);
+    EXPECT_EQ(reader.readNextVarInt(), 0xA0B0C0D0);
+    EXPECT_EQ(reader.readNextVarInt(), 0xA0B0C0D0E0F01011);
+    EXPECT_EQ(reader.hasNext(), false);
+}
+
+TEST(BytesReader, OwnsMovedData) {
+    auto makeReader = [] () {
+        return ledger::core::BytesReader(std::vector<uint8_t>({0x03, 'a', 'b', 'c'}));
+    };
+    auto reader = makeReader();
+    auto copy = reader;
+    EXPECT_EQ(reader.readNextVarString(), "abc");
+    EXPECT_EQ(copy.readNextVarString(), "abc");
+}
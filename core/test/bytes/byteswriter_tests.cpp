@@ -52,3 +52,21 @@ TEST(BytesWriter, WriteVarInt) {
     EXPECT_EQ(BytesWriter().writeVarInt(0xA0B0C0D0).toByteArray(), std::vector<uint8_t>({0xFE, 0xD0, 0xC0, 0xB0, 0xA0}));
     EXPECT_EQ(BytesWriter().writeVarInt(0xA0B0C0D0E0F01011).toByteArray(), std::vector<uint8_t>({0xFF, 0x11, 0x10, 0xF0, 0xE0, 0xD0, 0xC0, 0xB0, 0xA0}));
 }
+
+TEST(BytesWriter, WriteByteArrays) {
+    std::vector<uint8_t> data({0x01, 0x02, 0x03});
+    BytesWriter writer;
+    writer.reserve(9);
+    writer.writeByteArray(data).writeLeByteArray(data).writeByteArray(data.data() + 1, 2).writeString("a");
+    EXPECT_EQ(writer.size(), 9);
+    EXPECT_EQ(writer.toByteArray(), std::vector<uint8_t>({0x01, 0x02, 0x03, 0x03, 0x02, 0x01, 0x02, 0x03, 'a'}));
+}
+
+TEST(BytesWriter, MoveOutByteArray) {
+    BytesWriter writer;
+    writer.writeVarString("ledger");
+    auto copy = writer.toByteArray();
+    auto moved = std::move(writer).toByteArray();
+    EXPECT_EQ(moved, copy);
+    EXPECT_EQ(moved, std::vector<uint8_t>({0x06, 'l', 'e', 'd', 'g', 'e', 'r'}));
+}
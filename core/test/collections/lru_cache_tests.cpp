@@ -0,0 +1,71 @@
+/*
+ *
+ * lru_cache_tests
+ * ledger-core
+ *
+ * Created by Ledger on 22/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <ledger/core/collections/LRUCache.hpp>
+
+using namespace ledger::core;
+
+TEST(LRUCache, GetAndPut) {
+    LRUCache<std::string, int> cache(2);
+    EXPECT_FALSE(cache.get("a").hasValue());
+    cache.put("a", 1);
+    cache.put("b", 2);
+    EXPECT_EQ(cache.get("a").getValue(), 1);
+    EXPECT_EQ(cache.get("b").getValue(), 2);
+    cache.put("b", 3);
+    EXPECT_EQ(cache.get("b").getValue(), 3);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(LRUCache, EvictLeastRecentlyUsed) {
+    LRUCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    // "a" becomes the most recently used entry
+    cache.get("a");
+    cache.put("c", 3);
+    EXPECT_TRUE(cache.get("a").hasValue());
+    EXPECT_FALSE(cache.get("b").hasValue());
+    EXPECT_TRUE(cache.get("c").hasValue());
+}
+
+TEST(LRUCache, RemoveAndClear) {
+    LRUCache<std::string, int> cache(4);
+    cache.put("a", 1);
+    cache.put("b", 2);
+    cache.remove("a");
+    EXPECT_FALSE(cache.get("a").hasValue());
+    EXPECT_EQ(cache.size(), 1);
+    cache.clear();
+    EXPECT_FALSE(cache.get("b").hasValue());
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -38,6 +38,7 @@
 #include <sstream>
 #include <ledger/core/bytes/BytesReader.h>
 #include <ledger/core/bytes/BytesWriter.h>
+#include <ledger/core/utils/Exception.hpp>
 
 using namespace ledger::core;
 
@@ -188,3 +189,41 @@ TEST(Encryption, EncryptDecryptWithCipherEmptiness) {
     cipher = AESCipher(rng, "", "", 10000);
     testCipher(cipher);
 }
+
+TEST(Encryption, CipherOutputIsReadableByAES256) {
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    AESCipher cipher(rng, "A very strong password", "Awesome salt", 10000);
+    auto key = PBKDF2::derive(vectorize("A very strong password"), vectorize("Awesome salt"), 10000, 32);
+
+    // one partial block and one aligned on the block size
+    for (auto data : {std::string("Hello world!"), std::string("0123456789abcdef")}) {
+        BytesReader input(vectorize(data));
+        BytesWriter encrypted;
+        cipher.encrypt(input, encrypted);
+
+        BytesReader reader(encrypted.toByteArray());
+        auto blocksCount = reader.readNextByte();
+        auto size = reader.readNextVarInt();
+        auto IV = reader.read(AES256::BLOCK_SIZE);
+        auto decrypted = AES256::decrypt(IV, key, reader.read(blocksCount * AES256::BLOCK_SIZE));
+        decrypted.resize(size);
+        EXPECT_EQ(decrypted, vectorize(data));
+    }
+}
+
+TEST(Encryption, EncryptDecryptAuthenticated) {
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    AESCipher cipher(rng, "A very strong password", "Awesome salt", 10000);
+    auto data = vectorize(BIG_TEXT);
+
+    auto encrypted = cipher.encryptAuthenticated(data);
+    EXPECT_NE(encrypted, cipher.encryptAuthenticated(data));
+    EXPECT_EQ(cipher.decryptAuthenticated(encrypted), data);
+    EXPECT_EQ(cipher.decryptAuthenticated(cipher.encryptAuthenticated({})), std::vector<uint8_t>());
+
+    encrypted[encrypted.size() / 2] ^= 0x01;
+    EXPECT_THROW(cipher.decryptAuthenticated(encrypted), Exception);
+
+    AESCipher otherCipher(rng, "Another password", "Awesome salt", 10000);
+    EXPECT_THROW(otherCipher.decryptAuthenticated(cipher.encryptAuthenticated(data)), Exception);
+}
@@ -182,6 +182,10 @@ public:
         return std::make_shared<Blob>(buffer);
     }
 
+    const std::vector<std::tuple<std::string, std::string, bool>>& getColumns() const {
+        return _columns;
+    }
+
 private:
     std::vector<std::tuple<std::string, std::string, bool>> _columns;
 };
@@ -189,9 +193,11 @@ private:
 class Results : public api::DatabaseResultSet, public std::enable_shared_from_this<Results> {
 public:
 
-    Results(sqlite3* db, sqlite3_stmt* st) : _stmt(st), _changes(sqlite3_changes(db)) {
+    Results(sqlite3* db, sqlite3_stmt* st) : _stmt(st) {
         // We read all results, this is not really efficient but this wrapper is only for tests
        read_all(db);
+       // Changes are only known once the statement is done
+       _changes = sqlite3_changes(db);
     }
 
     void read_all(sqlite3* db) {
@@ -231,6 +237,30 @@ public:
         _it++;
     }
 
+    std::experimental::optional<api::DatabaseResultBatch> nextBatch(int32_t maxRows) override {
+        api::DatabaseResultBatch batch(0, 0, {}, {}, {});
+        auto pushOffset = [&] () {
+            auto offset = static_cast<uint32_t>(batch.values.size());
+            for (auto i = 0; i < 4; i++) {
+                batch.offsets.push_back(static_cast<uint8_t>((offset >> (8 * i)) & 0xFF));
+            }
+        };
+        pushOffset();
+        while (batch.rowCount < maxRows && hasNext()) {
+            next();
+            const auto& columns = (*_it)->getColumns();
+            for (const auto& column : columns) {
+                const auto& value = std::get<1>(column);
+                batch.nulls.push_back(std::get<2>(column) ? 1 : 0);
+                batch.values.insert(batch.values.end(), value.begin(), value.end());
+                pushOffset();
+            }
+            batch.columnCount = static_cast<int32_t>(columns.size());
+            batch.rowCount += 1;
+        }
+        return batch;
+    }
+
     void close() override {
         _rows = std::list<std::shared_ptr<ResultRow>>();
         _it = _rows.end();
@@ -245,7 +275,7 @@ private:
 
     std::list<std::shared_ptr<ResultRow>> _rows;
     std::list<std::shared_ptr<ResultRow>>::iterator _it;
-    const int _changes;
+    int _changes;
 };
 
 class Statement : public api::DatabaseStatement {
@@ -30,6 +30,7 @@
  */
 
 #include <database/ProxyBackend.hpp>
+#include <database/Upsert.hpp>
 #include <gtest/gtest.h>
 #include <soci.h>
 #include "MemoryDatabaseProxy.h"
@@ -398,4 +399,65 @@ TEST_F(SociProxyTest, SelectRowsWhenEmpty) {
         count += 1;
     }
     EXPECT_EQ(count, 0);
-}
\ No newline at end of file
+}
+TEST_F(SociProxyTest, SelectIntoVectors) {
+    createTables(sql);
+    auto people = generateData(100);
+    insertPeople(sql, people);
+
+    std::vector<int> ids(30);
+    std::vector<std::string> names(30);
+    std::vector<long long> ages(30);
+    std::vector<double> grades(30);
+    soci::statement st = (sql.prepare << "SELECT id, name, age, grade FROM people ORDER BY id",
+            soci::into(ids), soci::into(names), soci::into(ages), soci::into(grades));
+    st.execute();
+    std::vector<People> from_db;
+    while (st.fetch()) {
+        EXPECT_LE(ids.size(), 30);
+        for (size_t i = 0; i < ids.size(); i++) {
+            from_db.emplace_back(ids[i], names[i], ages[i], grades[i], std::vector<uint8_t>());
+        }
+    }
+    ASSERT_EQ(from_db.size(), people.size());
+    for (size_t i = 0; i < people.size(); i++) {
+        EXPECT_EQ(from_db[i].id, people[i].id);
+        EXPECT_EQ(from_db[i].name, people[i].name);
+        EXPECT_EQ(from_db[i].age, people[i].age);
+        EXPECT_EQ(from_db[i].grade, people[i].grade);
+    }
+}
+
+TEST_F(SociProxyTest, SelectNullFieldsIntoVectors) {
+    createTables(sql);
+    auto people = generateData(3);
+    insertPeople(sql, people);
+    sql << "UPDATE people SET age = NULL WHERE id = 2";
+
+    std::vector<long long> ages(10);
+    std::vector<soci::indicator> indicators(10);
+    sql << "SELECT age FROM people ORDER BY id", soci::into(ages, indicators);
+    ASSERT_EQ(ages.size(), 3);
+    EXPECT_EQ(indicators[0], soci::i_ok);
+    EXPECT_EQ(ages[0], people[0].age);
+    EXPECT_EQ(indicators[1], soci::i_null);
+    EXPECT_EQ(indicators[2], soci::i_ok);
+    EXPECT_EQ(ages[2], people[2].age);
+
+    std::vector<long long> withoutIndicators(10);
+    EXPECT_THROW((sql << "SELECT age FROM people ORDER BY id", soci::into(withoutIndicators)), soci::soci_error);
+}
+
+TEST_F(SociProxyTest, InsertOrIgnoreReportsAffectedRows) {
+    createTables(sql);
+    auto insert = [&] (int id) {
+        const std::string name = "John Doe";
+        soci::statement st = (sql.prepare << insertOrIgnore(sql, "people", "(id, name) VALUES(:id, :name)", "id"),
+                soci::use(id), soci::use(name));
+        st.execute(true);
+        return st.get_affected_rows();
+    };
+    EXPECT_EQ(insert(1), 1);
+    EXPECT_EQ(insert(1), 0);
+    EXPECT_EQ(insert(2), 1);
+}
@@ -57,6 +57,7 @@ static const std::unordered_set<std::string> ALL_TABLE_NAMES = {
     "bitcoin_operations",
     "bitcoin_transaction_inputs",
     "bitcoin_accounts",
+    "bitcoin_account_outputs",
     "bitcoin_operations"
 };
 
@@ -131,3 +132,25 @@ TEST(DatabaseSessionPool, InitializeCurrencies) {
 
     resolver->clean();
 }
+
+TEST(DatabaseSessionPool, ReadonlySessionsSeeWriterCommits) {
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(DatabaseBackend::getSqlite3Backend());
+    auto pool = std::make_shared<DatabaseSessionPool>(backend, resolver, nullptr, "test_readers", "", 2);
+    {
+        soci::session sql(pool->getPool());
+        std::string journalMode;
+        sql << "PRAGMA journal_mode", soci::into(journalMode);
+        EXPECT_EQ(journalMode, "wal");
+        sql << "INSERT INTO pools VALUES('my_pool', '2019-10-18T00:00:00Z')";
+    }
+    {
+        soci::session sql(pool->getReadonlyPool());
+        int count = 0;
+        sql << "SELECT COUNT(*) FROM pools WHERE name = 'my_pool'", soci::into(count);
+        EXPECT_EQ(count, 1);
+        EXPECT_THROW(sql << "DELETE FROM pools", soci::soci_error);
+    }
+    pool.reset();
+    resolver->clean();
+}
@@ -0,0 +1,115 @@
+/*
+ *
+ * postgresql_tests
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <NativePathResolver.hpp>
+#include <database/DatabaseSessionPool.hpp>
+#include <database/BulkInsert.hpp>
+#include <database/migrations.hpp>
+#include <api/DatabaseBackend.hpp>
+#include <cstdlib>
+#include <thread>
+using namespace ledger::core;
+
+// Run against a local server, the connection string can be overridden with LEDGER_CORE_POSTGRESQL_TEST_DATABASE.
+// Tables are dropped at the end of each test.
+static std::string getTestConnectionString() {
+    auto env = std::getenv("LEDGER_CORE_POSTGRESQL_TEST_DATABASE");
+    return env != nullptr ? std::string(env) : "host=localhost dbname=ledger_core_test";
+}
+
+static std::shared_ptr<DatabaseSessionPool> newTestPool(int32_t connections) {
+    auto backend = std::static_pointer_cast<DatabaseBackend>(api::DatabaseBackend::getPostgreSQLBackend(connections));
+    auto resolver = std::make_shared<NativePathResolver>();
+    return std::make_shared<DatabaseSessionPool>(backend, resolver, nullptr, getTestConnectionString(), "");
+}
+
+TEST(PostgreSQLBackend, MigrateAndRollback) {
+    auto pool = newTestPool(2);
+    {
+        soci::session sql(pool->getPool());
+        EXPECT_EQ(getDatabaseMigrationVersion(sql), DatabaseSessionPool::CURRENT_DATABASE_SCHEME_VERSION);
+        int count = 0;
+        sql << "SELECT COUNT(*) FROM information_schema.tables WHERE table_name IN ('operations', 'bitcoin_outputs', "
+               "'ethereum_transactions', 'operation_addresses')", soci::into(count);
+        EXPECT_EQ(count, 4);
+    }
+    pool->performDatabaseRollback();
+    soci::session sql(pool->getPool());
+    EXPECT_EQ(getDatabaseMigrationVersion(sql), -1);
+}
+
+TEST(PostgreSQLBackend, ConcurrentSessions) {
+    auto pool = newTestPool(4);
+    {
+        soci::session sql(pool->getPool());
+        sql << "INSERT INTO pools VALUES('my_pool', '2019-10-18T00:00:00Z')";
+    }
+    std::vector<std::thread> threads;
+    std::vector<int> counts(4, 0);
+    for (auto index = 0; index < 4; index++) {
+        threads.emplace_back([&, index] () {
+            soci::session sql(pool->getPool());
+            sql << "SELECT COUNT(*) FROM pools", soci::into(counts[index]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counts, std::vector<int>(4, 1));
+    pool->performDatabaseRollback();
+}
+
+TEST(PostgreSQLBackend, BulkInsert) {
+    auto pool = newTestPool(1);
+    std::vector<int> rows(50000);
+    std::vector<std::string> names;
+    for (std::size_t index = 0; index < rows.size(); index++) {
+        rows[index] = index;
+        names.push_back("pool_" + std::to_string(index));
+    }
+    const std::string date = "2019-10-18T00:00:00Z";
+    {
+        soci::session sql(pool->getPool());
+        soci::transaction tr(sql);
+        auto bind = [&] (soci::statement& statement, const int& index) {
+            statement.exchange(soci::use(names[index]));
+            statement.exchange(soci::use(date));
+        };
+        bulkInsert(sql, "pools", 2, rows, bind);
+        bulkInsert(sql, "pools", 2, rows, bind, true);
+        tr.commit();
+        int count = 0;
+        sql << "SELECT COUNT(*) FROM pools", soci::into(count);
+        EXPECT_EQ(count, (int) rows.size());
+    }
+    pool->performDatabaseRollback();
+}
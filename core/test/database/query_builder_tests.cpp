@@ -34,6 +34,7 @@
 #include <src/database/DatabaseSessionPool.hpp>
 #include <NativePathResolver.hpp>
 #include <unordered_set>
+#include <algorithm>
 #include <src/wallet/pool/WalletPool.hpp>
 #include <CoutLogPrinter.hpp>
 #include <src/api/DynamicObject.hpp>
@@ -48,7 +49,13 @@
 #include <async/async_wait.h>
 #include <wallet/bitcoin/BitcoinLikeAccount.hpp>
 #include <database/query/QueryBuilder.h>
+#include <database/BulkInsert.hpp>
+#include <database/Upsert.hpp>
 #include <api/QueryFilter.hpp>
+#include <api/OperationOrderKey.hpp>
+#include <wallet/common/OperationQuery.h>
+#include <api/Amount.hpp>
+#include <api/BigInt.hpp>
 
 #include "BaseFixture.h"
 
@@ -89,4 +96,342 @@ TEST_F(QueryBuilderTest, SimpleOperationQuery) {
         EXPECT_EQ(count, 1);
     }
     resolver->clean();
-}
\ No newline at end of file
+}
+TEST_F(QueryBuilderTest, OperationQueryCursorPagination) {
+    auto pool = newDefaultPool();
+    {
+        auto wallet = wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+        auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+                *JSONUtils::parse<TransactionParser>(TX_1),
+                *JSONUtils::parse<TransactionParser>(TX_2),
+                *JSONUtils::parse<TransactionParser>(TX_3),
+                *JSONUtils::parse<TransactionParser>(TX_4)
+        };
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql.begin();
+        for (auto& tx : transactions) {
+            account->putTransaction(sql, tx);
+        }
+        sql.commit();
+
+        for (auto descending : {true, false}) {
+            auto all = wait(std::dynamic_pointer_cast<OperationQuery>(
+                    account->queryOperations()->addOrder(api::OperationOrderKey::DATE, descending))->execute());
+            ASSERT_GT(all.size(), 1);
+
+            std::vector<std::string> paged;
+            optional<std::string> cursor;
+            do {
+                auto query = account->queryOperations()->addOrder(api::OperationOrderKey::DATE, descending)->limit(1);
+                if (cursor) {
+                    query = query->after(cursor.value());
+                }
+                auto page = wait(std::dynamic_pointer_cast<OperationQuery>(query)->execute());
+                ASSERT_LE(page.size(), 1);
+                for (auto& op : page) {
+                    paged.push_back(op->getUid());
+                }
+                cursor = query->getNextCursor();
+            } while (cursor);
+
+            ASSERT_EQ(paged.size(), all.size());
+            for (size_t i = 0; i < all.size(); i++) {
+                EXPECT_EQ(paged[i], all[i]->getUid());
+            }
+        }
+
+        auto unordered = account->queryOperations()->addOrder(api::OperationOrderKey::AMOUNT, true)->limit(1);
+        wait(std::dynamic_pointer_cast<OperationQuery>(unordered)->execute());
+        EXPECT_FALSE(unordered->getNextCursor());
+        EXPECT_THROW(wait(std::dynamic_pointer_cast<OperationQuery>(unordered->after("00"))->execute()), Exception);
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, OperationQueryAddressFilters) {
+    auto pool = newDefaultPool();
+    {
+        auto wallet = wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+        auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+                *JSONUtils::parse<TransactionParser>(TX_1),
+                *JSONUtils::parse<TransactionParser>(TX_2),
+                *JSONUtils::parse<TransactionParser>(TX_3),
+                *JSONUtils::parse<TransactionParser>(TX_4)
+        };
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql.begin();
+        for (auto& tx : transactions) {
+            account->putTransaction(sql, tx);
+        }
+        sql.commit();
+
+        auto all = wait(std::dynamic_pointer_cast<OperationQuery>(account->queryOperations())->execute());
+        ASSERT_FALSE(all.empty());
+        ASSERT_FALSE(all.front()->getRecipients().empty());
+        auto recipient = all.front()->getRecipients().front();
+        auto expected = std::count_if(all.begin(), all.end(), [&] (const std::shared_ptr<api::Operation>& op) {
+            auto recipients = op->getRecipients();
+            return std::find(recipients.begin(), recipients.end(), recipient) != recipients.end();
+        });
+
+        auto query = account->queryOperations();
+        query->filter()->op_and(api::QueryFilter::containsRecipient(recipient));
+        auto operations = wait(std::dynamic_pointer_cast<OperationQuery>(query)->execute());
+        EXPECT_EQ(operations.size(), static_cast<size_t>(expected));
+        for (auto& op : operations) {
+            auto recipients = op->getRecipients();
+            EXPECT_NE(std::find(recipients.begin(), recipients.end(), recipient), recipients.end());
+        }
+
+        query = account->queryOperations();
+        query->filter()->op_and(api::QueryFilter::containsSender("not_an_address"));
+        EXPECT_TRUE(wait(std::dynamic_pointer_cast<OperationQuery>(query)->execute()).empty());
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, OperationQueryRecords) {
+    auto pool = newDefaultPool();
+    {
+        auto wallet = wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+        auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+                *JSONUtils::parse<TransactionParser>(TX_1),
+                *JSONUtils::parse<TransactionParser>(TX_2),
+                *JSONUtils::parse<TransactionParser>(TX_3),
+                *JSONUtils::parse<TransactionParser>(TX_4)
+        };
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql.begin();
+        for (auto& tx : transactions) {
+            account->putTransaction(sql, tx);
+        }
+        sql.commit();
+
+        auto operations = wait(std::dynamic_pointer_cast<OperationQuery>(
+                account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true))->execute());
+        auto records = wait(std::dynamic_pointer_cast<OperationQuery>(
+                account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true))->executeRecords());
+        ASSERT_FALSE(operations.empty());
+        ASSERT_EQ(records.size(), operations.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            auto& record = records[i];
+            auto& operation = operations[i];
+            EXPECT_EQ(record.uid, operation->getUid());
+            EXPECT_EQ(record.accountIndex, operation->getAccountIndex());
+            EXPECT_EQ(record.operationType, operation->getOperationType());
+            EXPECT_EQ(record.date, operation->getDate());
+            EXPECT_EQ(record.senders, operation->getSenders());
+            EXPECT_EQ(record.recipients, operation->getRecipients());
+            EXPECT_EQ(record.amount, operation->getAmount()->toBigInt()->toString(10));
+            ASSERT_TRUE(record.fees);
+            EXPECT_EQ(record.fees.value(), operation->getFees()->toBigInt()->toString(10));
+            EXPECT_EQ(record.currencyName, "bitcoin");
+            EXPECT_EQ(record.blockHeight, operation->getBlockHeight());
+            EXPECT_EQ(record.walletType, api::WalletType::BITCOIN);
+        }
+
+        ASSERT_GT(records.size(), 1);
+        auto page = account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true)->limit(1);
+        auto first = wait(std::dynamic_pointer_cast<OperationQuery>(page)->executeRecords());
+        ASSERT_EQ(first.size(), 1);
+        ASSERT_TRUE(page->getNextCursor());
+        auto next = account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true)->limit(1)
+                ->after(page->getNextCursor().value());
+        auto second = wait(std::dynamic_pointer_cast<OperationQuery>(next)->executeRecords());
+        ASSERT_EQ(second.size(), 1);
+        EXPECT_EQ(second.front().uid, records[1].uid);
+
+        // Operations stored without a trust indicator have no trust level
+        sql << "UPDATE operations SET trust = NULL, trust_level = NULL";
+        auto untrusted = wait(std::dynamic_pointer_cast<OperationQuery>(
+                account->queryOperations()->addOrder(api::OperationOrderKey::DATE, true))->executeRecords());
+        ASSERT_EQ(untrusted.size(), records.size());
+        for (auto& record : untrusted) {
+            EXPECT_EQ(record.trustLevel, record.blockHeight ? api::TrustLevel::TRUSTED : api::TrustLevel::PENDING);
+        }
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, PutTransactionsTwice) {
+    auto pool = newDefaultPool();
+    {
+        auto wallet = wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+        auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+                *JSONUtils::parse<TransactionParser>(TX_1),
+                *JSONUtils::parse<TransactionParser>(TX_2),
+                *JSONUtils::parse<TransactionParser>(TX_3),
+                *JSONUtils::parse<TransactionParser>(TX_4)
+        };
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        auto countRows = [&] () {
+            int operations = 0, addresses = 0, outputs = 0, inputs = 0;
+            sql << "SELECT COUNT(*) FROM operations", soci::into(operations);
+            sql << "SELECT COUNT(*) FROM operation_addresses", soci::into(addresses);
+            sql << "SELECT COUNT(*) FROM bitcoin_outputs", soci::into(outputs);
+            sql << "SELECT COUNT(*) FROM bitcoin_transaction_inputs", soci::into(inputs);
+            return std::vector<int> {operations, addresses, outputs, inputs};
+        };
+
+        sql.begin();
+        for (auto& tx : transactions) {
+            account->putTransaction(sql, tx);
+        }
+        sql.commit();
+        auto counts = countRows();
+        EXPECT_GT(counts[0], 0);
+        EXPECT_GT(counts[2], 0);
+
+        sql.begin();
+        for (auto& tx : transactions) {
+            account->putTransaction(sql, tx);
+        }
+        sql.commit();
+        EXPECT_EQ(countRows(), counts);
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, SharedTransactionStorage) {
+    auto pool = newDefaultPool();
+    {
+        auto configuration = api::DynamicObject::newInstance();
+        configuration->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE, true);
+        auto firstWallet = wait(pool->createWallet("first_wallet", "bitcoin", configuration));
+        auto secondWallet = wait(pool->createWallet("second_wallet", "bitcoin", configuration));
+        auto first = createBitcoinLikeAccount(firstWallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        auto second = createBitcoinLikeAccount(secondWallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        std::vector<BitcoinLikeBlockchainExplorerTransaction> transactions = {
+                *JSONUtils::parse<TransactionParser>(TX_1),
+                *JSONUtils::parse<TransactionParser>(TX_2),
+                *JSONUtils::parse<TransactionParser>(TX_3),
+                *JSONUtils::parse<TransactionParser>(TX_4)
+        };
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        auto countRows = [&] () {
+            int operations = 0, transactions = 0, outputs = 0, inputs = 0, accountOutputs = 0;
+            sql << "SELECT COUNT(*) FROM operations", soci::into(operations);
+            sql << "SELECT COUNT(*) FROM bitcoin_transactions", soci::into(transactions);
+            sql << "SELECT COUNT(*) FROM bitcoin_outputs", soci::into(outputs);
+            sql << "SELECT COUNT(*) FROM bitcoin_inputs", soci::into(inputs);
+            sql << "SELECT COUNT(*) FROM bitcoin_account_outputs", soci::into(accountOutputs);
+            return std::vector<int> {operations, transactions, outputs, inputs, accountOutputs};
+        };
+
+        sql.begin();
+        for (auto& tx : transactions) {
+            first->putTransaction(sql, tx);
+        }
+        sql.commit();
+        auto counts = countRows();
+        EXPECT_GT(counts[0], 0);
+        EXPECT_GT(counts[4], 0);
+
+        sql.begin();
+        for (auto& tx : transactions) {
+            second->putTransaction(sql, tx);
+        }
+        sql.commit();
+        // Transactions are stored once, only the per account rows are duplicated
+        auto shared = countRows();
+        EXPECT_EQ(shared[0], counts[0] * 2);
+        EXPECT_EQ(shared[1], counts[1]);
+        EXPECT_EQ(shared[2], counts[2]);
+        EXPECT_EQ(shared[3], counts[3]);
+        EXPECT_EQ(shared[4], counts[4] * 2);
+
+        EXPECT_EQ(wait(first->getUTXOCount()), wait(second->getUTXOCount()));
+        auto operations = wait(std::dynamic_pointer_cast<OperationQuery>(second->queryOperations()->complete())->execute());
+        EXPECT_EQ(operations.size(), counts[0]);
+        for (auto& operation : operations) {
+            EXPECT_TRUE(operation->asBitcoinLikeOperation()->getTransaction() != nullptr);
+        }
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, SharedTransactionStorageIsKeptOnConfigUpdate) {
+    auto pool = newDefaultPool();
+    {
+        auto configuration = api::DynamicObject::newInstance();
+        configuration->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE, true);
+        wait(pool->createWallet("shared_wallet", "bitcoin", configuration));
+        wait(pool->createWallet("own_wallet", "bitcoin", api::DynamicObject::newInstance()));
+
+        auto update = api::DynamicObject::newInstance();
+        update->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE, false);
+        EXPECT_EQ(wait(pool->updateWalletConfig("shared_wallet", update)), api::ErrorCode::FUTURE_WAS_SUCCESSFULL);
+        update->putBoolean(api::Configuration::SHARED_TRANSACTION_STORAGE, true);
+        EXPECT_EQ(wait(pool->updateWalletConfig("own_wallet", update)), api::ErrorCode::FUTURE_WAS_SUCCESSFULL);
+
+        EXPECT_TRUE(wait(pool->getWallet("shared_wallet"))->getConfigSnapshot().sharedTransactionStorage);
+        EXPECT_FALSE(wait(pool->getWallet("own_wallet"))->getConfigSnapshot().sharedTransactionStorage);
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, BulkInsertSplitsStatements) {
+    auto pool = newDefaultPool();
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql << "CREATE TEMPORARY TABLE bulk_test(uid VARCHAR(255) PRIMARY KEY NOT NULL, value INTEGER NOT NULL)";
+        std::vector<std::pair<std::string, int>> rows;
+        for (auto i = 0; i < 1200; i++) {
+            rows.emplace_back(fmt::format("uid_{}", i), i);
+        }
+        auto bind = [] (soci::statement& statement, const std::pair<std::string, int>& row) {
+            statement.exchange(soci::use(row.first));
+            statement.exchange(soci::use(row.second));
+        };
+        bulkInsert(sql, "bulk_test", 2, rows, bind);
+        bulkInsert(sql, "bulk_test", 2, rows, bind, true);
+
+        int count = 0;
+        long long sum = 0;
+        sql << "SELECT COUNT(*), SUM(value) FROM bulk_test", soci::into(count), soci::into(sum);
+        EXPECT_EQ(count, 1200);
+        EXPECT_EQ(sum, 1199 * 1200 / 2);
+    }
+    resolver->clean();
+}
+
+TEST_F(QueryBuilderTest, InsertOrIgnoreSkipsExistingRows) {
+    auto pool = newDefaultPool();
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        std::string version;
+        sql << "SELECT sqlite_version()", soci::into(version);
+        auto query = insertOrIgnore(sql, "upsert_test", "VALUES(:uid, :value)", "uid");
+        if (supportsUpsert(sql)) {
+            EXPECT_EQ(query, "INSERT INTO upsert_test VALUES(:uid, :value) ON CONFLICT(uid) DO NOTHING") << version;
+        } else {
+            EXPECT_EQ(query, "INSERT OR IGNORE INTO upsert_test VALUES(:uid, :value)") << version;
+        }
+
+        sql << "CREATE TEMPORARY TABLE upsert_test(uid VARCHAR(255) PRIMARY KEY NOT NULL, value INTEGER NOT NULL)";
+        std::string uid = "uid";
+        for (auto value : {1, 2}) {
+            soci::statement insertion = (sql.prepare << query, soci::use(uid), soci::use(value));
+            insertion.execute(true);
+            EXPECT_EQ(insertion.get_affected_rows(), value == 1 ? 1 : 0);
+        }
+        // the fallback statement must behave the same
+        std::string otherUid = "other_uid";
+        for (auto value : {1, 2}) {
+            soci::statement insertion = (sql.prepare << "INSERT OR IGNORE INTO upsert_test VALUES(:uid, :value)",
+                    soci::use(otherUid), soci::use(value));
+            insertion.execute(true);
+            EXPECT_EQ(insertion.get_affected_rows(), value == 1 ? 1 : 0);
+        }
+        int count = 0;
+        int sum = 0;
+        sql << "SELECT COUNT(*), SUM(value) FROM upsert_test", soci::into(count), soci::into(sum);
+        EXPECT_EQ(count, 2);
+        EXPECT_EQ(sum, 2);
+    }
+    resolver->clean();
+}
@@ -32,6 +32,7 @@
 #include <gtest/gtest.h>
 #include <database/query/QueryFilter.h>
 #include <api/TrustLevel.hpp>
+#include <database/soci-number.h>
 
 using namespace ledger::core;
 
@@ -50,5 +51,30 @@ TEST(QueryFilters, DoubleConditionWithCompoundFilter) {
             ->op_and(api::QueryFilter::blockHeightGt(12000))
             ->op_or_not(api::QueryFilter::trustEq(api::TrustLevel::TRUSTED)->op_and(api::QueryFilter::containsSender("toto")));
     EXPECT_EQ(std::dynamic_pointer_cast<QueryFilter>(filter)->getHead()->toString(),
-              "o.account_uid = :account_uid AND o.block_height > :block_height OR NOT (o.trust LIKE :trust AND o.senders LIKE :senders)");
-}
\ No newline at end of file
+              "o.account_uid = :account_uid AND o.block_height > :block_height OR NOT (o.trust_level = :trust_level AND "
+              "o.uid IN (SELECT operation_uid FROM operation_addresses WHERE address = :address AND role = 'SENDER'))");
+}
+
+TEST(QueryFilters, AddressFilters) {
+    auto filter = api::QueryFilter::containsSender("1sender")->op_or(api::QueryFilter::containsRecipient("1recipient"));
+    EXPECT_EQ(std::dynamic_pointer_cast<QueryFilter>(filter)->getHead()->toString(),
+              "o.uid IN (SELECT operation_uid FROM operation_addresses WHERE address = :address AND role = 'SENDER') OR "
+              "o.uid IN (SELECT operation_uid FROM operation_addresses WHERE address = :address AND role = 'RECIPIENT')");
+}
+TEST(QueryFilters, TrustFilters) {
+    auto filter = api::QueryFilter::trustEq(api::TrustLevel::PENDING)->op_or(api::QueryFilter::trustNeq(api::TrustLevel::DROPPED));
+    EXPECT_EQ(std::dynamic_pointer_cast<QueryFilter>(filter)->getHead()->toString(),
+              "o.trust_level = :trust_level OR o.trust_level <> :trust_level");
+}
+
+TEST(QueryFilters, SortableAmounts) {
+    auto small = soci_number::toSortableHex(BigInt::fromHex("ff"));
+    auto large = soci_number::toSortableHex(BigInt::fromHex("0100"));
+    auto huge = soci_number::toSortableHex(BigInt::fromDecimal("100000000000000000000000"));
+    EXPECT_EQ(small.size(), soci_number::SORTABLE_HEX_LENGTH);
+    EXPECT_EQ(small, std::string(62, '0') + "ff");
+    EXPECT_LT(small, large);
+    EXPECT_LT(large, huge);
+    EXPECT_EQ(soci_number::toSortableHex(BigInt::ZERO), std::string(64, '0'));
+    EXPECT_THROW(soci_number::toSortableHex(BigInt::fromDecimal("-1")), Exception);
+}
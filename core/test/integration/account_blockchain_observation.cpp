@@ -30,6 +30,7 @@
  */
 
 #include "BaseFixture.h"
+#include <set>
 
 class AccountBlockchainObservationTests : public BaseFixture {
 
@@ -154,4 +155,38 @@ TEST_F(AccountBlockchainObservationTests, EmitNewBlock) {
     account->getEventBus()->subscribe(dispatcher->getMainExecutionContext(), receiver);
     account->startBlockchainObservation();
     dispatcher->waitUntilStopped();
-}
\ No newline at end of file
+}
+TEST_F(AccountBlockchainObservationTests, EmitBurstOfTransactionsWithMalformedFrame) {
+    auto pool = newDefaultPool();
+    auto wallet = wait(pool->createWallet("my_wallet", "bitcoin", api::DynamicObject::newInstance()));
+    auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+    const std::string firstHash = "666613fd82459f94c74211974e74ffcb4a4b96b62980a6ecaee16af7702bbbe5";
+    const std::string secondHash = "777713fd82459f94c74211974e74ffcb4a4b96b62980a6ecaee16af7702bbbe5";
+    auto secondTx = NOTIF_WITH_TX;
+    secondTx.replace(secondTx.find(firstHash), firstHash.size(), secondHash);
+    std::set<std::string> operations;
+    auto receiver = make_receiver([&] (const std::shared_ptr<api::Event>& event) {
+        if (event->getCode() == api::EventCode::NEW_OPERATION) {
+            operations.insert(event->getPayload()->getString(api::Account::EV_NEW_OP_UID).value_or(""));
+            if (operations.size() == 2)
+                dispatcher->stop();
+        }
+    });
+    // The whole burst is buffered before the observer drains it: the malformed frame in the
+    // middle must not prevent the transactions around it from being stored.
+    ws->setOnConnectCallback([&] () {
+        ws->push(NOTIF_WITH_TX);
+        ws->push("{\"payload\":{\"type\":\"new-transaction\",\"transaction\":{\"hash\":");
+        ws->push(secondTx);
+    });
+    account->getEventBus()->subscribe(dispatcher->getMainExecutionContext(), receiver);
+    account->startBlockchainObservation();
+    dispatcher->waitUntilStopped();
+
+    auto ops = wait(std::dynamic_pointer_cast<OperationQuery>(account->queryOperations()->complete())->execute());
+    std::set<std::string> hashes;
+    for (auto& op : ops) {
+        hashes.insert(op->asBitcoinLikeOperation()->getTransaction()->getHash());
+    }
+    EXPECT_EQ(hashes, std::set<std::string>({firstHash, secondHash}));
+}
@@ -143,6 +143,36 @@ public:
         }));
         dispatcher->waitUntilStopped();
     };
+
+    // Like testKeychain, but f is given a function opening a keychain on some preferences, so
+    // that a keychain can be opened again on the state persisted by a previous one.
+    void testKeychainRestoration(const KeychainTestData &data,
+                                 std::function<void (const std::function<std::shared_ptr<Keychain> (const std::shared_ptr<ledger::core::Preferences>&)>&,
+                                                     const std::shared_ptr<ledger::core::PreferencesBackend>&)> f) {
+        auto backend = std::make_shared<ledger::core::PreferencesBackend>(
+                "/preferences/tests.db",
+                dispatcher->getMainExecutionContext(),
+                resolver
+        );
+        auto configuration = std::make_shared<DynamicObject>();
+        auto open = [=] (const std::shared_ptr<ledger::core::Preferences>& preferences) {
+            return std::make_shared<Keychain>(
+                    configuration,
+                    data.currency,
+                    0,
+                    ledger::core::BitcoinLikeExtendedPublicKey::fromBase58(data.currency,
+                                                                           data.xpub,
+                                                                           optional<std::string>(data.derivationPath),
+                                                                           configuration),
+                    preferences
+            );
+        };
+        dispatcher->getMainExecutionContext()->execute(ledger::qt::make_runnable([=]() {
+            f(open, backend);
+            dispatcher->stop();
+        }));
+        dispatcher->waitUntilStopped();
+    };
 };
 
 #endif //LEDGER_CORE_KEYCHAIN_TEST_HELPER_H
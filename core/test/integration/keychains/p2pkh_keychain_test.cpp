@@ -32,6 +32,8 @@
 #include <gtest/gtest.h>
 #include <src/wallet/bitcoin/keychains/P2PKHBitcoinLikeKeychain.hpp>
 #include "keychain_test_helper.h"
+#include <cereal/archives/binary.hpp>
+#include <sstream>
 
 class BitcoinKeychains : public KeychainFixture<P2PKHBitcoinLikeKeychain> {
 
@@ -241,3 +243,128 @@ TEST_F(BitcoinKeychains, CheckIfEmpty) {
         EXPECT_FALSE(keychain.isEmpty());
     });
 }
+
+namespace {
+    // Used addresses are persisted as a journal of deltas, compacted into the state snapshot
+    // every STATE_JOURNAL_MAX_SIZE entries.
+    const int32_t STATE_JOURNAL_MAX_SIZE = 64;
+
+    std::string receiveAddress(P2PKHBitcoinLikeKeychain& keychain, uint32_t index) {
+        return keychain.getAllObservableAddresses(index, index)[0]->toBase58();
+    }
+
+    std::string changeAddress(P2PKHBitcoinLikeKeychain& keychain, uint32_t index) {
+        return keychain.getAllObservableAddresses(index, index)[1]->toBase58();
+    }
+}
+
+TEST_F(BitcoinKeychains, ReplayStateJournalAfterRestart) {
+    testKeychainRestoration(BTC_DATA, [] (const std::function<std::shared_ptr<P2PKHBitcoinLikeKeychain> (const std::shared_ptr<Preferences>&)>& open,
+                                          const std::shared_ptr<PreferencesBackend>& backend) {
+        auto preferences = backend->getPreferences("keychain");
+        {
+            auto keychain = open(preferences);
+            EXPECT_TRUE(keychain->markAsUsed(receiveAddress(*keychain, 0)));
+            EXPECT_TRUE(keychain->markAsUsed(std::vector<std::string>({receiveAddress(*keychain, 5), changeAddress(*keychain, 0)})));
+        }
+        // Nothing was compacted: the restored keychain only knows about the journal entries
+        EXPECT_TRUE(preferences->getData("state", {}).empty());
+        EXPECT_EQ(preferences->getInt("state_journal_size", 0), 2);
+
+        auto keychain = open(preferences);
+        EXPECT_FALSE(keychain->isEmpty());
+        EXPECT_EQ(keychain->getFreshAddress(BitcoinLikeKeychain::KeyPurpose::RECEIVE)->toBase58(), receiveAddress(*keychain, 1));
+        EXPECT_EQ(keychain->getFreshAddress(BitcoinLikeKeychain::KeyPurpose::CHANGE)->toBase58(), changeAddress(*keychain, 1));
+        EXPECT_FALSE(keychain->markAsUsed(receiveAddress(*keychain, 5)));
+        EXPECT_TRUE(keychain->markAsUsed(receiveAddress(*keychain, 4)));
+    });
+}
+
+TEST_F(BitcoinKeychains, CompactStateJournal) {
+    testKeychainRestoration(BTC_DATA, [] (const std::function<std::shared_ptr<P2PKHBitcoinLikeKeychain> (const std::shared_ptr<Preferences>&)>& open,
+                                          const std::shared_ptr<PreferencesBackend>& backend) {
+        auto preferences = backend->getPreferences("keychain");
+        auto keychain = open(preferences);
+        for (auto index = 0; index < STATE_JOURNAL_MAX_SIZE - 1; index++) {
+            EXPECT_TRUE(keychain->markAsUsed(receiveAddress(*keychain, index)));
+        }
+        EXPECT_EQ(preferences->getInt("state_journal_size", 0), STATE_JOURNAL_MAX_SIZE - 1);
+        EXPECT_TRUE(preferences->getData("state", {}).empty());
+
+        // The next entry folds the journal back into the state snapshot
+        EXPECT_TRUE(keychain->markAsUsed(receiveAddress(*keychain, STATE_JOURNAL_MAX_SIZE - 1)));
+        EXPECT_EQ(preferences->getInt("state_journal_size", -1), 0);
+        EXPECT_FALSE(preferences->getData("state", {}).empty());
+        for (auto index = 0; index < STATE_JOURNAL_MAX_SIZE; index++) {
+            EXPECT_TRUE(preferences->getData(fmt::format("state_journal:{}", index), {}).empty());
+        }
+
+        auto restored = open(preferences);
+        EXPECT_EQ(restored->getFreshAddress(BitcoinLikeKeychain::KeyPurpose::RECEIVE)->toBase58(),
+                  receiveAddress(*restored, STATE_JOURNAL_MAX_SIZE));
+    });
+}
+
+TEST_F(BitcoinKeychains, RestoreSnapshotAndJournalAsFullState) {
+    testKeychainRestoration(BTC_DATA, [] (const std::function<std::shared_ptr<P2PKHBitcoinLikeKeychain> (const std::shared_ptr<Preferences>&)>& open,
+                                          const std::shared_ptr<PreferencesBackend>& backend) {
+        // Enough single address bulks to compact the journal once and leave a few entries after it
+        std::vector<uint32_t> receiveIndexes = {1, 0, 3, 2, 4};
+        std::vector<uint32_t> changeIndexes;
+        for (uint32_t index = 6; index < 90; index += 2) {
+            receiveIndexes.push_back(index);
+        }
+        for (uint32_t index = 0; index < 80; index += 3) {
+            changeIndexes.push_back(index);
+        }
+        auto journaled = backend->getPreferences("journaled_keychain");
+        {
+            auto keychain = open(journaled);
+            for (auto index : receiveIndexes) {
+                EXPECT_TRUE(keychain->markAsUsed(receiveAddress(*keychain, index)));
+            }
+            for (auto index : changeIndexes) {
+                EXPECT_TRUE(keychain->markAsUsed(changeAddress(*keychain, index)));
+            }
+        }
+        EXPECT_FALSE(journaled->getData("state", {}).empty());
+        EXPECT_GT(journaled->getInt("state_journal_size", 0), 0);
+
+        // The state the keychain used to rewrite in full after every used address
+        auto fullState = [] (const std::vector<uint32_t>& indexes, uint32_t& maxConsecutive, std::set<uint32_t>& nonConsecutive) {
+            std::set<uint32_t> used(indexes.begin(), indexes.end());
+            maxConsecutive = 0;
+            while (used.find(maxConsecutive) != used.end()) {
+                used.erase(maxConsecutive);
+                maxConsecutive += 1;
+            }
+            nonConsecutive = used;
+        };
+        KeychainPersistentState state;
+        fullState(receiveIndexes, state.maxConsecutiveReceiveIndex, state.nonConsecutiveReceiveIndexes);
+        fullState(changeIndexes, state.maxConsecutiveChangeIndex, state.nonConsecutiveChangeIndexes);
+        state.empty = false;
+        std::stringstream os;
+        {
+            ::cereal::BinaryOutputArchive archive(os);
+            archive(state);
+        }
+        auto serialized = os.str();
+        auto rewritten = backend->getPreferences("rewritten_keychain");
+        rewritten->editor()->putData("state", std::vector<uint8_t>(serialized.begin(), serialized.end()))->commit();
+
+        auto fromJournal = open(journaled);
+        auto fromFullState = open(rewritten);
+        EXPECT_EQ(fromJournal->isEmpty(), fromFullState->isEmpty());
+        for (auto purpose : {BitcoinLikeKeychain::KeyPurpose::RECEIVE, BitcoinLikeKeychain::KeyPurpose::CHANGE}) {
+            EXPECT_EQ(fromJournal->getFreshAddress(purpose)->toBase58(), fromFullState->getFreshAddress(purpose)->toBase58());
+        }
+        // Both keychains consider the same addresses as used
+        for (uint32_t index = 0; index < 100; index++) {
+            EXPECT_EQ(fromJournal->markAsUsed(receiveAddress(*fromJournal, index)),
+                      fromFullState->markAsUsed(receiveAddress(*fromFullState, index)));
+            EXPECT_EQ(fromJournal->markAsUsed(changeAddress(*fromJournal, index)),
+                      fromFullState->markAsUsed(changeAddress(*fromFullState, index)));
+        }
+    });
+}
@@ -170,4 +170,13 @@ TEST_F(WalletPoolTest, CreateAndGetWallet) {
         auto wallets = wait(pool->getWallets(0, 1));
         EXPECT_TRUE(wallets.front()->getName() == "my_wallet");
     }
-}
\ No newline at end of file
+}
+TEST_F(WalletPoolTest, AccountExecutionContextsArePerPool) {
+    auto firstPool = newDefaultPool("first_pool");
+    auto secondPool = newDefaultPool("second_pool");
+    auto uid = "4f2b7c0b9ef0d3cd8a0b1f6e45ec3dbd6c6d8a6f1b0f25e1c9e6e3fb0db0a1e2";
+    // An account always runs on the same context of its pool, but accounts of different pools
+    // never share a serial context
+    EXPECT_EQ(firstPool->getAccountExecutionContext(uid), firstPool->getAccountExecutionContext(uid));
+    EXPECT_NE(firstPool->getAccountExecutionContext(uid), secondPool->getAccountExecutionContext(uid));
+}
@@ -0,0 +1,90 @@
+/*
+ *
+ * FakeHttpClient.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "FakeHttpClient.h"
+#include <api/HttpRequest.hpp>
+#include <api/HttpUrlConnection.hpp>
+#include <api/HttpReadBodyResult.hpp>
+#include <api/Error.hpp>
+
+namespace {
+    class FakeHttpUrlConnection : public ledger::core::api::HttpUrlConnection {
+    public:
+        FakeHttpUrlConnection(int32_t statusCode, const std::string &body) :
+                _statusCode(statusCode), _body(body.begin(), body.end()) {
+        }
+
+        int32_t getStatusCode() override {
+            return _statusCode;
+        }
+
+        std::string getStatusText() override {
+            return _statusCode == 200 ? "OK" : "Error";
+        }
+
+        std::unordered_map<std::string, std::string> getHeaders() override {
+            return {};
+        }
+
+        ledger::core::api::HttpReadBodyResult readBody() override {
+            auto body = _body;
+            _body = std::vector<uint8_t>();
+            return ledger::core::api::HttpReadBodyResult(
+                    std::experimental::optional<ledger::core::api::Error>(),
+                    std::experimental::optional<std::vector<uint8_t>>(body)
+            );
+        }
+
+    private:
+        int32_t _statusCode;
+        std::vector<uint8_t> _body;
+    };
+}
+
+FakeHttpClient::FakeHttpClient(Handler handler) : _handler(handler) {
+}
+
+void FakeHttpClient::execute(const std::shared_ptr<ledger::core::api::HttpRequest> &request) {
+    auto rawBody = request->getBody();
+    std::string body(rawBody.begin(), rawBody.end());
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _requests.push_back(body);
+    }
+    auto response = _handler(request->getUrl(), body);
+    request->complete(std::make_shared<FakeHttpUrlConnection>(response.statusCode, response.body),
+                      std::experimental::optional<ledger::core::api::Error>());
+}
+
+std::vector<std::string> FakeHttpClient::getRequests() {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _requests;
+}
@@ -0,0 +1,62 @@
+/*
+ *
+ * FakeHttpClient.h
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_FAKEHTTPCLIENT_H
+#define LEDGER_CORE_FAKEHTTPCLIENT_H
+
+#include <api/HttpClient.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Answer HTTP requests synchronously with a handler instead of going through the network,
+// and keep the body of every request sent.
+class FakeHttpClient : public ledger::core::api::HttpClient {
+public:
+    struct Response {
+        int32_t statusCode;
+        std::string body;
+    };
+    using Handler = std::function<Response (const std::string& url, const std::string& body)>;
+
+    FakeHttpClient(Handler handler);
+    void execute(const std::shared_ptr<ledger::core::api::HttpRequest> &request) override;
+    std::vector<std::string> getRequests();
+
+private:
+    Handler _handler;
+    std::mutex _lock;
+    std::vector<std::string> _requests;
+};
+
+#endif //LEDGER_CORE_FAKEHTTPCLIENT_H
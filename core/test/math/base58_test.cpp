@@ -68,4 +68,36 @@ TEST(Base58, Decode) {
         EXPECT_TRUE(result.isSuccess());
         EXPECT_EQ(result.getValue(), data);
     }
-}
\ No newline at end of file
+}
+TEST(Base58, EncodeDecodeWithParameters) {
+    Base58::Parameters params;
+    for (auto& item : fixtures) {
+        auto data = hex::toByteArray(item[0] + item[1]);
+        EXPECT_EQ(Base58::encodeWithChecksum(data, params), item[2]);
+        auto result = Base58::checkAndDecode(item[2], params);
+        EXPECT_TRUE(result.isSuccess());
+        EXPECT_EQ(result.getValue(), data);
+    }
+}
+
+TEST(Base58, ParametersMatchConfiguration) {
+    const std::string networkIdentifier = "xrp";
+    const std::string dictionary = "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
+    auto config = std::make_shared<DynamicObject>();
+    config->putString("networkIdentifier", networkIdentifier);
+    config->putString("base58Dictionary", dictionary);
+    config->putBoolean("useNetworkDictionary", true);
+    Base58::Parameters params(networkIdentifier, dictionary, true);
+    auto data = hex::toByteArray("00" "88a5a57c829f40f25ea83385bbde6c3d8b4ca082");
+    auto encoded = Base58::encodeWithChecksum(data, params);
+    EXPECT_EQ(encoded, Base58::encodeWithChecksum(data, config));
+    EXPECT_EQ(Base58::checkAndDecode(encoded, params).getValue(), Base58::checkAndDecode(encoded, config).getValue());
+}
+
+TEST(Base58, ParametersReferenceDefaultDictionary) {
+    Base58::Parameters params;
+    EXPECT_EQ(&params.dictionary, &Base58::DIGITS);
+    const std::string networkIdentifier = "btc";
+    Base58::Parameters emptyDictionary(networkIdentifier, "");
+    EXPECT_EQ(&emptyDictionary.dictionary, &Base58::DIGITS);
+}
@@ -37,6 +37,7 @@
 #include <ledger/core/utils/Option.hpp>
 #include <NativePathResolver.hpp>
 #include <fstream>
+#include <fmt/format.h>
 #include <OpenSSLRandomNumberGenerator.hpp>
 
 class PreferencesTest : public ::testing::Test {
@@ -366,3 +367,181 @@ TEST_F(PreferencesTest, RecryptClearValues) {
     // now, reading the old value should be okay, too
     EXPECT_EQ(preferences->getString("string", "none"), "dawg");
 }
+
+TEST_F(PreferencesTest, IterateThroughEncryptedMembers) {
+    auto preferences = backend->getPreferences("iterate_encrypted");
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+
+    backend->setEncryption(rng, "v3ry_secr3t_p4sSw0rD");
+    preferences->editor()
+        ->putString("address:0", "Hello World!")
+        ->putString("address:1", "Hello World!")
+        ->commit();
+
+    auto count = 0;
+    preferences->iterate([&count] (leveldb::Slice&& key, leveldb::Slice&& value) {
+        EXPECT_EQ(value.ToString(), "Hello World!");
+        count += 1;
+        return true;
+    }, ledger::core::Option<std::string>("address:"));
+    EXPECT_EQ(count, 2);
+}
+
+// This test checks that password changes re-encrypt the entries by chunks and report progress.
+TEST_F(PreferencesTest, ResetEncryptionByChunks) {
+    auto preferences = backend->getPreferences("reset_encryption_by_chunks");
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+
+    backend->setEncryption(rng, password);
+    auto editor = preferences->editor();
+    for (auto i = 0; i < 1200; i++) {
+        editor->putInt(fmt::format("int:{}", i), i);
+    }
+    editor->commit();
+
+    std::vector<size_t> progress;
+    auto reset = backend->resetEncryption(rng, password, "new password!", [&progress] (size_t processed) {
+        progress.push_back(processed);
+    });
+
+    ASSERT_TRUE(reset);
+    ASSERT_GT(progress.size(), 2);
+    EXPECT_EQ(progress.back(), 1200);
+    for (auto i = 0; i < 1200; i++) {
+        ASSERT_EQ(preferences->getInt(fmt::format("int:{}", i), -1), i);
+    }
+}
+
+// Backends opened on the same path share their LevelDB instance: values written through one of
+// them must not be hidden by plaintext cached by the other.
+TEST_F(PreferencesTest, SharedInstanceDoesNotServeStaleDecryptedValues) {
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+    auto other = std::make_shared<ledger::core::PreferencesBackend>(
+        "/preferences/tests.db",
+        dispatcher->getSerialExecutionContext("other_worker"),
+        resolver
+    );
+    backend->setEncryption(rng, password);
+    other->setEncryption(rng, password);
+    auto preferences = backend->getPreferences("shared_instance");
+    auto otherPreferences = other->getPreferences("shared_instance");
+
+    preferences->editor()->putString("key", "first")->commit();
+    EXPECT_EQ(preferences->getString("key", ""), "first");
+    EXPECT_EQ(otherPreferences->getString("key", ""), "first");
+
+    otherPreferences->editor()->putString("key", "second")->commit();
+    EXPECT_EQ(preferences->getString("key", ""), "second");
+
+    otherPreferences->editor()->remove("key")->commit();
+    EXPECT_EQ(preferences->getString("key", "removed"), "removed");
+}
+
+// A password change interrupted before the database is re-keyed is rolled back when the store is
+// reopened with the old password.
+TEST_F(PreferencesTest, RollBackInterruptedEncryptionResetOnReopen) {
+    auto preferences = backend->getPreferences("interrupted_reset");
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+
+    backend->setEncryption(rng, password);
+    auto editor = preferences->editor();
+    for (auto i = 0; i < 1200; i++) {
+        editor->putInt(fmt::format("int:{}", i), i);
+    }
+    editor->commit();
+    auto salt = backend->getEncryptionSalt();
+
+    // interrupt the reset after the first chunk
+    EXPECT_THROW(backend->resetEncryption(rng, password, "new password!", [] (size_t processed) {
+        throw std::runtime_error("interrupted");
+    }), std::runtime_error);
+
+    auto reopened = std::make_shared<ledger::core::PreferencesBackend>(
+        "/preferences/tests.db",
+        dispatcher->getSerialExecutionContext("reopened_worker"),
+        resolver
+    );
+    reopened->setEncryption(rng, password);
+    auto reopenedPreferences = reopened->getPreferences("interrupted_reset");
+    for (auto i = 0; i < 1200; i++) {
+        ASSERT_EQ(reopenedPreferences->getInt(fmt::format("int:{}", i), -1), i);
+    }
+    EXPECT_EQ(reopened->getEncryptionSalt(), salt);
+}
+
+// A password change interrupted once the database is re-keyed is finished when the store is
+// reopened with the new password.
+TEST_F(PreferencesTest, FinishInterruptedEncryptionResetOnReopen) {
+    auto preferences = backend->getPreferences("interrupted_reset");
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+    auto newPassword = std::string("new password!");
+
+    backend->setEncryption(rng, password);
+    auto editor = preferences->editor();
+    for (auto i = 0; i < 1200; i++) {
+        editor->putInt(fmt::format("int:{}", i), i);
+    }
+    editor->commit();
+    auto salt = backend->getEncryptionSalt();
+
+    // every entry is staged, but the reset is never committed
+    ASSERT_TRUE(backend->prepareEncryptionReset(rng, password, newPassword));
+
+    auto reopened = std::make_shared<ledger::core::PreferencesBackend>(
+        "/preferences/tests.db",
+        dispatcher->getSerialExecutionContext("reopened_worker"),
+        resolver
+    );
+    reopened->setEncryption(rng, newPassword);
+    auto reopenedPreferences = reopened->getPreferences("interrupted_reset");
+    for (auto i = 0; i < 1200; i++) {
+        ASSERT_EQ(reopenedPreferences->getInt(fmt::format("int:{}", i), -1), i);
+    }
+    EXPECT_NE(reopened->getEncryptionSalt(), salt);
+
+    // the old password no longer decrypts the entries
+    reopened->unsetEncryption();
+    reopened->setEncryption(rng, password);
+    EXPECT_ANY_THROW(reopenedPreferences->getInt("int:0", -1));
+}
+
+// Entries written while a password change is prepared are kept once it is committed.
+TEST_F(PreferencesTest, KeepEntriesWrittenDuringEncryptionReset) {
+    auto preferences = backend->getPreferences("written_during_reset");
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+    auto newPassword = std::string("new password!");
+
+    backend->setEncryption(rng, password);
+    auto editor = preferences->editor();
+    for (auto i = 0; i < 1200; i++) {
+        editor->putInt(fmt::format("int:{}", i), i);
+    }
+    editor->commit();
+
+    ASSERT_TRUE(backend->prepareEncryptionReset(rng, password, newPassword));
+    preferences->editor()
+        ->putInt("int:0", -42)
+        ->putString("string", "written during the reset")
+        ->remove("int:1")
+        ->commit();
+    backend->commitEncryptionReset();
+
+    auto reopened = std::make_shared<ledger::core::PreferencesBackend>(
+        "/preferences/tests.db",
+        dispatcher->getSerialExecutionContext("reopened_worker"),
+        resolver
+    );
+    reopened->setEncryption(rng, newPassword);
+    auto reopenedPreferences = reopened->getPreferences("written_during_reset");
+    EXPECT_EQ(reopenedPreferences->getInt("int:0", -1), -42);
+    EXPECT_EQ(reopenedPreferences->getString("string", ""), "written during the reset");
+    EXPECT_EQ(reopenedPreferences->getInt("int:1", -1), -1);
+    for (auto i = 2; i < 1200; i++) {
+        ASSERT_EQ(reopenedPreferences->getInt(fmt::format("int:{}", i), -1), i);
+    }
+}
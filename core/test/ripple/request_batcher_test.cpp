@@ -0,0 +1,261 @@
+/*
+ *
+ * request_batcher_test.cpp
+ * ledger-core
+ *
+ * Created by Ledger on 18/10/2019.
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <deque>
+#include <FakeHttpClient.h>
+#include <api/ExecutionContext.hpp>
+#include <api/DynamicObject.hpp>
+#include <api/Runnable.hpp>
+#include <net/HttpClient.hpp>
+#include <wallet/ripple/explorers/NodeRippleLikeRequestBatcher.h>
+#include <wallet/ripple/explorers/NodeRippleLikeBlockchainExplorer.h>
+#include <wallet/ripple/rippleNetworks.h>
+
+using namespace ledger::core;
+
+namespace {
+    // Run the scheduled tasks only when asked to, so that the tests control what is queued
+    // before the batcher flushes.
+    class QueueExecutionContext : public api::ExecutionContext {
+    public:
+        void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+            _queue.push_back(runnable);
+        }
+
+        void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+            execute(runnable);
+        }
+
+        void runAll() {
+            while (!_queue.empty()) {
+                auto runnable = _queue.front();
+                _queue.pop_front();
+                runnable->run();
+            }
+        }
+
+    private:
+        std::deque<std::shared_ptr<api::Runnable>> _queue;
+    };
+
+    std::string request(int id) {
+        return fmt::format("{{\"method\":\"server_info\",\"params\":[{{\"id\":{}}}]}}", id);
+    }
+
+    std::string response(int id) {
+        return fmt::format("{{\"result\":{{\"id\":{}}}}}", id);
+    }
+
+    // Answer each request of a batch with its own "id" parameter
+    FakeHttpClient::Response answerIds(const std::string &url, const std::string &body) {
+        rapidjson::Document document;
+        document.Parse(body.c_str());
+        if (document["method"] != "batch") {
+            return {200, response(document["params"][0]["id"].GetInt())};
+        }
+        std::string result = "[";
+        for (rapidjson::SizeType index = 0; index < document["params"].Size(); index++) {
+            result += (index > 0 ? "," : "") + response(document["params"][index]["params"][0]["id"].GetInt());
+        }
+        return {200, result + "]"};
+    }
+
+    int responseId(const Future<std::shared_ptr<rapidjson::Document>> &future) {
+        auto result = future.getValue();
+        EXPECT_TRUE(result.hasValue());
+        EXPECT_TRUE(result.getValue().isSuccess());
+        return (*result.getValue().getValue())["result"]["id"].GetInt();
+    }
+
+    std::shared_ptr<HttpClient> newHttpClient(const std::shared_ptr<FakeHttpClient> &client,
+                                              const std::shared_ptr<QueueExecutionContext> &context) {
+        return std::make_shared<HttpClient>("http://localhost", client, context);
+    }
+}
+
+TEST(NodeRippleLikeRequestBatcher, CoalescesPendingRequestsInOneBatch) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto client = std::make_shared<FakeHttpClient>(answerIds);
+    auto batcher = std::make_shared<NodeRippleLikeRequestBatcher>(newHttpClient(client, context), context);
+
+    std::vector<Future<std::shared_ptr<rapidjson::Document>>> futures;
+    for (auto id = 0; id < 3; id++) {
+        futures.push_back(batcher->request(request(id)));
+    }
+    context->runAll();
+
+    auto requests = client->getRequests();
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0], fmt::format("{{\"method\":\"batch\",\"params\":[{},{},{}]}}", request(0), request(1), request(2)));
+    // The batch response is split back to each caller, in order
+    for (auto id = 0; id < 3; id++) {
+        EXPECT_EQ(responseId(futures[id]), id);
+    }
+}
+
+TEST(NodeRippleLikeRequestBatcher, SplitsBatchesAboveMaxSize) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto client = std::make_shared<FakeHttpClient>(answerIds);
+    auto batcher = std::make_shared<NodeRippleLikeRequestBatcher>(newHttpClient(client, context), context);
+
+    const auto count = static_cast<int>(NodeRippleLikeRequestBatcher::MAX_BATCH_SIZE) + 10;
+    std::vector<Future<std::shared_ptr<rapidjson::Document>>> futures;
+    for (auto id = 0; id < count; id++) {
+        futures.push_back(batcher->request(request(id)));
+    }
+    context->runAll();
+
+    auto requests = client->getRequests();
+    ASSERT_EQ(requests.size(), 2);
+    rapidjson::Document first;
+    first.Parse(requests[0].c_str());
+    EXPECT_EQ(first["params"].Size(), NodeRippleLikeRequestBatcher::MAX_BATCH_SIZE);
+    for (auto id = 0; id < count; id++) {
+        EXPECT_EQ(responseId(futures[id]), id);
+    }
+}
+
+TEST(NodeRippleLikeRequestBatcher, DeduplicatesIdenticalRequests) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto client = std::make_shared<FakeHttpClient>(answerIds);
+    auto batcher = std::make_shared<NodeRippleLikeRequestBatcher>(newHttpClient(client, context), context);
+
+    auto first = batcher->request(request(42));
+    auto second = batcher->request(request(42));
+    context->runAll();
+
+    // A single request is sent as is, not as a batch of one
+    auto requests = client->getRequests();
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0], request(42));
+    EXPECT_EQ(responseId(first), 42);
+    EXPECT_EQ(responseId(second), 42);
+
+    // Once answered, the same request is sent again
+    auto third = batcher->request(request(42));
+    context->runAll();
+    EXPECT_EQ(client->getRequests().size(), 2);
+    EXPECT_EQ(responseId(third), 42);
+}
+
+TEST(NodeRippleLikeRequestBatcher, FailsEveryRequestOnMalformedBatchResponse) {
+    auto context = std::make_shared<QueueExecutionContext>();
+    auto client = std::make_shared<FakeHttpClient>([] (const std::string &url, const std::string &body) -> FakeHttpClient::Response {
+        return {200, "[" + response(0) + "]"};
+    });
+    auto batcher = std::make_shared<NodeRippleLikeRequestBatcher>(newHttpClient(client, context), context);
+
+    auto first = batcher->request(request(0));
+    auto second = batcher->request(request(1));
+    context->runAll();
+
+    for (const auto &future : {first, second}) {
+        auto result = future.getValue();
+        ASSERT_TRUE(result.hasValue());
+        ASSERT_TRUE(result.getValue().isFailure());
+        EXPECT_EQ(result.getValue().getFailure().getErrorCode(), api::ErrorCode::HTTP_ERROR);
+    }
+}
+
+class NodeRippleLikeExplorerPagination : public ::testing::Test {
+public:
+    void SetUp() override {
+        context = std::make_shared<QueueExecutionContext>();
+        client = std::make_shared<FakeHttpClient>([this] (const std::string &url, const std::string &body) {
+            auto response = responses.front();
+            responses.pop_front();
+            return response;
+        });
+        explorer = std::make_shared<NodeRippleLikeBlockchainExplorer>(context, newHttpClient(client, context),
+                                                                      networks::getRippleLikeNetworkParameters("ripple"),
+                                                                      api::DynamicObject::newInstance());
+        auto session = explorer->startSession();
+        context->runAll();
+        token = session.getValue().getValue().getValue();
+    }
+
+    void TearDown() override {
+        explorer->killSession(token);
+    }
+
+    Try<std::shared_ptr<RippleLikeBlockchainExplorer::TransactionsBulk>> getTransactions(const Option<std::string> &fromBlockHash) {
+        auto future = explorer->getTransactions({"rageXHB6Q4VbvvWdTzKANwjeCT4HXFCKX7"}, fromBlockHash, Option<void *>(token));
+        context->runAll();
+        return future.getValue().getValue();
+    }
+
+    static std::string page(const std::string &marker) {
+        return fmt::format("{{\"result\":{{\"account\":\"rageXHB6Q4VbvvWdTzKANwjeCT4HXFCKX7\",{}\"transactions\":[]}}}}", marker);
+    }
+
+    std::shared_ptr<QueueExecutionContext> context;
+    std::shared_ptr<FakeHttpClient> client;
+    std::shared_ptr<NodeRippleLikeBlockchainExplorer> explorer;
+    std::deque<FakeHttpClient::Response> responses;
+    void *token;
+};
+
+TEST_F(NodeRippleLikeExplorerPagination, FollowsMarker) {
+    responses.push_back({200, page("\"marker\":{\"ledger\":52000000,\"seq\":12},")});
+    responses.push_back({200, page("")});
+
+    auto first = getTransactions(Option<std::string>());
+    ASSERT_TRUE(first.isSuccess());
+    EXPECT_TRUE(first.getValue()->hasNext);
+
+    auto last = getTransactions(Option<std::string>());
+    ASSERT_TRUE(last.isSuccess());
+    EXPECT_FALSE(last.getValue()->hasNext);
+
+    auto requests = client->getRequests();
+    ASSERT_EQ(requests.size(), 2);
+    EXPECT_EQ(requests[0].find("marker"), std::string::npos);
+    EXPECT_NE(requests[1].find("\"marker\":{\"ledger\":52000000,\"seq\":12}"), std::string::npos);
+}
+
+TEST_F(NodeRippleLikeExplorerPagination, DropsMarkerOnReorganization) {
+    responses.push_back({200, page("\"marker\":{\"ledger\":52000000,\"seq\":12},")});
+    responses.push_back({404, "{\"error\":\"lgrNotFound\"}"});
+    responses.push_back({200, page("")});
+
+    ASSERT_TRUE(getTransactions(Option<std::string>()).isSuccess());
+    auto failed = getTransactions(Option<std::string>("B1C5D5A5E1B3F2C8"));
+    ASSERT_TRUE(failed.isFailure());
+    EXPECT_EQ(failed.getFailure().getErrorCode(), api::ErrorCode::BLOCK_NOT_FOUND);
+
+    // The synchronizer restarts from an older block: the marker of the failed page is not reused
+    ASSERT_TRUE(getTransactions(Option<std::string>("A0B4C4D4E0A2F1B7")).isSuccess());
+    auto requests = client->getRequests();
+    ASSERT_EQ(requests.size(), 3);
+    EXPECT_NE(requests[1].find("marker"), std::string::npos);
+    EXPECT_EQ(requests[2].find("marker"), std::string::npos);
+}
@@ -94,6 +94,7 @@ const EVENT_CODE = {
     SYNCHRONIZATION_FAILED: 4,
     SYNCHRONIZATION_SUCCEED: 5,
     SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT: 6,
+    PASSWORD_CHANGE_PROGRESS: 7,
 }
 
 const NJSHttpClientImpl = {